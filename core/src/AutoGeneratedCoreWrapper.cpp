@@ -51,6 +51,7 @@
 #include "Graphics/Renderer/RenderedSprite.h"
 #include "Graphics/Renderer/RenderedText.h"
 #include "Graphics/Renderer/Renderer.h"
+#include "Graphics/Renderer/TextBatch.h"
 #include "Graphics/ShaderCompiler/ShaderCompiler.h"
 #include "Graphics/Texture2D.h"
 #include "IO/BaseFileReader.h"
@@ -106,6 +107,27 @@ CBGEXPORT void CBGSTDCALL cbg_Int8Array_Assign(void* cbg_self, void* ptr, int32_
     cbg_self_->Assign(cbg_arg0, cbg_arg1);
 }
 
+CBGEXPORT void CBGSTDCALL cbg_Int8Array_Borrow(void* cbg_self, void* ptr, int32_t size) {
+    auto cbg_self_ = (Altseed2::Int8Array*)(cbg_self);
+
+    void* cbg_arg0 = ptr;
+    int32_t cbg_arg1 = size;
+    cbg_self_->Borrow(cbg_arg0, cbg_arg1);
+}
+
+CBGEXPORT void CBGSTDCALL cbg_Int8Array_Unborrow(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::Int8Array*)(cbg_self);
+
+    cbg_self_->Unborrow();
+}
+
+CBGEXPORT bool CBGSTDCALL cbg_Int8Array_GetIsBorrowed(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::Int8Array*)(cbg_self);
+
+    bool cbg_ret = cbg_self_->GetIsBorrowed();
+    return cbg_ret;
+}
+
 CBGEXPORT void CBGSTDCALL cbg_Int8Array_CopyTo(void* cbg_self, void* ptr) {
     auto cbg_self_ = (Altseed2::Int8Array*)(cbg_self);
 
@@ -182,6 +204,27 @@ CBGEXPORT void CBGSTDCALL cbg_Int32Array_Assign(void* cbg_self, void* ptr, int32
     cbg_self_->Assign(cbg_arg0, cbg_arg1);
 }
 
+CBGEXPORT void CBGSTDCALL cbg_Int32Array_Borrow(void* cbg_self, void* ptr, int32_t size) {
+    auto cbg_self_ = (Altseed2::Int32Array*)(cbg_self);
+
+    void* cbg_arg0 = ptr;
+    int32_t cbg_arg1 = size;
+    cbg_self_->Borrow(cbg_arg0, cbg_arg1);
+}
+
+CBGEXPORT void CBGSTDCALL cbg_Int32Array_Unborrow(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::Int32Array*)(cbg_self);
+
+    cbg_self_->Unborrow();
+}
+
+CBGEXPORT bool CBGSTDCALL cbg_Int32Array_GetIsBorrowed(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::Int32Array*)(cbg_self);
+
+    bool cbg_ret = cbg_self_->GetIsBorrowed();
+    return cbg_ret;
+}
+
 CBGEXPORT void CBGSTDCALL cbg_Int32Array_CopyTo(void* cbg_self, void* ptr) {
     auto cbg_self_ = (Altseed2::Int32Array*)(cbg_self);
 
@@ -258,6 +301,27 @@ CBGEXPORT void CBGSTDCALL cbg_VertexArray_Assign(void* cbg_self, void* ptr, int3
     cbg_self_->Assign(cbg_arg0, cbg_arg1);
 }
 
+CBGEXPORT void CBGSTDCALL cbg_VertexArray_Borrow(void* cbg_self, void* ptr, int32_t size) {
+    auto cbg_self_ = (Altseed2::VertexArray*)(cbg_self);
+
+    void* cbg_arg0 = ptr;
+    int32_t cbg_arg1 = size;
+    cbg_self_->Borrow(cbg_arg0, cbg_arg1);
+}
+
+CBGEXPORT void CBGSTDCALL cbg_VertexArray_Unborrow(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::VertexArray*)(cbg_self);
+
+    cbg_self_->Unborrow();
+}
+
+CBGEXPORT bool CBGSTDCALL cbg_VertexArray_GetIsBorrowed(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::VertexArray*)(cbg_self);
+
+    bool cbg_ret = cbg_self_->GetIsBorrowed();
+    return cbg_ret;
+}
+
 CBGEXPORT void CBGSTDCALL cbg_VertexArray_CopyTo(void* cbg_self, void* ptr) {
     auto cbg_self_ = (Altseed2::VertexArray*)(cbg_self);
 
@@ -334,6 +398,27 @@ CBGEXPORT void CBGSTDCALL cbg_FloatArray_Assign(void* cbg_self, void* ptr, int32
     cbg_self_->Assign(cbg_arg0, cbg_arg1);
 }
 
+CBGEXPORT void CBGSTDCALL cbg_FloatArray_Borrow(void* cbg_self, void* ptr, int32_t size) {
+    auto cbg_self_ = (Altseed2::FloatArray*)(cbg_self);
+
+    void* cbg_arg0 = ptr;
+    int32_t cbg_arg1 = size;
+    cbg_self_->Borrow(cbg_arg0, cbg_arg1);
+}
+
+CBGEXPORT void CBGSTDCALL cbg_FloatArray_Unborrow(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::FloatArray*)(cbg_self);
+
+    cbg_self_->Unborrow();
+}
+
+CBGEXPORT bool CBGSTDCALL cbg_FloatArray_GetIsBorrowed(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::FloatArray*)(cbg_self);
+
+    bool cbg_ret = cbg_self_->GetIsBorrowed();
+    return cbg_ret;
+}
+
 CBGEXPORT void CBGSTDCALL cbg_FloatArray_CopyTo(void* cbg_self, void* ptr) {
     auto cbg_self_ = (Altseed2::FloatArray*)(cbg_self);
 
@@ -410,6 +495,27 @@ CBGEXPORT void CBGSTDCALL cbg_Vector2FArray_Assign(void* cbg_self, void* ptr, in
     cbg_self_->Assign(cbg_arg0, cbg_arg1);
 }
 
+CBGEXPORT void CBGSTDCALL cbg_Vector2FArray_Borrow(void* cbg_self, void* ptr, int32_t size) {
+    auto cbg_self_ = (Altseed2::Vector2FArray*)(cbg_self);
+
+    void* cbg_arg0 = ptr;
+    int32_t cbg_arg1 = size;
+    cbg_self_->Borrow(cbg_arg0, cbg_arg1);
+}
+
+CBGEXPORT void CBGSTDCALL cbg_Vector2FArray_Unborrow(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::Vector2FArray*)(cbg_self);
+
+    cbg_self_->Unborrow();
+}
+
+CBGEXPORT bool CBGSTDCALL cbg_Vector2FArray_GetIsBorrowed(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::Vector2FArray*)(cbg_self);
+
+    bool cbg_ret = cbg_self_->GetIsBorrowed();
+    return cbg_ret;
+}
+
 CBGEXPORT void CBGSTDCALL cbg_Vector2FArray_CopyTo(void* cbg_self, void* ptr) {
     auto cbg_self_ = (Altseed2::Vector2FArray*)(cbg_self);
 
@@ -528,6 +634,14 @@ CBGEXPORT void CBGSTDCALL cbg_Log_SetLevel(void* cbg_self, int32_t category, int
     cbg_self_->SetLevel(cbg_arg0, cbg_arg1);
 }
 
+CBGEXPORT void CBGSTDCALL cbg_Log_SetRateLimit(void* cbg_self, int32_t count, float interval) {
+    auto cbg_self_ = (Altseed2::Log*)(cbg_self);
+
+    int32_t cbg_arg0 = count;
+    float cbg_arg1 = interval;
+    cbg_self_->SetRateLimit(cbg_arg0, cbg_arg1);
+}
+
 CBGEXPORT void CBGSTDCALL cbg_Log_AddRef(void* cbg_self) {
     auto cbg_self_ = (Altseed2::Log*)(cbg_self);
 
@@ -851,6 +965,46 @@ CBGEXPORT void CBGSTDCALL cbg_Resources_Reload(void* cbg_self) {
     cbg_self_->Reload();
 }
 
+CBGEXPORT int32_t CBGSTDCALL cbg_Resources_GetMemoryUsageKiB(void* cbg_self, int32_t type) {
+    auto cbg_self_ = (Altseed2::Resources*)(cbg_self);
+
+    Altseed2::ResourceType cbg_arg0 = (Altseed2::ResourceType)type;
+    int32_t cbg_ret = cbg_self_->GetMemoryUsageKiB(cbg_arg0);
+    return cbg_ret;
+}
+
+CBGEXPORT int32_t CBGSTDCALL cbg_Resources_GetMemoryBudgetKiB(void* cbg_self, int32_t type) {
+    auto cbg_self_ = (Altseed2::Resources*)(cbg_self);
+
+    Altseed2::ResourceType cbg_arg0 = (Altseed2::ResourceType)type;
+    int32_t cbg_ret = cbg_self_->GetMemoryBudgetKiB(cbg_arg0);
+    return cbg_ret;
+}
+
+CBGEXPORT void CBGSTDCALL cbg_Resources_SetMemoryBudgetKiB(void* cbg_self, int32_t type, int32_t budget) {
+    auto cbg_self_ = (Altseed2::Resources*)(cbg_self);
+
+    Altseed2::ResourceType cbg_arg0 = (Altseed2::ResourceType)type;
+    int32_t cbg_arg1 = budget;
+    cbg_self_->SetMemoryBudgetKiB(cbg_arg0, cbg_arg1);
+}
+
+CBGEXPORT bool CBGSTDCALL cbg_Resources_SetIsPinned(void* cbg_self, int32_t type, const char16_t* path, bool isPinned) {
+    auto cbg_self_ = (Altseed2::Resources*)(cbg_self);
+
+    Altseed2::ResourceType cbg_arg0 = (Altseed2::ResourceType)type;
+    const char16_t* cbg_arg1 = path;
+    bool cbg_arg2 = isPinned;
+    bool cbg_ret = cbg_self_->SetIsPinned(cbg_arg0, cbg_arg1, cbg_arg2);
+    return cbg_ret;
+}
+
+CBGEXPORT void CBGSTDCALL cbg_Resources_Trim(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::Resources*)(cbg_self);
+
+    cbg_self_->Trim();
+}
+
 CBGEXPORT void CBGSTDCALL cbg_Resources_AddRef(void* cbg_self) {
     auto cbg_self_ = (Altseed2::Resources*)(cbg_self);
 
@@ -1154,6 +1308,14 @@ CBGEXPORT void* CBGSTDCALL cbg_Texture2D_Create(Altseed2::Vector2I_C size) {
     return (void*)Altseed2::AddAndGetSharedPtr<Altseed2::Texture2D>(cbg_ret);
 }
 
+CBGEXPORT bool CBGSTDCALL cbg_Texture2D_Write(void* cbg_self, void* data) {
+    auto cbg_self_ = (Altseed2::Texture2D*)(cbg_self);
+
+    std::shared_ptr<Altseed2::Int8Array> cbg_arg0 = Altseed2::CreateAndAddSharedPtr<Altseed2::Int8Array>((Altseed2::Int8Array*)data);
+    bool cbg_ret = cbg_self_->Write(cbg_arg0);
+    return cbg_ret;
+}
+
 CBGEXPORT const char16_t* CBGSTDCALL cbg_Texture2D_GetPath(void* cbg_self) {
     auto cbg_self_ = (Altseed2::Texture2D*)(cbg_self);
 
@@ -1639,6 +1801,20 @@ CBGEXPORT void CBGSTDCALL cbg_Configuration_SetFileLoggingEnabled(void* cbg_self
     cbg_self_->SetFileLoggingEnabled(cbg_arg0);
 }
 
+CBGEXPORT bool CBGSTDCALL cbg_Configuration_GetAsyncLoggingEnabled(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::Configuration*)(cbg_self);
+
+    bool cbg_ret = cbg_self_->GetAsyncLoggingEnabled();
+    return cbg_ret;
+}
+
+CBGEXPORT void CBGSTDCALL cbg_Configuration_SetAsyncLoggingEnabled(void* cbg_self, bool value) {
+    auto cbg_self_ = (Altseed2::Configuration*)(cbg_self);
+
+    bool cbg_arg0 = value;
+    cbg_self_->SetAsyncLoggingEnabled(cbg_arg0);
+}
+
 CBGEXPORT const char16_t* CBGSTDCALL cbg_Configuration_GetLogFileName(void* cbg_self) {
     auto cbg_self_ = (Altseed2::Configuration*)(cbg_self);
 
@@ -1742,6 +1918,40 @@ CBGEXPORT bool CBGSTDCALL cbg_File_PackWithPassword(void* cbg_self, const char16
     return cbg_ret;
 }
 
+CBGEXPORT void CBGSTDCALL cbg_File_ClearPathCache(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::File*)(cbg_self);
+
+    cbg_self_->ClearPathCache();
+}
+
+CBGEXPORT bool CBGSTDCALL cbg_File_GetIsPathCacheEnabled(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::File*)(cbg_self);
+
+    bool cbg_ret = cbg_self_->GetIsPathCacheEnabled();
+    return cbg_ret;
+}
+
+CBGEXPORT void CBGSTDCALL cbg_File_SetIsPathCacheEnabled(void* cbg_self, bool value) {
+    auto cbg_self_ = (Altseed2::File*)(cbg_self);
+
+    bool cbg_arg0 = value;
+    cbg_self_->SetIsPathCacheEnabled(cbg_arg0);
+}
+
+CBGEXPORT bool CBGSTDCALL cbg_File_GetIsHotReloadEnabled(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::File*)(cbg_self);
+
+    bool cbg_ret = cbg_self_->GetIsHotReloadEnabled();
+    return cbg_ret;
+}
+
+CBGEXPORT void CBGSTDCALL cbg_File_SetIsHotReloadEnabled(void* cbg_self, bool value) {
+    auto cbg_self_ = (Altseed2::File*)(cbg_self);
+
+    bool cbg_arg0 = value;
+    cbg_self_->SetIsHotReloadEnabled(cbg_arg0);
+}
+
 CBGEXPORT void CBGSTDCALL cbg_File_AddRef(void* cbg_self) {
     auto cbg_self_ = (Altseed2::File*)(cbg_self);
 
@@ -2056,13 +2266,22 @@ CBGEXPORT int32_t CBGSTDCALL cbg_Font_GetKerning(void* cbg_self, int32_t c1, int
     return cbg_ret;
 }
 
-CBGEXPORT void* CBGSTDCALL cbg_Font_LoadDynamicFont(const char16_t* path, int32_t samplingSize) {
+CBGEXPORT void* CBGSTDCALL cbg_Font_LoadDynamicFont_char16p_int(const char16_t* path, int32_t samplingSize) {
     const char16_t* cbg_arg0 = path;
     int32_t cbg_arg1 = samplingSize;
     std::shared_ptr<Altseed2::Font> cbg_ret = Altseed2::Font::LoadDynamicFont(cbg_arg0, cbg_arg1);
     return (void*)Altseed2::AddAndGetSharedPtr<Altseed2::Font>(cbg_ret);
 }
 
+CBGEXPORT void* CBGSTDCALL cbg_Font_LoadDynamicFont_char16p_int_FontDistanceFieldType_float(const char16_t* path, int32_t samplingSize, int32_t distanceFieldType, float pxRange) {
+    const char16_t* cbg_arg0 = path;
+    int32_t cbg_arg1 = samplingSize;
+    Altseed2::FontDistanceFieldType cbg_arg2 = (Altseed2::FontDistanceFieldType)distanceFieldType;
+    float cbg_arg3 = pxRange;
+    std::shared_ptr<Altseed2::Font> cbg_ret = Altseed2::Font::LoadDynamicFont(cbg_arg0, cbg_arg1, cbg_arg2, cbg_arg3);
+    return (void*)Altseed2::AddAndGetSharedPtr<Altseed2::Font>(cbg_ret);
+}
+
 CBGEXPORT void* CBGSTDCALL cbg_Font_LoadStaticFont(const char16_t* path) {
     const char16_t* cbg_arg0 = path;
     std::shared_ptr<Altseed2::Font> cbg_ret = Altseed2::Font::LoadStaticFont(cbg_arg0);
@@ -2149,6 +2368,20 @@ CBGEXPORT bool CBGSTDCALL cbg_Font_GetIsStaticFont(void* cbg_self) {
     return cbg_ret;
 }
 
+CBGEXPORT int32_t CBGSTDCALL cbg_Font_GetDistanceFieldType(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::Font*)(cbg_self);
+
+    Altseed2::FontDistanceFieldType cbg_ret = cbg_self_->GetDistanceFieldType();
+    return (int32_t)cbg_ret;
+}
+
+CBGEXPORT float CBGSTDCALL cbg_Font_GetPxRange(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::Font*)(cbg_self);
+
+    float cbg_ret = cbg_self_->GetPxRange();
+    return cbg_ret;
+}
+
 CBGEXPORT const char16_t* CBGSTDCALL cbg_Font_GetPath(void* cbg_self) {
     auto cbg_self_ = (Altseed2::Font*)(cbg_self);
 
@@ -2251,6 +2484,20 @@ CBGEXPORT bool CBGSTDCALL cbg_ImageFont_GetIsStaticFont(void* cbg_self) {
     return cbg_ret;
 }
 
+CBGEXPORT int32_t CBGSTDCALL cbg_ImageFont_GetDistanceFieldType(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::ImageFont*)(cbg_self);
+
+    Altseed2::FontDistanceFieldType cbg_ret = cbg_self_->GetDistanceFieldType();
+    return (int32_t)cbg_ret;
+}
+
+CBGEXPORT float CBGSTDCALL cbg_ImageFont_GetPxRange(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::ImageFont*)(cbg_self);
+
+    float cbg_ret = cbg_self_->GetPxRange();
+    return cbg_ret;
+}
+
 CBGEXPORT void CBGSTDCALL cbg_ImageFont_AddRef(void* cbg_self) {
     auto cbg_self_ = (Altseed2::ImageFont*)(cbg_self);
 
@@ -2434,6 +2681,15 @@ CBGEXPORT void* CBGSTDCALL cbg_RenderedSprite_Create() {
     return (void*)Altseed2::AddAndGetSharedPtr<Altseed2::RenderedSprite>(cbg_ret);
 }
 
+CBGEXPORT void CBGSTDCALL cbg_RenderedSprite_SetBatch(void* sprites, void* transforms, void* srcs, void* colors, int32_t count) {
+    void* cbg_arg0 = sprites;
+    void* cbg_arg1 = transforms;
+    void* cbg_arg2 = srcs;
+    void* cbg_arg3 = colors;
+    int32_t cbg_arg4 = count;
+    Altseed2::RenderedSprite::SetBatch(cbg_arg0, cbg_arg1, cbg_arg2, cbg_arg3, cbg_arg4);
+}
+
 CBGEXPORT Altseed2::AlphaBlend_C CBGSTDCALL cbg_RenderedSprite_GetAlphaBlend(void* cbg_self) {
     auto cbg_self_ = (Altseed2::RenderedSprite*)(cbg_self);
 
@@ -2619,6 +2875,20 @@ CBGEXPORT void CBGSTDCALL cbg_RenderedText_SetIsEnableKerning(void* cbg_self, bo
     cbg_self_->SetIsEnableKerning(cbg_arg0);
 }
 
+CBGEXPORT bool CBGSTDCALL cbg_RenderedText_GetIsEnableShaping(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::RenderedText*)(cbg_self);
+
+    bool cbg_ret = cbg_self_->GetIsEnableShaping();
+    return cbg_ret;
+}
+
+CBGEXPORT void CBGSTDCALL cbg_RenderedText_SetIsEnableShaping(void* cbg_self, bool value) {
+    auto cbg_self_ = (Altseed2::RenderedText*)(cbg_self);
+
+    bool cbg_arg0 = value;
+    cbg_self_->SetIsEnableShaping(cbg_arg0);
+}
+
 CBGEXPORT int32_t CBGSTDCALL cbg_RenderedText_GetWritingDirection(void* cbg_self) {
     auto cbg_self_ = (Altseed2::RenderedText*)(cbg_self);
 
@@ -2815,6 +3085,129 @@ CBGEXPORT void CBGSTDCALL cbg_RenderedPolygon_Release(void* cbg_self) {
     cbg_self_->Release();
 }
 
+CBGEXPORT void* CBGSTDCALL cbg_TextBatch_Create() {
+    std::shared_ptr<Altseed2::TextBatch> cbg_ret = Altseed2::TextBatch::Create();
+    return (void*)Altseed2::AddAndGetSharedPtr<Altseed2::TextBatch>(cbg_ret);
+}
+
+CBGEXPORT void CBGSTDCALL cbg_TextBatch_Add(void* cbg_self, const char16_t* text, Altseed2::Vector2F_C position, Altseed2::Color_C color) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    const char16_t* cbg_arg0 = text;
+    Altseed2::Vector2F_C cbg_arg1 = position;
+    Altseed2::Color_C cbg_arg2 = color;
+    cbg_self_->Add(cbg_arg0, cbg_arg1, cbg_arg2);
+}
+
+CBGEXPORT void CBGSTDCALL cbg_TextBatch_Clear(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    cbg_self_->Clear();
+}
+
+CBGEXPORT Altseed2::AlphaBlend_C CBGSTDCALL cbg_TextBatch_GetAlphaBlend(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    Altseed2::AlphaBlend_C cbg_ret = cbg_self_->GetAlphaBlend();
+    return (cbg_ret);
+}
+
+CBGEXPORT void CBGSTDCALL cbg_TextBatch_SetAlphaBlend(void* cbg_self, Altseed2::AlphaBlend_C value) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    Altseed2::AlphaBlend_C cbg_arg0 = value;
+    cbg_self_->SetAlphaBlend(cbg_arg0);
+}
+
+CBGEXPORT void* CBGSTDCALL cbg_TextBatch_GetMaterialGlyph(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    std::shared_ptr<Altseed2::Material> cbg_ret = cbg_self_->GetMaterialGlyph();
+    return (void*)Altseed2::AddAndGetSharedPtr<Altseed2::Material>(cbg_ret);
+}
+
+CBGEXPORT void CBGSTDCALL cbg_TextBatch_SetMaterialGlyph(void* cbg_self, void* value) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    std::shared_ptr<Altseed2::Material> cbg_arg0 = Altseed2::CreateAndAddSharedPtr<Altseed2::Material>((Altseed2::Material*)value);
+    cbg_self_->SetMaterialGlyph(cbg_arg0);
+}
+
+CBGEXPORT void* CBGSTDCALL cbg_TextBatch_GetMaterialImage(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    std::shared_ptr<Altseed2::Material> cbg_ret = cbg_self_->GetMaterialImage();
+    return (void*)Altseed2::AddAndGetSharedPtr<Altseed2::Material>(cbg_ret);
+}
+
+CBGEXPORT void CBGSTDCALL cbg_TextBatch_SetMaterialImage(void* cbg_self, void* value) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    std::shared_ptr<Altseed2::Material> cbg_arg0 = Altseed2::CreateAndAddSharedPtr<Altseed2::Material>((Altseed2::Material*)value);
+    cbg_self_->SetMaterialImage(cbg_arg0);
+}
+
+CBGEXPORT void* CBGSTDCALL cbg_TextBatch_GetFont(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    std::shared_ptr<Altseed2::Font> cbg_ret = cbg_self_->GetFont();
+    return (void*)Altseed2::AddAndGetSharedPtr<Altseed2::Font>(cbg_ret);
+}
+
+CBGEXPORT void CBGSTDCALL cbg_TextBatch_SetFont(void* cbg_self, void* value) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    std::shared_ptr<Altseed2::Font> cbg_arg0 = Altseed2::CreateAndAddSharedPtr<Altseed2::Font>((Altseed2::Font*)value);
+    cbg_self_->SetFont(cbg_arg0);
+}
+
+CBGEXPORT float CBGSTDCALL cbg_TextBatch_GetFontSize(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    float cbg_ret = cbg_self_->GetFontSize();
+    return cbg_ret;
+}
+
+CBGEXPORT void CBGSTDCALL cbg_TextBatch_SetFontSize(void* cbg_self, float value) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    float cbg_arg0 = value;
+    cbg_self_->SetFontSize(cbg_arg0);
+}
+
+CBGEXPORT bool CBGSTDCALL cbg_TextBatch_GetIsEnableKerning(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    bool cbg_ret = cbg_self_->GetIsEnableKerning();
+    return cbg_ret;
+}
+
+CBGEXPORT void CBGSTDCALL cbg_TextBatch_SetIsEnableKerning(void* cbg_self, bool value) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    bool cbg_arg0 = value;
+    cbg_self_->SetIsEnableKerning(cbg_arg0);
+}
+
+CBGEXPORT int32_t CBGSTDCALL cbg_TextBatch_GetCount(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    int32_t cbg_ret = cbg_self_->GetCount();
+    return cbg_ret;
+}
+
+CBGEXPORT void CBGSTDCALL cbg_TextBatch_AddRef(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    cbg_self_->AddRef();
+}
+
+CBGEXPORT void CBGSTDCALL cbg_TextBatch_Release(void* cbg_self) {
+    auto cbg_self_ = (Altseed2::TextBatch*)(cbg_self);
+
+    cbg_self_->Release();
+}
+
 CBGEXPORT void* CBGSTDCALL cbg_Renderer_GetInstance() {
     std::shared_ptr<Altseed2::Renderer> cbg_ret = Altseed2::Renderer::GetInstance();
     return (void*)Altseed2::AddAndGetSharedPtr<Altseed2::Renderer>(cbg_ret);
@@ -2853,6 +3246,13 @@ CBGEXPORT void CBGSTDCALL cbg_Renderer_DrawText(void* cbg_self, void* text) {
     cbg_self_->DrawText(cbg_arg0);
 }
 
+CBGEXPORT void CBGSTDCALL cbg_Renderer_DrawTextBatch(void* cbg_self, void* batch) {
+    auto cbg_self_ = (Altseed2::Renderer*)(cbg_self);
+
+    std::shared_ptr<Altseed2::TextBatch> cbg_arg0 = Altseed2::CreateAndAddSharedPtr<Altseed2::TextBatch>((Altseed2::TextBatch*)batch);
+    cbg_self_->DrawTextBatch(cbg_arg0);
+}
+
 CBGEXPORT void CBGSTDCALL cbg_Renderer_Render(void* cbg_self) {
     auto cbg_self_ = (Altseed2::Renderer*)(cbg_self);
 
@@ -35,6 +35,14 @@ int32_t BaseObject::AddRef() {
     return reference_;
 }
 
+bool BaseObject::TryAddRef() {
+    auto current = reference_.load();
+    while (current > 0) {
+        if (reference_.compare_exchange_weak(current, current + 1)) return true;
+    }
+    return false;
+}
+
 int32_t BaseObject::Release() {
     auto old = std::atomic_fetch_sub_explicit(&reference_, 1, std::memory_order_consume);
 
@@ -58,6 +66,10 @@ bool BaseObject::GetIsTerminateingEnabled() const {
 
 void BaseObject::SetIsTerminateingEnabled(bool value) {
     terminateingEnabled_ = value;
+
+    if (value && core_ != nullptr) {
+        core_->RegisterTerminating(this);
+    }
 }
 
 }  // namespace Altseed2
\ No newline at end of file
@@ -7,6 +7,16 @@
 #include <memory>
 
 #include "Common/Assertion.h"
+#include "Common/ObjectPool.h"
+
+//! links every BaseObject to Core so that PrintAllBaseObjectName can list them. enabled in debug builds by default
+#ifndef ALTSEED2_TRACK_BASE_OBJECTS
+#ifdef NDEBUG
+#define ALTSEED2_TRACK_BASE_OBJECTS 0
+#else
+#define ALTSEED2_TRACK_BASE_OBJECTS 1
+#endif
+#endif
 
 namespace Altseed2 {
 
@@ -14,6 +24,8 @@ class Core;
 
 #if !USE_CBG
 class BaseObject {
+    friend class Core;
+
 private:
     //! reference counter
     mutable std::atomic<int32_t> reference_;
@@ -21,6 +33,13 @@ private:
     //! retain reference (to protect to core disposed)
     std::shared_ptr<Core> core_;
 
+    //! intrusive list of Core, valid while isLinked_
+    BaseObject* prevObject_ = nullptr;
+    BaseObject* nextObject_ = nullptr;
+    int32_t shardIndex_ = 0;
+    //! written under the lock of the shard, read without it to skip objects never linked
+    std::atomic<bool> isLinked_{false};
+
     std::u16string instanceName_;
     int32_t id_;
 
@@ -40,6 +59,9 @@ public:
     //! Decrease a reference counter
     int32_t Release();
 
+    //! Increase a reference counter unless it is already 0 (the object is being destroyed)
+    bool TryAddRef();
+
     const char16_t* GetInstanceName() const;
     void SetInstanceName(const std::u16string& instanceName);
     void SetInstanceName(const char* instanceName);
@@ -58,6 +80,16 @@ public:
         Don't dispose BaseObject here
     */
     virtual void OnTerminating() {}
+
+#if ALTSEED2_USE_OBJECT_POOL
+    //! derived types are allocated from ObjectPool, with the size of the derived type
+    static void* operator new(size_t size) { return ObjectPool::Allocate(size); }
+    static void operator delete(void* p, size_t size) { ObjectPool::Deallocate(p, size); }
+
+    //! over-aligned types are not pooled
+    static void* operator new(size_t size, std::align_val_t alignment) { return ::operator new(size, alignment); }
+    static void operator delete(void* p, size_t size, std::align_val_t alignment) { ::operator delete(p, size, alignment); }
+#endif
 };
 #endif
 
@@ -71,15 +103,16 @@ struct ReferenceDeleter {
     }
 };
 
+//! the control blocks of the shared_ptrs are allocated from ObjectPool as well as the objects
 template <class T, class... Arg>
 std::shared_ptr<T> MakeAsdShared(Arg&&... args) {
-    return std::shared_ptr<T>(new T(args...), ReferenceDeleter<T>());
+    return std::shared_ptr<T>(new T(args...), ReferenceDeleter<T>(), PoolAllocator<T>());
 }
 
 template <class T>
 std::shared_ptr<T> CreateSharedPtr(T* p) {
     if (p == nullptr) return nullptr;
-    return std::shared_ptr<T>(p, ReferenceDeleter<T>());
+    return std::shared_ptr<T>(p, ReferenceDeleter<T>(), PoolAllocator<T>());
 }
 
 template <class T>
@@ -87,7 +120,7 @@ std::shared_ptr<T> CreateAndAddSharedPtr(T* p) {
     if (p == nullptr) return nullptr;
 
     p->AddRef();
-    return std::shared_ptr<T>(p, ReferenceDeleter<T>());
+    return std::shared_ptr<T>(p, ReferenceDeleter<T>(), PoolAllocator<T>());
 }
 
 template <class T>
@@ -18,6 +18,18 @@ class Array : public BaseObject {
 private:
     std::vector<T> vector_;
 
+    //! memory of the caller which is referred instead of vector_ while borrowed
+    T* borrowed_ = nullptr;
+    int32_t borrowedCount_ = 0;
+
+    //! copies the borrowed memory into vector_ and stops referring it
+    void Own() {
+        if (borrowed_ == nullptr) return;
+        this->vector_.assign(borrowed_, borrowed_ + borrowedCount_);
+        borrowed_ = nullptr;
+        borrowedCount_ = 0;
+    }
+
 public:
     Array() {}
     Array(int32_t size) { vector_.resize(size); }
@@ -37,27 +49,68 @@ public:
     /**
      * @brief データをクリアする
      */
-    void Clear() { this->vector_.clear(); }
+    void Clear() {
+        borrowed_ = nullptr;
+        borrowedCount_ = 0;
+        this->vector_.clear();
+    }
 
     /**
      * @brief 要素数を取得
      */
-    int32_t GetCount() { return this->vector_.size(); }
+    int32_t GetCount() const { return borrowed_ != nullptr ? borrowedCount_ : static_cast<int32_t>(this->vector_.size()); }
 
     /**
      * @brief 要素数を変更
      */
-    void Resize(int32_t size) { this->vector_.resize(size); }
+    void Resize(int32_t size) {
+        Own();
+        this->vector_.resize(size);
+    }
 
     /**
      * @brief 内部の vector オブジェクトを取得
+     * 借用中の場合はデータをコピーして借用を終了する。読み取りのみなら GetPointer を使うこと
      */
-    std::vector<T>& GetVector() { return this->vector_; }
+    std::vector<T>& GetVector() {
+        Own();
+        return this->vector_;
+    }
 
     /**
      * @brief 内部データの生ポインタを取得
      */
-    void* GetData() { return this->vector_.data(); }
+    void* GetData() { return borrowed_ != nullptr ? borrowed_ : this->vector_.data(); }
+
+    /**
+     * @brief 内部データの読み取り専用のポインタを取得。借用中でもコピーしない
+     */
+    const T* GetPointer() const { return borrowed_ != nullptr ? borrowed_ : this->vector_.data(); }
+
+    /**
+     * @brief 借用中かどうかを取得
+     */
+    bool GetIsBorrowed() const { return borrowed_ != nullptr; }
+
+    /**
+     * @brief 配列をコピーせずに参照する
+     * 危険！：C# 連携用！ptrの領域は Unborrow, Assign, Clear を呼ぶかこのオブジェクトが解放されるまで固定し、有効に保つこと
+     */
+    void Borrow(void* ptr, int32_t size) {
+        if (ptr == nullptr || size <= 0) {
+            Clear();
+            return;
+        }
+
+        borrowed_ = static_cast<T*>(ptr);
+        borrowedCount_ = size;
+        this->vector_.clear();
+    }
+
+    /**
+     * @brief 借用しているデータをコピーして借用を終了する
+     */
+    void Unborrow() { Own(); }
 
     /**
      * @brief 配列をコピーする
@@ -65,6 +118,8 @@ public:
      */
     void Assign(void* ptr, int32_t size) {
         T* p = static_cast<T*>(ptr);
+        borrowed_ = nullptr;
+        borrowedCount_ = 0;
         this->vector_.assign(p, p + size);
     }
 
@@ -72,19 +127,19 @@ public:
      * @brief 配列をコピーする
      * 危険！：C# 連携用！Core内部で使う機会はほぼないはず。ptrは予めコピーに十分な領域を確保すること
      */
-    void CopyTo(void* ptr) { std::memcpy(ptr, this->vector_.data(), this->vector_.size() * sizeof(T)); }
+    void CopyTo(void* ptr) { std::memcpy(ptr, GetPointer(), GetCount() * sizeof(T)); }
 
     /**
      * @brief インデックスアクセス
      * 危険！：C# 連携用！Core内部で使うな
      */
-    T GetAt(int32_t index) const { return this->vector_[index]; }
+    T GetAt(int32_t index) const { return GetPointer()[index]; }
 
     /**
      * @brief インデックスアクセス
      * 危険！：C# 連携用！Core内部で使うな
      */
-    void SetAt(int32_t index, T value) { this->vector_[index] = value; }
+    void SetAt(int32_t index, T value) { static_cast<T*>(GetData())[index] = value; }
 
     /**
      * @brief インスタンスを生成します。
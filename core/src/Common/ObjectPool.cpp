@@ -0,0 +1,222 @@
+#include "ObjectPool.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace Altseed2 {
+
+namespace {
+
+constexpr size_t ClassCount = ObjectPool::MaxSize / ObjectPool::Granularity;
+
+//! size of the memory divided into blocks of a size class at once
+constexpr size_t ChunkSize = 64 * 1024;
+
+//! the number of blocks moved between a thread and the shared lists at once
+constexpr int32_t BatchCount = 32;
+
+//! a thread passes blocks to the shared lists when it keeps more free blocks than this
+constexpr int32_t MaxCachedCount = BatchCount * 8;
+
+struct FreeBlock {
+    FreeBlock* Next;
+};
+
+size_t GetSizeClass(size_t size) { return size == 0 ? 0 : (size - 1) / ObjectPool::Granularity; }
+
+//! chunks are aligned by their size, so the chunk of a block is found from its address
+uintptr_t GetChunk(const FreeBlock* block) { return reinterpret_cast<uintptr_t>(block) & ~static_cast<uintptr_t>(ChunkSize - 1); }
+
+class SharedLists {
+private:
+    struct SizeClass {
+        std::mutex Mtx;
+        FreeBlock* Head = nullptr;
+    };
+
+    std::array<SizeClass, ClassCount> classes_;
+    std::atomic<int64_t> reservedSize_{0};
+
+public:
+    //! takes up to BatchCount blocks, dividing a new chunk if there are none
+    int32_t Pop(size_t sizeClass, FreeBlock*& head) {
+        auto& c = classes_[sizeClass];
+        std::lock_guard<std::mutex> lock(c.Mtx);
+
+        if (c.Head == nullptr) {
+            const auto blockSize = (sizeClass + 1) * ObjectPool::Granularity;
+            auto chunk = static_cast<uint8_t*>(::operator new(ChunkSize, std::align_val_t(ChunkSize)));
+            reservedSize_ += ChunkSize;
+            for (size_t offset = 0; offset + blockSize <= ChunkSize; offset += blockSize) {
+                auto block = reinterpret_cast<FreeBlock*>(chunk + offset);
+                block->Next = c.Head;
+                c.Head = block;
+            }
+        }
+
+        head = c.Head;
+        auto tail = c.Head;
+        int32_t count = 1;
+        while (count < BatchCount && tail->Next != nullptr) {
+            tail = tail->Next;
+            count++;
+        }
+
+        c.Head = tail->Next;
+        tail->Next = nullptr;
+        return count;
+    }
+
+    void Push(size_t sizeClass, FreeBlock* head, FreeBlock* tail) {
+        auto& c = classes_[sizeClass];
+        std::lock_guard<std::mutex> lock(c.Mtx);
+        tail->Next = c.Head;
+        c.Head = head;
+    }
+
+    //! frees the chunks of which all blocks are in the list
+    void Trim(size_t sizeClass) {
+        auto& c = classes_[sizeClass];
+        std::lock_guard<std::mutex> lock(c.Mtx);
+
+        const auto blockCount = ChunkSize / ((sizeClass + 1) * ObjectPool::Granularity);
+
+        std::unordered_map<uintptr_t, size_t> freeCounts;
+        for (auto block = c.Head; block != nullptr; block = block->Next) {
+            freeCounts[GetChunk(block)]++;
+        }
+
+        for (auto link = &c.Head; *link != nullptr;) {
+            if (freeCounts[GetChunk(*link)] == blockCount) {
+                *link = (*link)->Next;
+            } else {
+                link = &(*link)->Next;
+            }
+        }
+
+        for (const auto& count : freeCounts) {
+            if (count.second != blockCount) continue;
+            ::operator delete(reinterpret_cast<void*>(count.first), std::align_val_t(ChunkSize));
+            reservedSize_ -= ChunkSize;
+        }
+    }
+
+    int64_t GetReservedSize() const { return reservedSize_; }
+};
+
+//! never destroyed, because objects may be released by other static or thread local destructors
+SharedLists& GetSharedLists() {
+    static auto lists = new SharedLists();
+    return *lists;
+}
+
+struct ThreadCache {
+    std::array<FreeBlock*, ClassCount> Heads{};
+    std::array<int32_t, ClassCount> Counts{};
+
+    ~ThreadCache();
+
+    void* Pop(size_t sizeClass) {
+        if (Heads[sizeClass] == nullptr) {
+            Counts[sizeClass] = GetSharedLists().Pop(sizeClass, Heads[sizeClass]);
+        }
+
+        auto block = Heads[sizeClass];
+        Heads[sizeClass] = block->Next;
+        Counts[sizeClass]--;
+        return block;
+    }
+
+    void Push(size_t sizeClass, void* p) {
+        auto block = static_cast<FreeBlock*>(p);
+        block->Next = Heads[sizeClass];
+        Heads[sizeClass] = block;
+
+        if (++Counts[sizeClass] > MaxCachedCount) {
+            Release(sizeClass, MaxCachedCount / 2);
+        }
+    }
+
+    //! passes count blocks to the shared lists
+    void Release(size_t sizeClass, int32_t count) {
+        if (count <= 0 || Heads[sizeClass] == nullptr) return;
+
+        auto head = Heads[sizeClass];
+        auto tail = head;
+        int32_t released = 1;
+        while (released < count && tail->Next != nullptr) {
+            tail = tail->Next;
+            released++;
+        }
+
+        Heads[sizeClass] = tail->Next;
+        Counts[sizeClass] -= released;
+        GetSharedLists().Push(sizeClass, head, tail);
+    }
+};
+
+//! trivially destructible, so that it can be read after threadCache is destroyed
+thread_local bool isThreadCacheDestroyed = false;
+
+thread_local ThreadCache threadCache;
+
+ThreadCache::~ThreadCache() {
+    isThreadCacheDestroyed = true;
+
+    for (size_t i = 0; i < ClassCount; i++) {
+        Release(i, Counts[i]);
+    }
+}
+
+}  // namespace
+
+void* ObjectPool::Allocate(size_t size) {
+    if (size > MaxSize) return ::operator new(size);
+
+    const auto sizeClass = GetSizeClass(size);
+    if (isThreadCacheDestroyed) {
+        FreeBlock* head = nullptr;
+        const auto count = GetSharedLists().Pop(sizeClass, head);
+
+        // return the rest
+        if (count > 1) {
+            auto tail = head->Next;
+            while (tail->Next != nullptr) tail = tail->Next;
+            GetSharedLists().Push(sizeClass, head->Next, tail);
+        }
+        return head;
+    }
+
+    return threadCache.Pop(sizeClass);
+}
+
+void ObjectPool::Deallocate(void* p, size_t size) {
+    if (p == nullptr) return;
+
+    if (size > MaxSize) {
+        ::operator delete(p);
+        return;
+    }
+
+    const auto sizeClass = GetSizeClass(size);
+    if (isThreadCacheDestroyed) {
+        auto block = static_cast<FreeBlock*>(p);
+        GetSharedLists().Push(sizeClass, block, block);
+        return;
+    }
+
+    threadCache.Push(sizeClass, p);
+}
+
+void ObjectPool::Trim() {
+    for (size_t i = 0; i < ClassCount; i++) {
+        if (!isThreadCacheDestroyed) threadCache.Release(i, threadCache.Counts[i]);
+        GetSharedLists().Trim(i);
+    }
+}
+
+int64_t ObjectPool::GetReservedSize() { return GetSharedLists().GetReservedSize(); }
+
+}  // namespace Altseed2
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+//! BaseObjects are allocated from ObjectPool. disabled with sanitizers so that they can see each object
+#ifndef ALTSEED2_USE_OBJECT_POOL
+#if defined(__SANITIZE_ADDRESS__) || defined(MSVC_SANITIZE)
+#define ALTSEED2_USE_OBJECT_POOL 0
+#elif defined(__has_feature)
+// clang does not define __SANITIZE_ADDRESS__
+#if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer)
+#define ALTSEED2_USE_OBJECT_POOL 0
+#endif
+#endif
+#ifndef ALTSEED2_USE_OBJECT_POOL
+#define ALTSEED2_USE_OBJECT_POOL 1
+#endif
+#endif
+
+namespace Altseed2 {
+
+//! allocator of small objects, which keeps a free list for each size class in each thread
+/**
+    blocks freed by a thread are reused by the same thread without locks.
+    each thread keeps a bounded number of free blocks and passes the rest to the shared lists, taken in batches.
+    memory of the pool is returned to the system only by Trim.
+*/
+class ObjectPool {
+public:
+    static constexpr size_t Granularity = 16;
+
+    //! larger objects are allocated by the global operator new
+    static constexpr size_t MaxSize = 512;
+
+    static void* Allocate(size_t size);
+    static void Deallocate(void* p, size_t size);
+
+    //! frees the chunks whose blocks are all released, after passing the free blocks of the calling thread to the shared lists
+    //! blocks kept by the other threads are not freed
+    static void Trim();
+
+    //! bytes of the chunks allocated from the system
+    static int64_t GetReservedSize();
+};
+
+//! allocator for the control blocks of std::shared_ptr
+template <class T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template <class U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+#if ALTSEED2_USE_OBJECT_POOL
+        if (alignof(T) <= ObjectPool::Granularity) return static_cast<T*>(ObjectPool::Allocate(sizeof(T) * n));
+#endif
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+#if ALTSEED2_USE_OBJECT_POOL
+        if (alignof(T) <= ObjectPool::Granularity) {
+            ObjectPool::Deallocate(p, sizeof(T) * n);
+            return;
+        }
+#endif
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <class U>
+    bool operator==(const PoolAllocator<U>&) const noexcept {
+        return true;
+    }
+
+    template <class U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept {
+        return false;
+    }
+};
+
+}  // namespace Altseed2
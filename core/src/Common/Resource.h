@@ -11,6 +11,9 @@ public:
     Resource() = default;
     virtual ~Resource() = default;
     virtual bool Reload() = 0;
+
+    //! approximate bytes held by the resource, used for the memory budget of Resources
+    virtual int64_t GetMemorySize() const { return 0; }
 };
 
 }  // namespace Altseed2
@@ -0,0 +1,364 @@
+#include "ResourceContainer.h"
+
+#include <algorithm>
+
+#include "../IO/PackFile.h"
+#include "../IO/PathTable.h"
+
+namespace Altseed2 {
+
+ResourceContainer::Shard& ResourceContainer::GetShard(uint64_t hash) {
+    // the lower bits select the bucket in the shard
+    return shards_[(hash >> 16) % ShardCount];
+}
+
+ResourceContainer::EntryMap::iterator ResourceContainer::Find(Shard& shard, const std::u16string& key, uint64_t hash) {
+    const auto range = shard.Resources.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (PackFile::GetIsSamePath(it->second.Key, key)) return it;
+    }
+    return shard.Resources.end();
+}
+
+std::vector<std::shared_ptr<ResourceContainer::ResourceInfomation>> ResourceContainer::GetAllResouces() {
+    std::vector<std::shared_ptr<ResourceInfomation>> resources;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.Mtx);
+        for (const auto& resource : shard.Resources) {
+            resources.push_back(resource.second.Info);
+        }
+    }
+    return resources;
+}
+
+int32_t ResourceContainer::GetCount() {
+    size_t count = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.Mtx);
+        count += shard.Resources.size();
+    }
+    return static_cast<int32_t>(count);
+}
+
+void ResourceContainer::OnRegistered(ResourceInfomation* resource) {
+    memoryUsage_ += resource->GetMemorySize();
+
+    std::lock_guard<std::mutex> lock(listMtx_);
+    resource->lruPrev_ = nullptr;
+    resource->lruNext_ = lruHead_;
+    if (lruHead_ != nullptr) lruHead_->lruPrev_ = resource;
+    lruHead_ = resource;
+    if (lruTail_ == nullptr) lruTail_ = resource;
+    resource->isLinked_ = true;
+
+    sources_.emplace(GetSourceKey(resource->GetPath()), resource);
+}
+
+void ResourceContainer::Use(const std::shared_ptr<ResourceInfomation>& resource) {
+    {
+        std::lock_guard<std::mutex> lock(listMtx_);
+
+        // the entry may have been unregistered after it was found
+        if (resource->isLinked_ && lruHead_ != resource.get()) {
+            auto node = resource.get();
+            node->lruPrev_->lruNext_ = node->lruNext_;
+            if (node->lruNext_ != nullptr) {
+                node->lruNext_->lruPrev_ = node->lruPrev_;
+            } else {
+                lruTail_ = node->lruPrev_;
+            }
+
+            node->lruPrev_ = nullptr;
+            node->lruNext_ = lruHead_;
+            lruHead_->lruPrev_ = node;
+            lruHead_ = node;
+        }
+    }
+
+    if (memoryBudget_ <= 0) return;
+
+    if (!resource->GetIsRetained()) {
+        resource->Retain(false);
+    }
+}
+
+void ResourceContainer::OnUnregistered(const std::shared_ptr<ResourceInfomation>& resource) {
+    memoryUsage_ -= resource->GetMemorySize();
+
+    std::lock_guard<std::mutex> lock(listMtx_);
+    if (!resource->isLinked_) return;
+
+    auto node = resource.get();
+    (node->lruPrev_ != nullptr ? node->lruPrev_->lruNext_ : lruHead_) = node->lruNext_;
+    (node->lruNext_ != nullptr ? node->lruNext_->lruPrev_ : lruTail_) = node->lruPrev_;
+    node->lruPrev_ = nullptr;
+    node->lruNext_ = nullptr;
+    node->isLinked_ = false;
+
+    const auto range = sources_.equal_range(GetSourceKey(node->GetPath()));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == node) {
+            sources_.erase(it);
+            break;
+        }
+    }
+}
+
+void ResourceContainer::Evict() {
+    // a resource destroyed here may release other resources, which must not wait for this
+    std::unique_lock<std::mutex> lock(evictMtx_, std::try_to_lock);
+    if (!lock.owns_lock()) return;
+
+    // destroying a resource unregisters it, which locks the list, so they are released after it is unlocked
+    std::vector<std::shared_ptr<ResourceInfomation>> candidates;
+    {
+        std::lock_guard<std::mutex> lruLock(listMtx_);
+        auto excess = memoryUsage_ - memoryBudget_;
+        for (auto node = lruTail_; node != nullptr && excess > 0; node = node->lruPrev_) {
+            if (!node->GetIsReleasable()) continue;
+            candidates.push_back(node->shared_from_this());
+            excess -= node->GetMemorySize();
+        }
+    }
+
+    for (const auto& resource : candidates) {
+        if (memoryUsage_ <= memoryBudget_) break;
+
+        // destroying the last reference unregisters the resource, which reduces the usage
+        auto released = resource->Release(true);
+    }
+}
+
+void ResourceContainer::EvictIfOverBudget() {
+    if (memoryBudget_ > 0 && memoryUsage_ > memoryBudget_) {
+        Evict();
+    }
+}
+
+std::shared_ptr<Resource> ResourceContainer::Get(const InternedPath* key) { return Get(key->Path, key->Hash); }
+
+std::shared_ptr<Resource> ResourceContainer::Get(const std::u16string& key) {
+    const auto normalized = FileSystem::NormalizePath(key);
+    return Get(normalized, PackFile::GetPathHash(normalized));
+}
+
+std::shared_ptr<Resource> ResourceContainer::Get(const std::u16string& key, uint64_t hash) {
+    auto& shard = GetShard(hash);
+
+    std::shared_ptr<ResourceInfomation> info;
+    {
+        std::lock_guard<std::mutex> lock(shard.Mtx);
+        auto it = Find(shard, key, hash);
+        if (it == shard.Resources.end()) return nullptr;
+        info = it->second.Info;
+    }
+
+    auto res = info->GetResourcePtr();
+    if (res != nullptr) Use(info);
+    return res;
+}
+
+void ResourceContainer::Register(const InternedPath* path, std::shared_ptr<ResourceInfomation> resource) { Register(path->Path, path->Hash, resource); }
+
+void ResourceContainer::Register(const std::u16string& path, std::shared_ptr<ResourceInfomation> resource) {
+    const auto normalized = FileSystem::NormalizePath(path);
+    Register(normalized, PackFile::GetPathHash(normalized), resource);
+}
+
+void ResourceContainer::Register(const std::u16string& key, uint64_t hash, const std::shared_ptr<ResourceInfomation>& resource) {
+    auto& shard = GetShard(hash);
+
+    // the replaced resource may be destroyed with its entry, which locks the shard
+    std::shared_ptr<ResourceInfomation> replaced;
+    {
+        std::lock_guard<std::mutex> lock(shard.Mtx);
+        auto it = Find(shard, key, hash);
+        if (it == shard.Resources.end()) {
+            it = shard.Resources.emplace(hash, Entry{key, nullptr});
+        }
+        replaced = std::move(it->second.Info);
+        it->second.Info = resource;
+        OnRegistered(resource.get());
+    }
+
+    if (replaced != nullptr) OnUnregistered(replaced);
+    Use(resource);
+    EvictIfOverBudget();
+}
+
+std::shared_ptr<Resource> ResourceContainer::GetOrRegister(const InternedPath* path, std::shared_ptr<ResourceInfomation> resource) {
+    return GetOrRegister(path->Path, path->Hash, resource);
+}
+
+std::shared_ptr<Resource> ResourceContainer::GetOrRegister(const std::u16string& path, std::shared_ptr<ResourceInfomation> resource) {
+    const auto normalized = FileSystem::NormalizePath(path);
+    return GetOrRegister(normalized, PackFile::GetPathHash(normalized), resource);
+}
+
+std::shared_ptr<Resource> ResourceContainer::GetOrRegister(
+        const std::u16string& key, uint64_t hash, const std::shared_ptr<ResourceInfomation>& resource) {
+    auto& shard = GetShard(hash);
+
+    std::shared_ptr<ResourceInfomation> replaced;
+    std::shared_ptr<ResourceInfomation> info;
+    std::shared_ptr<Resource> res;
+    bool isRegistered = false;
+    {
+        std::lock_guard<std::mutex> lock(shard.Mtx);
+        auto it = Find(shard, key, hash);
+        if (it == shard.Resources.end()) {
+            it = shard.Resources.emplace(hash, Entry{key, nullptr});
+        }
+
+        auto& registered = it->second.Info;
+        if (registered != nullptr) {
+            res = registered->GetResourcePtr();
+        }
+
+        if (res != nullptr) {
+            info = registered;
+        } else {
+            replaced = std::move(registered);
+            registered = resource;
+            OnRegistered(resource.get());
+            info = resource;
+            res = resource->GetResourcePtr();
+            isRegistered = true;
+        }
+    }
+
+    if (replaced != nullptr) OnUnregistered(replaced);
+    Use(info);
+    if (isRegistered) EvictIfOverBudget();
+    return res;
+}
+
+void ResourceContainer::Unregister(const std::u16string& path) {
+    const auto normalized = FileSystem::NormalizePath(path);
+    Unregister(normalized, PackFile::GetPathHash(normalized), nullptr);
+}
+
+void ResourceContainer::Unregister(const std::u16string& path, const Resource* resource) {
+    const auto normalized = FileSystem::NormalizePath(path);
+    Unregister(normalized, PackFile::GetPathHash(normalized), resource);
+}
+
+void ResourceContainer::Unregister(const std::u16string& key, uint64_t hash, const Resource* resource) {
+    auto& shard = GetShard(hash);
+
+    std::shared_ptr<ResourceInfomation> removed;
+    {
+        std::lock_guard<std::mutex> lock(shard.Mtx);
+        auto it = Find(shard, key, hash);
+        if (it == shard.Resources.end() || (resource != nullptr && it->second.Info->GetRawPtr() != resource)) return;
+        removed = std::move(it->second.Info);
+        shard.Resources.erase(it);
+    }
+
+    OnUnregistered(removed);
+}
+
+void ResourceContainer::Clear() {
+    for (auto& shard : shards_) {
+        // cached resources are destroyed after the lock is released
+        EntryMap removed;
+        {
+            std::lock_guard<std::mutex> lock(shard.Mtx);
+            removed.swap(shard.Resources);
+        }
+
+        for (const auto& resource : removed) {
+            OnUnregistered(resource.second.Info);
+        }
+    }
+}
+
+void ResourceContainer::SetMemoryBudget(int64_t value) {
+    memoryBudget_ = std::max<int64_t>(value, 0);
+
+    if (memoryBudget_ == 0) {
+        for (const auto& resource : GetAllResouces()) {
+            auto released = resource->Release(false);
+        }
+        return;
+    }
+
+    EvictIfOverBudget();
+}
+
+bool ResourceContainer::SetIsPinned(const std::u16string& path, bool isPinned) {
+    const auto key = FileSystem::NormalizePath(path);
+    const auto hash = PackFile::GetPathHash(key);
+    auto& shard = GetShard(hash);
+
+    std::shared_ptr<ResourceInfomation> info;
+    {
+        std::lock_guard<std::mutex> lock(shard.Mtx);
+        auto it = Find(shard, key, hash);
+        if (it == shard.Resources.end()) return false;
+        info = it->second.Info;
+    }
+
+    if (isPinned) {
+        return info->Retain(true);
+    }
+
+    info->SetIsPinned(false);
+    if (memoryBudget_ == 0) {
+        auto released = info->Release(false);
+    } else {
+        EvictIfOverBudget();
+    }
+    return true;
+}
+
+void ResourceContainer::Trim() {
+    for (const auto& resource : GetAllResouces()) {
+        memoryUsage_ += resource->UpdateMemorySize();
+    }
+
+    EvictIfOverBudget();
+}
+
+void ResourceContainer::Reload() {
+    for (auto resource : GetAllResouces()) {
+        auto path = resource->GetPath();
+        auto time = GetModifiedTime(path);
+
+        if (time <= resource->GetModifiedTime()) continue;
+
+        if (!resource->Reload(time)) {
+            // TODO: log failure to reload
+        }
+
+        memoryUsage_ += resource->UpdateMemorySize();
+    }
+}
+
+bool ResourceContainer::Reload(const std::u16string& path) {
+    // a font file is registered once for each sampling size
+    std::vector<std::shared_ptr<ResourceInfomation>> infos;
+    {
+        std::lock_guard<std::mutex> lock(listMtx_);
+        const auto range = sources_.equal_range(GetSourceKey(path));
+        for (auto it = range.first; it != range.second; ++it) {
+            infos.push_back(it->second->shared_from_this());
+        }
+    }
+
+    bool result = true;
+    for (const auto& info : infos) {
+        result = info->Reload(GetModifiedTime(info->GetPath())) && result;
+        memoryUsage_ += info->UpdateMemorySize();
+    }
+    return result;
+}
+
+std::u16string ResourceContainer::GetSourceKey(const std::u16string& path) {
+    // NormalizePath keeps backslashes on Windows, while changed paths are joined with slashes
+    auto key = FileSystem::NormalizePath(path);
+    std::replace(key.begin(), key.end(), u'\\', u'/');
+    return key;
+}
+
+}  // namespace Altseed2
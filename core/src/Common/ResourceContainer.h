@@ -1,11 +1,14 @@
 ﻿#pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <functional>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "../Platform/FileSystem.h"
 #include "Resource.h"
@@ -13,35 +16,112 @@
 #if !USE_CBG
 
 namespace Altseed2 {
+
+struct InternedPath;
+
 class ResourceContainer {
 public:
-    class ResourceInfomation {
+    class ResourceInfomation : public std::enable_shared_from_this<ResourceInfomation> {
+        friend class ResourceContainer;
+
     private:
         std::weak_ptr<Resource> m_resourcePtr;
         Resource* rawPtr_;
         std::u16string m_path;
         int32_t m_modifiedTime;
+        std::mutex mtx_;
+
+        //! strong reference which keeps the resource cached after the handles are released
+        std::shared_ptr<Resource> retained_;
+        bool isPinned_;
+        std::atomic<int64_t> memorySize_;
+
+        //! links of the LRU list of the container, guarded by its listMtx_
+        ResourceInfomation* lruPrev_;
+        ResourceInfomation* lruNext_;
+        bool isLinked_;
 
     public:
         ResourceInfomation(std::shared_ptr<Resource> resource, std::u16string path) {
             m_resourcePtr = resource;
             rawPtr_ = resource.get();
-            m_path = path;
+            m_path = FileSystem::NormalizePath(path);
             m_modifiedTime = ResourceContainer::GetModifiedTime(path);
+            isPinned_ = false;
+            memorySize_ = resource != nullptr ? resource->GetMemorySize() : 0;
+            lruPrev_ = nullptr;
+            lruNext_ = nullptr;
+            isLinked_ = false;
         }
 
+        //! returns nullptr if the resource is being destroyed
         std::shared_ptr<Resource> GetResourcePtr() {
+            std::lock_guard<std::mutex> lock(mtx_);
             auto res = m_resourcePtr.lock();
             if (res != nullptr) return res;
-            res = CreateAndAddSharedPtr<Resource>(rawPtr_);
+            if (rawPtr_ == nullptr || !rawPtr_->TryAddRef()) return nullptr;
+            res = CreateSharedPtr<Resource>(rawPtr_);
             m_resourcePtr = res;
             return res;
         }
 
+        const Resource* GetRawPtr() const { return rawPtr_; }
+
         const std::u16string& GetPath() { return m_path; }
 
         const int32_t GetModifiedTime() { return m_modifiedTime; }
 
+        int64_t GetMemorySize() const { return memorySize_; }
+
+        bool GetIsPinned() {
+            std::lock_guard<std::mutex> lock(mtx_);
+            return isPinned_;
+        }
+
+        bool GetIsRetained() {
+            std::lock_guard<std::mutex> lock(mtx_);
+            return retained_ != nullptr;
+        }
+
+        //! keeps the resource alive until Release is called. returns false if the resource is being destroyed
+        bool Retain(bool isPinned) {
+            auto res = GetResourcePtr();
+            if (res == nullptr) return false;
+
+            std::lock_guard<std::mutex> lock(mtx_);
+            retained_ = res;
+            isPinned_ = isPinned_ || isPinned;
+            return true;
+        }
+
+        void SetIsPinned(bool isPinned) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            isPinned_ = isPinned;
+        }
+
+        //! returns true if only the cache keeps the resource alive
+        bool GetIsReleasable() {
+            std::lock_guard<std::mutex> lock(mtx_);
+            return GetIsReleasableUnlocked();
+        }
+
+        //! returns the strong reference so that the caller destroys it outside of the locks
+        std::shared_ptr<Resource> Release(bool onlyIfUnreferenced) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (isPinned_ || retained_ == nullptr) return nullptr;
+            if (onlyIfUnreferenced && !GetIsReleasableUnlocked()) return nullptr;
+            return std::move(retained_);
+        }
+
+        //! returns the difference of the memory size
+        int64_t UpdateMemorySize() {
+            auto locked = GetResourcePtr();
+            if (locked == nullptr) return 0;
+
+            const auto size = locked->GetMemorySize();
+            return size - memorySize_.exchange(size);
+        }
+
         bool Reload(int32_t time) {
             m_modifiedTime = time;
 
@@ -50,51 +130,136 @@ public:
             if (locked == nullptr) return false;
             return locked->Reload();
         }
+
+    private:
+        bool GetIsReleasableUnlocked() const {
+            if (isPinned_ || retained_ == nullptr) return false;
+
+            // handles from the native side add to the reference count of BaseObject, the others share this shared_ptr
+            return retained_.use_count() == 1 && retained_->GetRef() <= 1;
+        }
     };
 
 private:
-    std::map<std::u16string, std::shared_ptr<ResourceInfomation>> resources;
-    std::mutex resourceMtx_;
+    static constexpr int32_t ShardCount = 16;
+
+    struct Entry {
+        //! normalized by FileSystem::NormalizePath
+        std::u16string Key;
+        std::shared_ptr<ResourceInfomation> Info;
+    };
+
+    //! PackFile::GetPathHash of the key -> entries, whose keys are compared on lookup
+    /**
+        the hash of an interned path is computed once for both the shard and the bucket
+    */
+    using EntryMap = std::unordered_multimap<uint64_t, Entry>;
+
+    //! lookups of keys in different shards do not block each other
+    struct Shard {
+        EntryMap Resources;
+        std::mutex Mtx;
+    };
+
+    std::array<Shard, ShardCount> shards_;
+
+    //! sum of the memory sizes of the registered resources
+    std::atomic<int64_t> memoryUsage_;
+    std::atomic<int64_t> memoryBudget_;
+    std::mutex evictMtx_;
+
+    //! registered resources from the most recently used one
+    ResourceInfomation* lruHead_;
+    ResourceInfomation* lruTail_;
+
+    //! registered resources by the files they are loaded from, which differ from the keys of fonts
+    std::unordered_multimap<std::u16string, ResourceInfomation*> sources_;
+
+    //! guards the LRU list and sources_. locked after a shard
+    std::mutex listMtx_;
+
+    //! the form of a file path in which changed paths are compared
+    static std::u16string GetSourceKey(const std::u16string& path);
+
+    Shard& GetShard(uint64_t hash);
+
+    //! returns the entry of the normalized key or end. the shard must be locked
+    static EntryMap::iterator Find(Shard& shard, const std::u16string& key, uint64_t hash);
+
+    std::shared_ptr<Resource> Get(const std::u16string& key, uint64_t hash);
+    void Register(const std::u16string& key, uint64_t hash, const std::shared_ptr<ResourceInfomation>& resource);
+    std::shared_ptr<Resource> GetOrRegister(const std::u16string& key, uint64_t hash, const std::shared_ptr<ResourceInfomation>& resource);
+
+    //! removes the entry, only if it is registered for resource unless resource is nullptr
+    void Unregister(const std::u16string& key, uint64_t hash, const Resource* resource);
+
+    //! called with the shard locked right after resource is added to it
+    void OnRegistered(ResourceInfomation* resource);
+
+    //! marks resource as the most recently used one and keeps it cached if the budget allows
+    void Use(const std::shared_ptr<ResourceInfomation>& resource);
+
+    //! called with the entry removed from the shard, outside of its lock
+    void OnUnregistered(const std::shared_ptr<ResourceInfomation>& resource);
+
+    //! releases the least recently used resources without handles until the usage fits the budget
+    /**
+        runs when resources are registered or released, not on lookups
+    */
+    void Evict();
+    void EvictIfOverBudget();
 
 public:
-    ResourceContainer() {}
+    ResourceContainer() : memoryUsage_(0), memoryBudget_(0), lruHead_(nullptr), lruTail_(nullptr) {}
 
-    const std::map<std::u16string, std::shared_ptr<ResourceInfomation>>& GetAllResouces() { return resources; }
+    //! snapshot of the registered resources
+    std::vector<std::shared_ptr<ResourceInfomation>> GetAllResouces();
 
-    std::shared_ptr<Resource> Get(const std::u16string key) {
-        std::lock_guard<std::mutex> lock(resourceMtx_);
-        if (resources.count(key) > 0) return resources[key]->GetResourcePtr();
-        return nullptr;
-    }
+    int32_t GetCount();
 
-    void Register(const std::u16string path, std::shared_ptr<ResourceInfomation> resource) {
-        std::lock_guard<std::mutex> lock(resourceMtx_);
-        resources[path] = resource;
-    }
+    //! returns nullptr if the key is not registered or the resource is being destroyed
+    /**
+        keys are normalized on each call. files pass their interned paths, which are normalized already
+    */
+    std::shared_ptr<Resource> Get(const InternedPath* key);
+    std::shared_ptr<Resource> Get(const std::u16string& key);
 
-    void Unregister(const std::u16string path) {
-        if (resources.count(path) == 0) return;
-        std::lock_guard<std::mutex> lock(resourceMtx_);
-        resources.erase(path);
-    }
+    void Register(const InternedPath* path, std::shared_ptr<ResourceInfomation> resource);
+    void Register(const std::u16string& path, std::shared_ptr<ResourceInfomation> resource);
 
-    void Clear() {
-        std::lock_guard<std::mutex> lock(resourceMtx_);
-        resources.clear();
-    }
+    //! registers resource unless a living resource is registered with the key, and returns the registered one
+    std::shared_ptr<Resource> GetOrRegister(const InternedPath* path, std::shared_ptr<ResourceInfomation> resource);
+    std::shared_ptr<Resource> GetOrRegister(const std::u16string& path, std::shared_ptr<ResourceInfomation> resource);
 
-    void Reload() {
-        for (auto resource : resources) {
-            auto path = resource.second->GetPath();
-            auto time = GetModifiedTime(path);
+    void Unregister(const std::u16string& path);
 
-            if (resource.second->GetModifiedTime() < time) continue;
+    //! unregisters the key only if it is registered for resource, for destructors of resources
+    void Unregister(const std::u16string& path, const Resource* resource);
 
-            if (!resources[resource.first]->Reload(time)) {
-                // TODO: log failure to reload
-            }
-        }
-    }
+    void Clear();
+
+    //! reloads the resources whose files are newer than when they were loaded
+    void Reload();
+
+    //! reloads the resources loaded from the file, if any. returns false if any of them fails to reload
+    bool Reload(const std::u16string& path);
+
+    //! bytes used by the registered resources, measured when they are registered or reloaded
+    int64_t GetMemoryUsage() const { return memoryUsage_; }
+
+    //! bytes up to which released resources stay cached. 0 (default) releases them immediately
+    /**
+        the least recently used resources which have no handles are evicted while the usage exceeds the budget.
+        resources with handles are never evicted, so the usage may exceed the budget.
+    */
+    int64_t GetMemoryBudget() const { return memoryBudget_; }
+    void SetMemoryBudget(int64_t value);
+
+    //! pinned resources stay cached regardless of the budget. returns false if path is not registered
+    bool SetIsPinned(const std::u16string& path, bool isPinned);
+
+    //! measures the resources again and evicts released resources over the budget
+    void Trim();
 
     static int32_t GetModifiedTime(const std::u16string path) {
         auto time = FileSystem::GetLastWriteTime(path);
@@ -104,4 +269,4 @@ public:
 
 }  // namespace Altseed2
 
-#endif
\ No newline at end of file
+#endif
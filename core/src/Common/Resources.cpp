@@ -1,5 +1,10 @@
 ﻿#include "Resources.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "../Logger/Log.h"
+
 namespace Altseed2 {
 
 std::shared_ptr<Resources> Resources::instance = nullptr;
@@ -12,13 +17,19 @@ bool Resources::Initialize() {
     return true;
 }
 
-void Resources::Terminate() { instance = nullptr; }
+void Resources::Terminate() {
+    // cached resources refer to the instance
+    if (instance != nullptr) {
+        instance->Clear();
+    }
+    instance = nullptr;
+}
 
 std::shared_ptr<Resources>& Resources::GetInstance() { return instance; }
 
 const std::shared_ptr<ResourceContainer>& Resources::GetResourceContainer(ResourceType type) { return m_containers[type]; }
 
-const int32_t Resources::GetResourcesCount(ResourceType type) { return m_containers[type]->GetAllResouces().size(); }
+const int32_t Resources::GetResourcesCount(ResourceType type) { return m_containers[type]->GetCount(); }
 
 void Resources::Clear() {
     for (int32_t i = 0; i < (int32_t)ResourceType::MAX; i++) {
@@ -26,10 +37,62 @@ void Resources::Clear() {
     }
 }
 
+void Resources::SetChangedPathsProvider(const ChangedPathsProvider& provider) {
+    std::lock_guard<std::mutex> lock(changedPathsProviderMtx_);
+    changedPathsProvider_ = provider;
+}
+
 void Resources::Reload() {
+    ChangedPathsProvider provider;
+    {
+        std::lock_guard<std::mutex> lock(changedPathsProviderMtx_);
+        provider = changedPathsProvider_;
+    }
+
+    std::vector<std::u16string> changedPaths;
+    if (provider != nullptr && provider(changedPaths)) {
+        for (const auto& path : changedPaths) {
+            for (int32_t i = 0; i < (int32_t)ResourceType::MAX; i++) {
+                if (!m_containers[(ResourceType)i]->Reload(path)) {
+                    Log::GetInstance()->Warn(LogCategory::Core, u"Resources::Reload: Failed to reload '{0}'", utf16_to_utf8(path).c_str());
+                }
+            }
+        }
+        return;
+    }
+
     for (int32_t i = 0; i < (int32_t)ResourceType::MAX; i++) {
         m_containers[(ResourceType)i]->Reload();
     }
 }
 
+const int64_t Resources::GetMemoryUsage(ResourceType type) { return m_containers[type]->GetMemoryUsage(); }
+
+const int64_t Resources::GetMemoryBudget(ResourceType type) { return m_containers[type]->GetMemoryBudget(); }
+
+void Resources::SetMemoryBudget(ResourceType type, int64_t budget) { m_containers[type]->SetMemoryBudget(budget); }
+
+const int32_t Resources::GetMemoryUsageKiB(ResourceType type) {
+    const auto kib = (GetMemoryUsage(type) + 1023) / 1024;
+    return static_cast<int32_t>(std::min<int64_t>(kib, std::numeric_limits<int32_t>::max()));
+}
+
+const int32_t Resources::GetMemoryBudgetKiB(ResourceType type) {
+    const auto kib = GetMemoryBudget(type) / 1024;
+    return static_cast<int32_t>(std::min<int64_t>(kib, std::numeric_limits<int32_t>::max()));
+}
+
+void Resources::SetMemoryBudgetKiB(ResourceType type, int32_t budget) { SetMemoryBudget(type, static_cast<int64_t>(budget) * 1024); }
+
+bool Resources::SetIsPinned(ResourceType type, const char16_t* path, bool isPinned) {
+    RETURN_IF_NULL(path, false);
+    return m_containers[type]->SetIsPinned(path, isPinned);
+}
+
+void Resources::Trim() {
+    for (int32_t i = 0; i < (int32_t)ResourceType::MAX; i++) {
+        m_containers[(ResourceType)i]->Trim();
+    }
+}
+
 }  // namespace Altseed2
\ No newline at end of file
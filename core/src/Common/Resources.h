@@ -1,7 +1,10 @@
 ﻿#pragma once
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "../BaseObject.h"
 #include "../StdIntCBG.h"
@@ -22,6 +25,16 @@ private:
 
     std::map<ResourceType, std::shared_ptr<ResourceContainer>> m_containers;
 
+#if !USE_CBG
+public:
+    //! fills the paths changed since the last call and returns true, or returns false if changes are not tracked
+    using ChangedPathsProvider = std::function<bool(std::vector<std::u16string>&)>;
+
+private:
+    ChangedPathsProvider changedPathsProvider_;
+    std::mutex changedPathsProviderMtx_;
+#endif
+
 public:
 #if !USE_CBG
     static bool Initialize();
@@ -35,6 +48,9 @@ public:
 
     const std::shared_ptr<ResourceContainer>& GetResourceContainer(ResourceType type);
 
+    //! Reload reloads only the changed files while provider tracks them, and checks every resource otherwise
+    void SetChangedPathsProvider(const ChangedPathsProvider& provider);
+
 #endif
 
     const int32_t GetResourcesCount(ResourceType type);
@@ -42,5 +58,30 @@ public:
     void Clear();
 
     void Reload();
+
+#if !USE_CBG
+
+    //! bytes used by the resources of the type
+    const int64_t GetMemoryUsage(ResourceType type);
+
+    //! bytes up to which released resources of the type stay cached (see ResourceContainer::SetMemoryBudget)
+    const int64_t GetMemoryBudget(ResourceType type);
+
+    void SetMemoryBudget(ResourceType type, int64_t budget);
+
+#endif
+
+    //! the memory usage in KiB, rounded up, as the bindings pass 32-bit integers
+    const int32_t GetMemoryUsageKiB(ResourceType type);
+
+    const int32_t GetMemoryBudgetKiB(ResourceType type);
+
+    void SetMemoryBudgetKiB(ResourceType type, int32_t budget);
+
+    //! keeps the resource cached regardless of the budget
+    bool SetIsPinned(ResourceType type, const char16_t* path, bool isPinned);
+
+    //! measures the resources again and evicts the cached ones over the budgets
+    void Trim();
 };
 }  // namespace Altseed2
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include "StringHelper.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ALTSEED2_STRING_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ALTSEED2_STRING_NEON
+#endif
+
+namespace Altseed2 {
+
+namespace {
+
+//! copies ASCII code units while they continue and returns the number of them
+size_t CopyAsciiU16ToU8(const char16_t* src, size_t length, uint8_t* dst) {
+    size_t i = 0;
+
+#if defined(ALTSEED2_STRING_SSE2)
+    const __m128i mask = _mm_set1_epi16(static_cast<int16_t>(0xFF80));
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= length; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, mask), zero)) != 0xFFFF) break;
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(v, v));
+    }
+#elif defined(ALTSEED2_STRING_NEON)
+    const uint16x8_t mask = vdupq_n_u16(0xFF80);
+    for (; i + 8 <= length; i += 8) {
+        const uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t*>(src + i));
+        const uint64x2_t high = vreinterpretq_u64_u16(vandq_u16(v, mask));
+        if ((vgetq_lane_u64(high, 0) | vgetq_lane_u64(high, 1)) != 0) break;
+        vst1_u8(dst + i, vmovn_u16(v));
+    }
+#else
+    // 4 code units per iteration
+    for (; i + 4 <= length; i += 4) {
+        uint64_t v;
+        std::memcpy(&v, src + i, sizeof(v));
+        if ((v & 0xFF80FF80FF80FF80ULL) != 0) break;
+        for (size_t j = 0; j < 4; j++) dst[i + j] = static_cast<uint8_t>(src[i + j]);
+    }
+#endif
+
+    for (; i < length && src[i] < 0x80; i++) {
+        dst[i] = static_cast<uint8_t>(src[i]);
+    }
+
+    return i;
+}
+
+//! copies ASCII bytes while they continue and returns the number of them
+size_t CopyAsciiU8ToU16(const uint8_t* src, size_t length, char16_t* dst) {
+    size_t i = 0;
+
+#if defined(ALTSEED2_STRING_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= length; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        if (_mm_movemask_epi8(v) != 0) break;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpackhi_epi8(v, zero));
+    }
+#elif defined(ALTSEED2_STRING_NEON)
+    const uint8x16_t mask = vdupq_n_u8(0x80);
+    for (; i + 16 <= length; i += 16) {
+        const uint8x16_t v = vld1q_u8(src + i);
+        const uint64x2_t high = vreinterpretq_u64_u8(vandq_u8(v, mask));
+        if ((vgetq_lane_u64(high, 0) | vgetq_lane_u64(high, 1)) != 0) break;
+        vst1q_u16(reinterpret_cast<uint16_t*>(dst + i), vmovl_u8(vget_low_u8(v)));
+        vst1q_u16(reinterpret_cast<uint16_t*>(dst + i + 8), vmovl_u8(vget_high_u8(v)));
+    }
+#else
+    // 8 bytes per iteration
+    for (; i + 8 <= length; i += 8) {
+        uint64_t v;
+        std::memcpy(&v, src + i, sizeof(v));
+        if ((v & 0x8080808080808080ULL) != 0) break;
+        for (size_t j = 0; j < 8; j++) dst[i + j] = src[i + j];
+    }
+#endif
+
+    for (; i < length && src[i] < 0x80; i++) {
+        dst[i] = src[i];
+    }
+
+    return i;
+}
+
+}  // namespace
+
+void utf16_to_utf8(const char16_t* s, size_t length, std::string& out) {
+    // a code unit is encoded into 3 bytes at most (a surrogate pair into 4 bytes)
+    out.resize(length * 3);
+    if (length == 0) return;
+
+    auto dst = reinterpret_cast<uint8_t*>(&out[0]);
+    size_t i = 0;
+    size_t o = 0;
+
+    while (i < length) {
+        const char16_t c = s[i];
+        if (c < 0x80) {
+            const auto count = CopyAsciiU16ToU8(s + i, length - i, dst + o);
+            i += count;
+            o += count;
+            continue;
+        }
+
+        i++;
+        if (c < 0x800) {
+            dst[o++] = static_cast<uint8_t>(0xC0 | (c >> 6));
+            dst[o++] = static_cast<uint8_t>(0x80 | (c & 0x3F));
+        } else if (IsU16HighSurrogate(c) && i < length && IsU16LowSurrogate(s[i])) {
+            const char32_t u32Ch = 0x10000 + (char32_t(c) - 0xD800) * 0x400 + (char32_t(s[i]) - 0xDC00);
+            i++;
+            dst[o++] = static_cast<uint8_t>(0xF0 | (u32Ch >> 18));
+            dst[o++] = static_cast<uint8_t>(0x80 | ((u32Ch >> 12) & 0x3F));
+            dst[o++] = static_cast<uint8_t>(0x80 | ((u32Ch >> 6) & 0x3F));
+            dst[o++] = static_cast<uint8_t>(0x80 | (u32Ch & 0x3F));
+        } else if (IsU16HighSurrogate(c) || IsU16LowSurrogate(c)) {
+            // unpaired surrogate is replaced with U+FFFD
+            dst[o++] = 0xEF;
+            dst[o++] = 0xBF;
+            dst[o++] = 0xBD;
+        } else {
+            dst[o++] = static_cast<uint8_t>(0xE0 | (c >> 12));
+            dst[o++] = static_cast<uint8_t>(0x80 | ((c >> 6) & 0x3F));
+            dst[o++] = static_cast<uint8_t>(0x80 | (c & 0x3F));
+        }
+    }
+
+    out.resize(o);
+}
+
+bool utf8_to_utf16(const char* s, size_t length, std::u16string& out) {
+    // a byte is decoded into 1 code unit at most (4 bytes into a surrogate pair)
+    out.resize(length);
+    if (length == 0) return true;
+
+    auto src = reinterpret_cast<const uint8_t*>(s);
+    auto dst = &out[0];
+    size_t i = 0;
+    size_t o = 0;
+
+    while (i < length) {
+        const uint8_t c = src[i];
+        if (c < 0x80) {
+            const auto count = CopyAsciiU8ToU16(src + i, length - i, dst + o);
+            i += count;
+            o += count;
+            continue;
+        }
+
+        const auto numBytes = static_cast<size_t>(GetU8ByteCount(static_cast<char>(c)));
+        if (numBytes == 0 || i + numBytes > length) {
+            out.clear();
+            return false;
+        }
+
+        char32_t u32Ch = c & (0x7F >> numBytes);
+        for (size_t j = 1; j < numBytes; j++) {
+            const uint8_t b = src[i + j];
+            if ((b & 0xC0) != 0x80) {
+                out.clear();
+                return false;
+            }
+            u32Ch = (u32Ch << 6) | (b & 0x3F);
+        }
+
+        // overlong encodings (2 bytes ones are excluded by GetU8ByteCount) and out of range
+        if ((numBytes == 3 && u32Ch < 0x800) || (numBytes == 4 && (u32Ch < 0x10000 || u32Ch > 0x10FFFF))) {
+            out.clear();
+            return false;
+        }
+
+        i += numBytes;
+        if (u32Ch < 0x10000) {
+            dst[o++] = static_cast<char16_t>(u32Ch);
+        } else {
+            dst[o++] = static_cast<char16_t>((u32Ch - 0x10000) / 0x400 + 0xD800);
+            dst[o++] = static_cast<char16_t>((u32Ch - 0x10000) % 0x400 + 0xDC00);
+        }
+    }
+
+    out.resize(o);
+    return true;
+}
+
+}  // namespace Altseed2
@@ -1,25 +1,31 @@
 ﻿#pragma once
 
 #include <array>
-#include <codecvt>
-#include <locale>
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace Altseed2 {
 
-// http://hasenpfote36.blogspot.jp/2016/09/stdcodecvt.html
-static constexpr std::codecvt_mode mode = std::codecvt_mode::little_endian;
+//! converts UTF-16 into out, reusing its capacity. unpaired surrogates are replaced with U+FFFD
+void utf16_to_utf8(const char16_t* s, size_t length, std::string& out);
+
+//! converts UTF-8 into out, reusing its capacity. returns false and clears out if s is not valid UTF-8
+bool utf8_to_utf16(const char* s, size_t length, std::u16string& out);
 
 static std::string utf16_to_utf8(const std::u16string& s) {
-#if defined(_MSC_VER)
-    std::wstring_convert<std::codecvt_utf8_utf16<std::uint16_t, 0x10ffff, mode>, std::uint16_t> conv;
-    auto p = reinterpret_cast<const std::uint16_t*>(s.c_str());
-    return conv.to_bytes(p, p + s.length());
-#else
-    std::wstring_convert<std::codecvt_utf8_utf16<char16_t, 0x10ffff, mode>, char16_t> conv;
-    return conv.to_bytes(s);
-#endif
+    std::string ret;
+    utf16_to_utf8(s.data(), s.size(), ret);
+    return ret;
+}
+
+//! avoids constructing a temporary std::u16string
+static std::string utf16_to_utf8(const char16_t* s) {
+    std::string ret;
+    if (s != nullptr) {
+        utf16_to_utf8(s, std::char_traits<char16_t>::length(s), ret);
+    }
+    return ret;
 }
 
 static bool IsU8LaterByte(char ch) { return 0x80 <= uint8_t(ch) && uint8_t(ch) < 0xC0; }
@@ -40,6 +46,13 @@ static int GetU8ByteCount(char ch) {
     return 0;
 }
 
+//! the length of s cut to at most maxLength bytes, without splitting a UTF-8 sequence
+static size_t GetU8TruncatedLength(const std::string& s, size_t maxLength) {
+    if (s.size() <= maxLength) return s.size();
+    while (maxLength > 0 && IsU8LaterByte(s[maxLength])) maxLength--;
+    return maxLength;
+}
+
 static bool ConvChU8ToU32(const std::array<char, 4>& u8Ch, char32_t& u32Ch) {
     int numBytes = GetU8ByteCount(u8Ch[0]);
     if (numBytes == 0) {
@@ -121,31 +134,15 @@ static bool ConvChU8ToU16(const std::array<char, 4>& u8Ch, std::array<char16_t,
 
 static std::u16string utf8_to_utf16(const std::string& u8Str) {
     std::u16string u16Str;
-    for (auto u8It = u8Str.begin(); u8It != u8Str.end(); ++u8It) {
-        auto numBytes = GetU8ByteCount((*u8It));
-        if (numBytes == 0) {
-            return std::u16string();
-        }
-
-        std::array<char, 4> u8Ch;
-        u8Ch[0] = (*u8It);
-        for (int i = 1; i < numBytes; i++) {
-            ++u8It;
-            if (u8It == u8Str.end()) {
-                return std::u16string();
-            }
-            u8Ch[i] = (*u8It);
-        }
-
-        std::array<char16_t, 2> u16Ch;
-        if (!ConvChU8ToU16(u8Ch, u16Ch)) {
-            return std::u16string();
-        }
+    utf8_to_utf16(u8Str.data(), u8Str.size(), u16Str);
+    return u16Str;
+}
 
-        u16Str.push_back(u16Ch[0]);
-        if (u16Ch[1] != 0) {
-            u16Str.push_back(u16Ch[1]);
-        }
+//! avoids constructing a temporary std::string
+static std::u16string utf8_to_utf16(const char* u8Str) {
+    std::u16string u16Str;
+    if (u8Str != nullptr) {
+        utf8_to_utf16(u8Str, std::char_traits<char>::length(u8Str), u16Str);
     }
     return u16Str;
 }
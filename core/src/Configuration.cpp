@@ -48,6 +48,10 @@ bool Configuration::GetFileLoggingEnabled() const { return fileLoggingEnabled_;
 
 void Configuration::SetFileLoggingEnabled(bool fileLoggingEnabled) { fileLoggingEnabled_ = fileLoggingEnabled; }
 
+bool Configuration::GetAsyncLoggingEnabled() const { return asyncLoggingEnabled_; }
+
+void Configuration::SetAsyncLoggingEnabled(bool asyncLoggingEnabled) { asyncLoggingEnabled_ = asyncLoggingEnabled; }
+
 const char16_t* Configuration::GetLogFileName() const { return logFileName_.c_str(); }
 
 void Configuration::SetLogFileName(const char16_t* logFilename) {
@@ -37,6 +37,7 @@ private:
 
     bool consoleLoggingEnabled_ = false;
     bool fileLoggingEnabled_ = false;
+    bool asyncLoggingEnabled_ = false;
 
     std::u16string logFileName_ = u"Log.txt";
 
@@ -68,6 +69,9 @@ public:
     bool GetFileLoggingEnabled() const;
     void SetFileLoggingEnabled(bool enabeldFileLogging);
 
+    bool GetAsyncLoggingEnabled() const;
+    void SetAsyncLoggingEnabled(bool asyncLoggingEnabled);
+
     const char16_t* GetLogFileName() const;
     void SetLogFileName(const char16_t* logFileName);
 
@@ -6,6 +6,7 @@
 
 #include "BaseObject.h"
 #include "Common/Profiler.h"
+#include "Common/StringHelper.h"
 #include "Graphics/Font.h"
 #include "Graphics/FrameDebugger.h"
 #include "Graphics/Graphics.h"
@@ -18,6 +19,7 @@
 #include "Input/Mouse.h"
 #include "Logger/Log.h"
 #include "Sound/SoundMixer.h"
+#include "System/AsyncLoader.h"
 #include "System/SynchronizationContext.h"
 #include "Tool/Tool.h"
 #include "Window/Window.h"
@@ -25,35 +27,86 @@
 namespace Altseed2 {
 std::shared_ptr<Core> Core::instance = nullptr;
 
+int32_t Core::GetCurrentShardIndex() {
+    static std::atomic<int32_t> nextIndex(0);
+    thread_local const int32_t index = nextIndex++ % BaseObjectShardCount;
+    return index;
+}
+
+void Core::Link(BaseObject* o) {
+    auto& shard = baseObjectShards_[o->shardIndex_];
+    std::lock_guard<std::mutex> lock(shard.Mtx);
+    if (o->isLinked_) return;
+
+    o->prevObject_ = nullptr;
+    o->nextObject_ = shard.Head;
+    if (shard.Head != nullptr) shard.Head->prevObject_ = o;
+    shard.Head = o;
+    o->isLinked_.store(true, std::memory_order_release);
+}
+
 int32_t Core::Register(BaseObject* o) {
-    std::lock_guard<std::mutex> lock(baseObjectMtx_);
-    baseObjects_.insert(o);
+    o->shardIndex_ = GetCurrentShardIndex();
+    baseObjectShards_[o->shardIndex_].Count++;
+
+#if ALTSEED2_TRACK_BASE_OBJECTS
+    Link(o);
+#endif
+
     return maxBaseObjectId_++;
 }
 
 void Core::Unregister(BaseObject* o) {
-    std::lock_guard<std::mutex> lock(baseObjectMtx_);
-    baseObjects_.erase(o);
+    auto& shard = baseObjectShards_[o->shardIndex_];
+    shard.Count--;
+
+    // most objects are never linked, so the lock is taken only when the flag may be set
+    if (!o->isLinked_.load(std::memory_order_acquire)) return;
+
+    std::lock_guard<std::mutex> lock(shard.Mtx);
+    if (!o->isLinked_) return;
+
+    if (o->prevObject_ != nullptr) {
+        o->prevObject_->nextObject_ = o->nextObject_;
+    } else {
+        shard.Head = o->nextObject_;
+    }
+    if (o->nextObject_ != nullptr) o->nextObject_->prevObject_ = o->prevObject_;
+
+    o->prevObject_ = nullptr;
+    o->nextObject_ = nullptr;
+    o->isLinked_ = false;
 }
 
-int32_t Core::GetBaseObjectCount() {
-    std::lock_guard<std::mutex> lock(baseObjectMtx_);
+void Core::RegisterTerminating(BaseObject* o) { Link(o); }
 
-    return (int32_t)baseObjects_.size();
+int32_t Core::GetBaseObjectCount() {
+    int32_t count = 0;
+    for (const auto& shard : baseObjectShards_) {
+        count += shard.Count;
+    }
+    return count;
 }
 
 void Core::PrintAllBaseObjectName() {
-    std::lock_guard<std::mutex> lock(baseObjectMtx_);
+#if ALTSEED2_TRACK_BASE_OBJECTS
+    for (auto& shard : baseObjectShards_) {
+        std::lock_guard<std::mutex> lock(shard.Mtx);
 
-    for (auto& o : baseObjects_) {
-        std::cout << o->GetInstanceName() << std::endl;
+        for (auto o = shard.Head; o != nullptr; o = o->nextObject_) {
+            std::cout << utf16_to_utf8(o->GetInstanceName()) << std::endl;
+        }
     }
+#else
+    std::cout << GetBaseObjectCount() << " objects (build with ALTSEED2_TRACK_BASE_OBJECTS to print their names)" << std::endl;
+#endif
 }
 
 bool Core::Initialize(const char16_t* title, int32_t width, int32_t height, std::shared_ptr<Configuration> config) {
     RETURN_IF_NULL(config, false);
 
-    if (!Log::Initialize(config->GetConsoleLoggingEnabled(), config->GetFileLoggingEnabled(), config->GetLogFileName())) {
+    if (!Log::Initialize(
+                config->GetConsoleLoggingEnabled(), config->GetFileLoggingEnabled(), config->GetLogFileName(), config->GetAsyncLoggingEnabled())) {
         Core::instance = nullptr;
         std::cout << "Log::Initialize failed" << std::endl;
         return false;
@@ -183,6 +236,7 @@ bool Core::Initialize(const char16_t* title, int32_t width, int32_t height, std:
     }
 
     SynchronizationContext::Initialize();
+    AsyncLoader::Initialize();
 
     Core::instance->fps_ = std::make_unique<FPS>();
 
@@ -198,7 +252,12 @@ bool Core::Initialize(int32_t width, int32_t height) {
 void Core::Terminate() {
     EASY_BLOCK("Altseed2(C++).Core.Terminate");
 
-    SynchronizationContext::GetInstance()->Run();
+    // pending loads post their uploads to SynchronizationContext
+    AsyncLoader::Terminate();
+
+    // events may add other events, which would be dropped if they were left for the next Run
+    while (SynchronizationContext::GetInstance()->Run()) {
+    }
 
     if (Graphics::GetInstance() != nullptr) {
         Graphics::GetInstance()->GetGraphicsLLGI()->WaitFinish();
@@ -206,13 +265,19 @@ void Core::Terminate() {
 
     // notify terminating to objects
     {
-        std::lock_guard<std::mutex> lock(Core::instance->baseObjectMtx_);
+        // objects being destroyed wait for the lock to unlink themselves, so the others are kept alive until notified
+        std::vector<BaseObject*> terminatingObjects;
+        for (auto& shard : Core::instance->baseObjectShards_) {
+            std::lock_guard<std::mutex> lock(shard.Mtx);
 
-        for (auto o : Core::instance->baseObjects_) {
-            if (!o->GetIsTerminateingEnabled()) {
-                continue;
+            for (auto o = shard.Head; o != nullptr; o = o->nextObject_) {
+                if (o->GetIsTerminateingEnabled() && o->TryAddRef()) terminatingObjects.push_back(o);
             }
+        }
+
+        for (auto o : terminatingObjects) {
             o->OnTerminating();
+            o->Release();
         }
     }
 
@@ -262,6 +327,9 @@ void Core::Terminate() {
     Log::Terminate();
 
     Core::instance = nullptr;
+
+    // objects of the engine are released by now
+    ObjectPool::Trim();
 }
 
 std::shared_ptr<Core>& Core::GetInstance() { return instance; }
@@ -3,9 +3,10 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
-#include <set>
 
 #include "BaseObject.h"
 #include "Configuration.h"
@@ -21,18 +22,33 @@ class Core : public BaseObject {
 private:
     static std::shared_ptr<Core> instance;
 
-    //! mutex for a list of baseObjects
-    std::mutex baseObjectMtx_;
+#if !USE_CBG
+    static constexpr int32_t BaseObjectShardCount = 16;
+
+    //! baseObjects created by a thread go to the same shard, so that threads rarely share a lock or a counter
+    struct alignas(64) BaseObjectShard {
+        std::mutex Mtx;
+
+        //! head of the intrusive list, linking every object if ALTSEED2_TRACK_BASE_OBJECTS, otherwise only the ones to notify terminating
+        BaseObject* Head = nullptr;
+
+        //! the number of living objects created by the threads of the shard
+        std::atomic<int32_t> Count{0};
+    };
+
+    std::array<BaseObjectShard, BaseObjectShardCount> baseObjectShards_;
 
-    //! list of baseObjects
-    std::set<BaseObject*> baseObjects_;
+    std::atomic<int32_t> maxBaseObjectId_;
+
+    static int32_t GetCurrentShardIndex();
+
+    void Link(BaseObject* o);
+#endif
 
     std::unique_ptr<FPS> fps_;
 
     std::shared_ptr<Configuration> config_;
 
-    int32_t maxBaseObjectId_;
-
 public:
 #if !USE_CBG
 
@@ -42,12 +58,15 @@ public:
     //! unregister a base object
     void Unregister(BaseObject* o);
 
+    //! makes o notified by OnTerminating even if baseObjects are not tracked
+    void RegisterTerminating(BaseObject* o);
+
 #endif
 
     //! get the number of base objects
     int32_t GetBaseObjectCount();
 
-    //! print all object's name
+    //! print all object's name (only if ALTSEED2_TRACK_BASE_OBJECTS)
     void PrintAllBaseObjectName();
 
     //! Initialize core and create a singleton
@@ -1,5 +1,7 @@
 #include "BatchRenderer.h"
 
+#include <cstring>
+
 #include "../Graphics/Graphics.h"
 #include "../Logger/Log.h"
 #include "BuiltinShader.h"
@@ -23,7 +25,8 @@ void BatchRenderer::Draw(
         int32_t ibCount,
         const std::shared_ptr<TextureBase>& texture,
         const std::shared_ptr<Material>& material,
-        const std::shared_ptr<MaterialPropertyBlock>& propBlock) {
+        const std::shared_ptr<MaterialPropertyBlock>& propBlock,
+        const Matrix44F* transform) {
     if (batches_.size() == 0 || batches_.back().texture != texture || batches_.back().material != material ||
         batches_.back().propBlock != propBlock) {
         Batch batch;
@@ -39,14 +42,25 @@ void BatchRenderer::Draw(
 
     auto& b = batches_.back();
 
-    auto current = rawVertexBuffer_.size();
+    const auto vbCurrent = rawVertexBuffer_.size();
+    rawVertexBuffer_.resize(vbCurrent + vbCount);
+    auto dstVB = rawVertexBuffer_.data() + vbCurrent;
+    if (vbCount > 0) {
+        std::memcpy(dstVB, vb, sizeof(BatchVertex) * vbCount);
+    }
 
-    for (int32_t i = 0; i < vbCount; i++) {
-        rawVertexBuffer_.emplace_back(vb[i]);
+    // NOTE: only positions are transformed so that UV1, UV2 and Col of the source are applied.
+    if (transform != nullptr) {
+        for (int32_t i = 0; i < vbCount; i++) {
+            dstVB[i].Pos = transform->Transform3D(dstVB[i].Pos);
+        }
     }
 
+    const auto ibCurrent = rawIndexBuffer_.size();
+    rawIndexBuffer_.resize(ibCurrent + ibCount);
+    auto dstIB = rawIndexBuffer_.data() + ibCurrent;
     for (int32_t i = 0; i < ibCount; i++) {
-        rawIndexBuffer_.emplace_back(ib[i] + b.VertexCount);
+        dstIB[i] = ib[i] + b.VertexCount;
     }
 
     b.VertexCount += vbCount;
@@ -204,4 +218,40 @@ std::shared_ptr<Material> BatchRenderer::GetMaterialDefaultText(const AlphaBlend
     return mat;
 }
 
+std::shared_ptr<Material> BatchRenderer::GetMaterialDefaultTextSDF(const AlphaBlend blend) {
+    auto mat = matDefaultTextSDF_[blend];
+
+    if (mat != nullptr) return mat;
+
+    auto vs = Graphics::GetInstance()->GetBuiltinShader()->Create(BuiltinShaderType::SpriteUnlitVS);
+    auto ps = Graphics::GetInstance()->GetBuiltinShader()->Create(BuiltinShaderType::FontSDFUnlitPS);
+
+    mat = MakeAsdShared<Material>();
+    mat->SetShader(vs);
+    mat->SetShader(ps);
+    mat->SetAlphaBlend(blend);
+    matDefaultTextSDF_[blend] = mat;
+
+    return mat;
+}
+
+std::shared_ptr<Material> BatchRenderer::GetMaterialDefaultTextMTSDF(const AlphaBlend blend) {
+    auto mat = matDefaultTextMTSDF_[blend];
+
+    if (mat != nullptr) return mat;
+
+    auto vs = Graphics::GetInstance()->GetBuiltinShader()->Create(BuiltinShaderType::SpriteUnlitVS);
+    auto ps = Graphics::GetInstance()->GetBuiltinShader()->Create(BuiltinShaderType::FontMTSDFUnlitPS);
+
+    mat = MakeAsdShared<Material>();
+    mat->SetShader(vs);
+    mat->SetShader(ps);
+    mat->SetAlphaBlend(blend);
+    mat->SetVector4F(u"outlineColor", Vector4F(0.0f, 0.0f, 0.0f, 0.0f));
+    mat->SetVector4F(u"outlineWidth", Vector4F(0.0f, 0.0f, 0.0f, 0.0f));
+    matDefaultTextMTSDF_[blend] = mat;
+
+    return mat;
+}
+
 }  // namespace Altseed2
\ No newline at end of file
@@ -52,6 +52,8 @@ private:
 
     std::unordered_map<AlphaBlend, std::shared_ptr<Material>, AlphaBlend::Hash> matDefaultSprite_;
     std::unordered_map<AlphaBlend, std::shared_ptr<Material>, AlphaBlend::Hash> matDefaultText_;
+    std::unordered_map<AlphaBlend, std::shared_ptr<Material>, AlphaBlend::Hash> matDefaultTextSDF_;
+    std::unordered_map<AlphaBlend, std::shared_ptr<Material>, AlphaBlend::Hash> matDefaultTextMTSDF_;
 
     std::shared_ptr<MaterialPropertyBlockCollection> matPropBlockCollection_;
     Matrix44F matView_;
@@ -66,18 +68,27 @@ public:
             int32_t ibCount,
             const std::shared_ptr<TextureBase>& texture,
             const std::shared_ptr<Material>& material,
-            const std::shared_ptr<MaterialPropertyBlock>& propBlock);
+            const std::shared_ptr<MaterialPropertyBlock>& propBlock,
+            const Matrix44F* transform = nullptr);
 
     void UploadBuffer();
     void Render();
     void ResetCache();
 
+    int32_t GetBatchCount() const { return static_cast<int32_t>(batches_.size()); }
+
     void SetViewProjectionWithWindowsSize(const Vector2I& windowSize);
 
     void SetViewProjection(const Matrix44F& matView, const Matrix44F& matProjection);
 
     std::shared_ptr<Material> GetMaterialDefaultSprite(const AlphaBlend blend);
     std::shared_ptr<Material> GetMaterialDefaultText(const AlphaBlend blend);
+
+    //! for font whose distance field is single channel
+    std::shared_ptr<Material> GetMaterialDefaultTextSDF(const AlphaBlend blend);
+
+    //! for font which has true distance in alpha. outlineColor and outlineWidth are read from the material
+    std::shared_ptr<Material> GetMaterialDefaultTextMTSDF(const AlphaBlend blend);
 };
 
 }  // namespace Altseed2
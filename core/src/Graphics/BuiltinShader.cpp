@@ -89,6 +89,80 @@ float4 main(PS_INPUT input) : SV_TARGET
 }
 )";
 
+// for single channel (R8) font texture
+const char* FontSDFUnlitPS = R"(
+Texture2D mainTex : register(t0);
+SamplerState mainSamp : register(s0);
+
+struct PS_INPUT
+{
+    float4  Position : SV_POSITION;
+    float4  Color    : COLOR0;
+    float2  UV1 : UV0;
+    float2  UV2 : UV1;
+};
+
+float4 main(PS_INPUT input) : SV_TARGET 
+{
+    float dist = mainTex.Sample(mainSamp, input.UV1).r - 0.5f;
+    float sigDist = fwidth(dist);
+    float opacity = smoothstep(-sigDist, sigDist, dist);
+
+    if (opacity <= 0.0) discard;
+
+    return float4(input.Color.rgb, opacity * input.Color.a);
+}
+)";
+
+// for MSDF + true SDF (RGBA8) font texture
+// the outline is drawn from the true distance in alpha, which stays correct far from the edge
+const char* FontMTSDFUnlitPS = R"(
+Texture2D mainTex : register(t0);
+SamplerState mainSamp : register(s0);
+
+struct PS_INPUT
+{
+    float4  Position : SV_POSITION;
+    float4  Color    : COLOR0;
+    float2  UV1 : UV0;
+    float2  UV2 : UV1;
+};
+
+cbuffer Consts : register(b1)
+{
+    // outline is disabled when alpha is 0
+    float4 outlineColor;
+    // x : width in distance field units (0 to 0.5), clipped at the glyph padding
+    float4 outlineWidth;
+};
+
+float median (float3 col)
+{
+    return max(min(col.r, col.g), min(max(col.r, col.g), col.b));
+}
+
+float4 main(PS_INPUT input) : SV_TARGET 
+{
+    float4 tex = mainTex.Sample(mainSamp, input.UV1);
+
+    float dist = median(tex.rgb) - 0.5f;
+    float sigDist = fwidth(dist);
+    float fillOpacity = smoothstep(-sigDist, sigDist, dist);
+
+    float outlineDist = tex.a - 0.5f + outlineWidth.x;
+    float outlineSigDist = fwidth(outlineDist);
+    float outlineOpacity = smoothstep(-outlineSigDist, outlineSigDist, outlineDist) * outlineColor.a;
+
+    float4 c;
+    c.rgb = lerp(outlineColor.rgb, input.Color.rgb, fillOpacity);
+    c.a = lerp(outlineOpacity, 1.0f, fillOpacity) * input.Color.a;
+
+    if (c.a <= 0.0) discard;
+
+    return c;
+}
+)";
+
 std::shared_ptr<Shader> BuiltinShader::Create(BuiltinShaderType type) {
     auto found = shaders_.find(type);
     if (found != shaders_.end()) return found->second;
@@ -105,6 +179,14 @@ std::shared_ptr<Shader> BuiltinShader::Create(BuiltinShaderType type) {
         auto shader = ShaderCompiler::GetInstance()->Compile("", "FontUnlitPS", FontUnlitPS, ShaderStageType::Pixel)->GetValue();
         shaders_[type] = shader;
         return shader;
+    } else if (type == BuiltinShaderType::FontSDFUnlitPS) {
+        auto shader = ShaderCompiler::GetInstance()->Compile("", "FontSDFUnlitPS", FontSDFUnlitPS, ShaderStageType::Pixel)->GetValue();
+        shaders_[type] = shader;
+        return shader;
+    } else if (type == BuiltinShaderType::FontMTSDFUnlitPS) {
+        auto shader = ShaderCompiler::GetInstance()->Compile("", "FontMTSDFUnlitPS", FontMTSDFUnlitPS, ShaderStageType::Pixel)->GetValue();
+        shaders_[type] = shader;
+        return shader;
     } else {
         LOG_CRITICAL(u"type is not found");
         assert(0);
@@ -19,6 +19,8 @@ enum class BuiltinShaderType : int32_t {
     SpriteUnlitVS,
     SpriteUnlitPS,
     FontUnlitPS,
+    FontSDFUnlitPS,
+    FontMTSDFUnlitPS,
 };
 
 class BuiltinShader : public BaseObject {
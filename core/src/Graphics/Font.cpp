@@ -1,5 +1,12 @@
 #include "Font.h"
 
+#include <ft2build.h>
+#include <harfbuzz/hb.h>
+#include <zlib.h>
+#include FT_FREETYPE_H
+#include FT_OUTLINE_H
+
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -9,6 +16,7 @@
 #include "../IO/File.h"
 #include "../Logger/Log.h"
 #include "../Platform/FileSystem.h"
+#include "../System/AsyncLoader.h"
 #include "Graphics.h"
 #include "ImageFont.h"
 
@@ -18,6 +26,89 @@
 
 namespace Altseed2 {
 
+namespace {
+
+// Layout of static font (version 2)
+//
+// [Header]
+// [GlyphRecord] * glyphCount        (sorted by character)
+// [KerningRecord] * kerningCount    (sorted by (first, second), only non-zero)
+// [PageRecord] * pageCount
+// [Page data]                       (RGBA8, deflated if compression is Deflate)
+//
+// All fields are 4 bytes, so tables can be read in place from a mapped file.
+
+constexpr int32_t StaticFontMagic = 0x32463241;  // "A2F2"
+constexpr int32_t StaticFontVersion = 2;
+
+enum class StaticFontPageCompression : int32_t {
+    None = 0,
+    Deflate = 1,
+};
+
+struct StaticFontHeader {
+    int32_t Magic;
+    int32_t Version;
+    int32_t SamplingSize;
+    float Ascent;
+    float Descent;
+    float LineGap;
+    float EmSize;
+    int32_t TextureSizeX;
+    int32_t TextureSizeY;
+    int32_t GlyphCount;
+    int32_t GlyphTableOffset;
+    int32_t KerningCount;
+    int32_t KerningTableOffset;
+    int32_t PageCount;
+    int32_t PageTableOffset;
+};
+
+struct StaticFontGlyphRecord {
+    int32_t Character;
+    int32_t TextureIndex;
+    int32_t PositionX;
+    int32_t PositionY;
+    int32_t SizeX;
+    int32_t SizeY;
+    float OffsetX;
+    float OffsetY;
+    float Advance;
+};
+
+struct StaticFontKerningRecord {
+    int32_t First;
+    int32_t Second;
+    int32_t Value;
+};
+
+struct StaticFontPageRecord {
+    int32_t Offset;
+    int32_t StoredSize;
+    int32_t RawSize;
+    int32_t Compression;
+};
+
+static_assert(sizeof(StaticFontHeader) == 15 * 4, "StaticFontHeader must not be padded");
+static_assert(sizeof(StaticFontGlyphRecord) == 9 * 4, "StaticFontGlyphRecord must not be padded");
+static_assert(sizeof(StaticFontKerningRecord) == 3 * 4, "StaticFontKerningRecord must not be padded");
+static_assert(sizeof(StaticFontPageRecord) == 4 * 4, "StaticFontPageRecord must not be padded");
+
+template <typename T>
+T ReadStaticFontRecord(const uint8_t* data, int32_t tableOffset, int32_t index) {
+    T record;
+    std::memcpy(&record, data + tableOffset + sizeof(T) * index, sizeof(T));
+    return record;
+}
+
+template <typename T>
+void WriteStaticFontRecord(std::vector<uint8_t>& buffer, const T& record) {
+    const auto begin = reinterpret_cast<const uint8_t*>(&record);
+    buffer.insert(buffer.end(), begin, begin + sizeof(T));
+}
+
+}  // namespace
+
 Glyph::Glyph()
     : textureSize_(Vector2I(0, 0)), textureIndex_(0), position_(Vector2I(0, 0)), size_(Vector2I(0, 0)), offset_(Vector2F(0, 0)), advance_(0.0f) {}
 Glyph::Glyph(Vector2I textureSize, int32_t textureIndex, Vector2I position, Vector2I size, Vector2F offset, float advance)
@@ -25,9 +116,11 @@ Glyph::Glyph(Vector2I textureSize, int32_t textureIndex, Vector2I position, Vect
 
 std::mutex Font::mtx;
 std::shared_ptr<msdfgen::FreetypeHandle> Font::freetypeHandle_;
+std::shared_ptr<FT_LibraryRec_> Font::ftLibrary_;
 
 Font::Font(std::u16string path)
     : resources_(nullptr),
+      fileDataSize_(0),
       fontHandle_(nullptr),
       ascent_(0),
       descent_(0),
@@ -36,21 +129,45 @@ Font::Font(std::u16string path)
       file_(nullptr),
       textureSize_(Vector2I(Font::TextureSize, Font::TextureSize)),
       sourcePath_(path),
-      isStaticFont_(true) {}
+      isStaticFont_(true),
+      distanceFieldType_(FontDistanceFieldType::MSDF),
+      pxRange_(PxRangeDefault),
+      hbScale_(0.0f),
+      isShapingInitialized_(false),
+      staticFontVersion_(0),
+      glyphTableOffset_(0),
+      glyphCount_(0),
+      kerningTableOffset_(0),
+      kerningCount_(0),
+      pageTableOffset_(0) {}
 
 Font::Font(
         std::shared_ptr<Resources>& resources,
         std::shared_ptr<StaticFile>& file,
         std::shared_ptr<msdfgen::FontHandle> fontHandle,
         int32_t samplingSize,
-        std::u16string path)
+        std::u16string path,
+        FontDistanceFieldType distanceFieldType,
+        float pxRange)
     : resources_(resources),
+      fileData_(file->GetDataOwner()),
+      fileDataSize_(file->GetSize()),
       fontHandle_(fontHandle),
       samplingSize_(samplingSize),
       file_(file),
       textureSize_(Vector2I(Font::TextureSize, Font::TextureSize)),
       sourcePath_(path),
-      isStaticFont_(false) {
+      isStaticFont_(false),
+      distanceFieldType_(distanceFieldType),
+      pxRange_(pxRange),
+      hbScale_(0.0f),
+      isShapingInitialized_(false),
+      staticFontVersion_(0),
+      glyphTableOffset_(0),
+      glyphCount_(0),
+      kerningTableOffset_(0),
+      kerningCount_(0),
+      pageTableOffset_(0) {
     msdfgen::FontMetrics metrics;
     msdfgen::getFontMetrics(metrics, fontHandle.get());
     ascent_ = static_cast<float>(metrics.ascenderY);
@@ -60,16 +177,13 @@ Font::Font(
 
     Log::GetInstance()->Info(LogCategory::Core, u"Font::Font: enSize={0}, ascent={1}, descent={2}, lineGap={3}", emSize_, ascent_, descent_, lineGap_);
 
-    AddFontTexture();
-
     SetInstanceName(__FILE__);
 }
 
 Font::~Font() {
-    std::lock_guard<std::mutex> lock(mtx);
     if (resources_ != nullptr && sourcePath_ != u"") {
         resources_->GetResourceContainer(ResourceType::Font)
-                ->Unregister(isStaticFont_ ? sourcePath_ : Font::GetKeyName(sourcePath_.c_str(), samplingSize_));
+                ->Unregister(isStaticFont_ ? sourcePath_ : Font::GetKeyName(sourcePath_.c_str(), samplingSize_, distanceFieldType_, pxRange_), this);
         resources_ = nullptr;
     }
 }
@@ -84,51 +198,255 @@ bool Font::Initialize() {
         return false;
     }
 
+    FT_Library library = nullptr;
+    if (FT_Init_FreeType(&library) != 0) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Font::Initialize: failed to initialize freetype");
+        return false;
+    }
+    ftLibrary_ = std::shared_ptr<FT_LibraryRec_>(library, FT_Done_FreeType);
+
     return true;
 }
 
 void Font::Terminate() {
+    // faces keep the library until they are destroyed
+    ftLibrary_ = nullptr;
 }
 
 std::shared_ptr<Glyph> Font::GetGlyph(const int32_t character) {
     if (glyphs_.count(character)) {
         return glyphs_[character];
     } else if (GetIsStaticFont()) {
+        if (staticFontVersion_ == StaticFontVersion) {
+            auto glyph = FindStaticGlyph(character);
+            if (glyph != nullptr) {
+                glyphs_[character] = glyph;
+                return glyph;
+            }
+        }
+
         std::string tmp;
         tmp += (char32_t)character;
         Log::GetInstance()->Warn(LogCategory::Core, u"Glyph for '{0}' character not found", tmp.c_str());
 
-        return glyphs_[u'\0'];
+        // the fallback is cached for the character, so that the warning is written once for each character
+        std::shared_ptr<Glyph> fallback;
+        if (character != u'\0') fallback = GetGlyph(u'\0');
+        glyphs_[character] = fallback;
+        return fallback;
     }
 
     AddGlyph(character);
     return glyphs_[character];
 }
 
+std::shared_ptr<Texture2D> Font::GetFontTexture(int32_t index) {
+    if (index < 0 || index >= textures_.size()) return nullptr;
+    if (textures_[index] == nullptr && staticFontVersion_ == StaticFontVersion) {
+        textures_[index] = LoadStaticFontTexture(index);
+    }
+    return textures_[index];
+}
+
 int32_t Font::GetKerning(const int32_t c1, const int32_t c2) {
     if (GetIsStaticFont()) {
-        if (kernings_.count(std::make_pair(c1, c2)) != 0)
-            return kernings_[std::make_pair(c1, c2)];
-        else
+        const auto key = std::make_pair(c1, c2);
+
+        if (staticFontVersion_ == StaticFontVersion) {
+            const auto data = static_cast<const uint8_t*>(fileData_.get());
+            int32_t lower = 0;
+            int32_t upper = kerningCount_;
+            while (lower < upper) {
+                const auto middle = lower + (upper - lower) / 2;
+                const auto record = ReadStaticFontRecord<StaticFontKerningRecord>(data, kerningTableOffset_, middle);
+                const auto current = std::make_pair(record.First, record.Second);
+                if (current == key) return record.Value;
+                if (current < key) {
+                    lower = middle + 1;
+                } else {
+                    upper = middle;
+                }
+            }
             return 0;
+        }
+
+        const auto it = std::lower_bound(kernings_.begin(), kernings_.end(), key, [](const KerningPair& pair, const std::pair<int32_t, int32_t>& k) {
+            return std::make_pair(pair.First, pair.Second) < k;
+        });
+        if (it != kernings_.end() && it->First == c1 && it->Second == c2) return it->Value;
+        return 0;
     }
 
+    // the key of an empty entry is never made from characters
+    constexpr auto emptyKey = ~static_cast<uint64_t>(0);
+    if (kerningCache_.empty()) kerningCache_.resize(KerningCacheSize, KerningCacheEntry{emptyKey, 0});
+
+    const auto key = (static_cast<uint64_t>(static_cast<uint32_t>(c1)) << 32) | static_cast<uint32_t>(c2);
+
+    // Fibonacci hashing, a colliding pair overwrites the entry
+    auto& entry = kerningCache_[(key * 0x9E3779B97F4A7C15ULL) >> (64 - 10)];
+    static_assert(KerningCacheSize == 1 << 10, "the shift must match KerningCacheSize");
+    if (entry.Key == key) return entry.Value;
+
+    // 失敗した組も 0 として記録し、freetype への問い合わせとログを繰り返さない
+    int32_t result = 0;
     double kern;
-    if (!msdfgen::getKerning(kern, fontHandle_.get(), c1, c2)) {
+    if (msdfgen::getKerning(kern, fontHandle_.get(), c1, c2)) {
+        result = (float)kern;
+    } else {
         Log::GetInstance()->Error(LogCategory::Core, u"Font::GetKerning: failed to get kerning");
-        return 0;
     }
 
-    return (float)kern;
+    entry = KerningCacheEntry{key, result};
+    return result;
+}
+
+bool Font::InitializeShaping() {
+    if (isShapingInitialized_) return hbFont_ != nullptr;
+    isShapingInitialized_ = true;
+
+    if (GetIsStaticFont() || file_ == nullptr) return false;
+
+    // fileData_ is kept by this font, so harfbuzz refers to it without copy
+    auto blob = hb_blob_create(static_cast<const char*>(fileData_.get()), static_cast<unsigned int>(fileDataSize_), HB_MEMORY_MODE_READONLY, nullptr, nullptr);
+    auto face = hb_face_create(blob, 0);
+    hb_blob_destroy(blob);
+
+    const auto upem = hb_face_get_upem(face);
+    if (upem == 0) {
+        hb_face_destroy(face);
+        Log::GetInstance()->Warn(LogCategory::Core, u"Font::InitializeShaping: failed to read face of '{0}'", utf16_to_utf8(sourcePath_).c_str());
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+
+        FT_Face ftFace = nullptr;
+        if (ftLibrary_ == nullptr ||
+            FT_New_Memory_Face(ftLibrary_.get(), static_cast<const FT_Byte*>(fileData_.get()), static_cast<FT_Long>(fileDataSize_), 0, &ftFace) != 0) {
+            hb_face_destroy(face);
+            Log::GetInstance()->Warn(LogCategory::Core, u"Font::InitializeShaping: failed to load face of '{0}'", utf16_to_utf8(sourcePath_).c_str());
+            return false;
+        }
+
+        auto library = ftLibrary_;
+        ftFace_ = std::shared_ptr<FT_FaceRec_>(ftFace, [library](FT_Face f) {
+            std::lock_guard<std::mutex> lock(mtx);
+            FT_Done_Face(f);
+        });
+    }
+
+    hbFont_ = std::shared_ptr<hb_font_t>(hb_font_create(face), hb_font_destroy);
+    hb_face_destroy(face);
+    hb_font_set_scale(hbFont_.get(), upem, upem);
+
+    hbBuffer_ = std::shared_ptr<hb_buffer_t>(hb_buffer_create(), hb_buffer_destroy);
+
+    // harfbuzz の単位 (upem) から msdfgen の単位へ
+    hbScale_ = emSize_ / upem;
+
+    return true;
+}
+
+std::shared_ptr<const std::vector<ShapedGlyph>> Font::Shape(const std::u16string& text, bool isKerningEnabled) {
+    EASY_BLOCK("Altseed2(C++).Font.Shape");
+
+    if (!InitializeShaping()) return nullptr;
+
+    auto& cache = shapedRuns_[isKerningEnabled ? 1 : 0];
+
+    const auto it = cache.Index.find(std::u16string_view(text));
+    if (it != cache.Index.end()) {
+        cache.Runs.splice(cache.Runs.begin(), cache.Runs, it->second);
+        return it->second->second;
+    }
+
+    const auto buffer = hbBuffer_.get();
+    hb_buffer_clear_contents(buffer);
+    hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
+    hb_buffer_add_utf16(buffer, reinterpret_cast<const uint16_t*>(text.data()), static_cast<int>(text.size()), 0, static_cast<int>(text.size()));
+    hb_buffer_guess_segment_properties(buffer);
+
+    hb_feature_t kern;
+    kern.tag = HB_TAG('k', 'e', 'r', 'n');
+    kern.value = isKerningEnabled ? 1 : 0;
+    kern.start = HB_FEATURE_GLOBAL_START;
+    kern.end = HB_FEATURE_GLOBAL_END;
+
+    hb_shape(hbFont_.get(), buffer, &kern, 1);
+
+    uint32_t count = 0;
+    const auto infos = hb_buffer_get_glyph_infos(buffer, &count);
+    const auto positions = hb_buffer_get_glyph_positions(buffer, &count);
+
+    auto result = std::make_shared<std::vector<ShapedGlyph>>();
+    result->reserve(count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const auto cluster = infos[i].cluster;
+
+        char32_t character = 0;
+        ConvChU16ToU32({text[cluster], cluster + 1 < text.size() ? text[cluster + 1] : u'\0'}, character);
+
+        // after shaping, codepoint is the glyph id
+        const auto& pos = positions[i];
+        result->push_back(ShapedGlyph{
+                static_cast<int32_t>(infos[i].codepoint),
+                static_cast<int32_t>(character),
+                pos.x_advance * hbScale_,
+                pos.x_offset * hbScale_,
+                -pos.y_offset * hbScale_});
+    }
+
+    if (static_cast<int32_t>(cache.Runs.size()) >= ShapedRunCacheMax) {
+        cache.Index.erase(std::u16string_view(cache.Runs.back().first));
+        cache.Runs.pop_back();
+    }
+
+    cache.Runs.emplace_front(text, result);
+    cache.Index.emplace(std::u16string_view(cache.Runs.front().first), cache.Runs.begin());
+
+    return result;
+}
+
+std::shared_ptr<Glyph> Font::GetGlyphByIndex(const int32_t glyphIndex) {
+    if (!InitializeShaping()) return nullptr;
+
+    const auto it = glyphsByIndex_.find(glyphIndex);
+    if (it != glyphsByIndex_.end()) return it->second;
+
+    double advance = 0.0;
+    msdfgen::Shape shape;
+
+    std::shared_ptr<Glyph> glyph;
+    if (LoadGlyphShape(shape, static_cast<uint32_t>(glyphIndex), advance)) {
+        glyph = CreateGlyph(shape, advance);
+    } else {
+        Log::GetInstance()->Error(LogCategory::Core, u"Font::GetGlyphByIndex: failed to load glyph '{0}'", glyphIndex);
+        glyph = GetGlyph(u'\0');
+    }
+
+    glyphsByIndex_[glyphIndex] = glyph;
+    return glyph;
 }
 
 const char16_t* Font::GetPath() const { return sourcePath_.c_str(); }
 
 std::shared_ptr<Font> Font::LoadDynamicFont(const char16_t* path, int32_t samplingSize) {
+    return LoadDynamicFont(path, samplingSize, FontDistanceFieldType::MSDF, PxRangeDefault);
+}
+
+std::shared_ptr<Font> Font::LoadDynamicFont(const char16_t* path, int32_t samplingSize, FontDistanceFieldType distanceFieldType, float pxRange) {
     EASY_BLOCK("Altseed2(C++).Font.LoadDynamicFont");
 
     RETURN_IF_NULL(path, nullptr);
 
+    if (pxRange <= 0.0f) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Font::LoadDynamicFont: pxRange must be positive");
+        return nullptr;
+    }
+
     const auto normalizedPath = FileSystem::NormalizePath(path);
 
     auto resources = Resources::GetInstance();
@@ -137,41 +455,127 @@ std::shared_ptr<Font> Font::LoadDynamicFont(const char16_t* path, int32_t sampli
         return nullptr;
     }
 
-    const auto resourceKeyName = Font::GetKeyName(normalizedPath.c_str(), samplingSize);
+    const auto resourceKeyName = Font::GetKeyName(normalizedPath.c_str(), samplingSize, distanceFieldType, pxRange);
 
-    std::shared_ptr<Font> result = nullptr;
+    std::shared_ptr<Font> result = std::dynamic_pointer_cast<Font>(resources->GetResourceContainer(ResourceType::Font)->Get(resourceKeyName));
+    if (result != nullptr && !result->GetIsStaticFont()) {
+        return result;
+    }
 
-    {
-        std::lock_guard<std::mutex> lock(mtx);
+    auto file = StaticFile::Create(normalizedPath.c_str());
+    if (file == nullptr) {
+        Log::GetInstance()->Error(
+                LogCategory::Core, u"Font::LoadDynamicFont: Failed to create file from '{0}'", utf16_to_utf8(normalizedPath).c_str());
+        return nullptr;
+    }
+
+    result = CreateDynamicFont(resources, file, samplingSize, normalizedPath, distanceFieldType, pxRange);
+    if (result == nullptr) return nullptr;
+
+    return RegisterDynamicFont(result);
+}
+
+std::shared_ptr<Font> Font::CreateDynamicFont(
+        std::shared_ptr<Resources>& resources,
+        std::shared_ptr<StaticFile>& file,
+        int32_t samplingSize,
+        const std::u16string& normalizedPath,
+        FontDistanceFieldType distanceFieldType,
+        float pxRange) {
+    // the file may be reloaded meanwhile, so the face and the font refer to the same data
+    const auto data = file->GetDataOwner();
+    const int64_t size = file->GetSize();
+    auto fontHandle = LoadFontHandle(data, size);
+
+    if (fontHandle == nullptr) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Font::LoadDynamicFont: Failed to initialize font '{0}'", utf16_to_utf8(normalizedPath).c_str());
+        return nullptr;
+    }
+
+    auto font = MakeAsdShared<Font>(resources, file, fontHandle, samplingSize, normalizedPath, distanceFieldType, pxRange);
+    font->fileData_ = data;
+    font->fileDataSize_ = size;
+    return font;
+}
 
-        result = std::dynamic_pointer_cast<Font>(
-                resources->GetResourceContainer(ResourceType::Font)->Get(resourceKeyName));
-        if (result != nullptr && result->GetRef() > 0 && !result->GetIsStaticFont()) {
-            return result;
+std::shared_ptr<msdfgen::FontHandle> Font::LoadFontHandle(const std::shared_ptr<const void>& data, int64_t size) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return std::shared_ptr<msdfgen::FontHandle>(
+            msdfgen::loadFontMemory(Font::freetypeHandle_.get(), (unsigned char*)data.get(), static_cast<int>(size)),
+            msdfgen::destroyFont);
+}
+
+std::shared_ptr<Font> Font::RegisterDynamicFont(std::shared_ptr<Font>& font) {
+    // the first texture is created before the font can be found in the container
+    font->AddFontTexture();
+
+    // the same font may have been loaded by another thread meanwhile
+    const auto resourceKeyName = Font::GetKeyName(font->sourcePath_.c_str(), font->samplingSize_, font->distanceFieldType_, font->pxRange_);
+    auto registered = std::dynamic_pointer_cast<Font>(font->resources_->GetResourceContainer(ResourceType::Font)
+                                                              ->GetOrRegister(resourceKeyName, std::make_shared<ResourceContainer::ResourceInfomation>(font, font->sourcePath_)));
+    if (registered != font) {
+        font->resources_ = nullptr;
+        return registered;
+    }
+
+    font->AddGlyph('\0');
+
+    return font;
+}
+
+std::shared_future<std::shared_ptr<Font>> Font::LoadDynamicFontAsync(
+        const char16_t* path, int32_t samplingSize, FontDistanceFieldType distanceFieldType, float pxRange) {
+    RETURN_IF_NULL(path, AsyncLoader::MakeReadyFuture<Font>(nullptr));
+
+    auto loader = AsyncLoader::GetInstance();
+    if (loader == nullptr) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Font::LoadDynamicFontAsync: Core is not initialized.");
+        return AsyncLoader::MakeReadyFuture<Font>(nullptr);
+    }
+
+    if (pxRange <= 0.0f) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Font::LoadDynamicFontAsync: pxRange must be positive");
+        return AsyncLoader::MakeReadyFuture<Font>(nullptr);
+    }
+
+    auto promise = std::make_shared<std::promise<std::shared_ptr<Font>>>();
+    auto future = promise->get_future().share();
+    const auto normalizedPath = FileSystem::NormalizePath(path);
+
+    loader->PostIO([promise, normalizedPath, samplingSize, distanceFieldType, pxRange]() -> void {
+        auto resources = Resources::GetInstance();
+        if (resources == nullptr) {
+            Log::GetInstance()->Error(LogCategory::Core, u"File is not initialized.");
+            promise->set_value(nullptr);
+            return;
+        }
+
+        const auto resourceKeyName = Font::GetKeyName(normalizedPath.c_str(), samplingSize, distanceFieldType, pxRange);
+        auto cache = std::dynamic_pointer_cast<Font>(resources->GetResourceContainer(ResourceType::Font)->Get(resourceKeyName));
+        if (cache != nullptr && !cache->GetIsStaticFont()) {
+            promise->set_value(cache);
+            return;
         }
 
         auto file = StaticFile::Create(normalizedPath.c_str());
         if (file == nullptr) {
             Log::GetInstance()->Error(
-                    LogCategory::Core, u"Font::LoadDynamicFont: Failed to create file from '{0}'", utf16_to_utf8(normalizedPath).c_str());
-            return nullptr;
+                    LogCategory::Core, u"Font::LoadDynamicFontAsync: Failed to create file from '{0}'", utf16_to_utf8(normalizedPath).c_str());
+            promise->set_value(nullptr);
+            return;
         }
 
-        std::shared_ptr<msdfgen::FontHandle> fontHandle(msdfgen::loadFontMemory(Font::freetypeHandle_.get(), (unsigned char*)file->GetData(), file->GetSize()), msdfgen::destroyFont);
-
-        if (fontHandle == nullptr) {
-            Log::GetInstance()->Error(LogCategory::Core, u"Font::LoadDynamicFont: Failed to initialize font '{0}'", utf16_to_utf8(normalizedPath).c_str());
-            return nullptr;
+        // the font is parsed here, and only textures are created on the main thread
+        auto font = CreateDynamicFont(resources, file, samplingSize, normalizedPath, distanceFieldType, pxRange);
+        if (font == nullptr) {
+            promise->set_value(nullptr);
+            return;
         }
 
-        result = MakeAsdShared<Font>(resources, file, fontHandle, samplingSize, normalizedPath);
-        resources->GetResourceContainer(ResourceType::Font)
-                ->Register(resourceKeyName, std::make_shared<ResourceContainer::ResourceInfomation>(result, normalizedPath));
-    }
-
-    result->AddGlyph('\0');
+        AsyncLoader::GetInstance()->PostMain([promise, font]() mutable -> void { promise->set_value(RegisterDynamicFont(font)); });
+    });
 
-    return result;
+    return future;
 }
 
 std::shared_ptr<Font> Font::LoadStaticFont(const char16_t* path) {
@@ -180,7 +584,6 @@ std::shared_ptr<Font> Font::LoadStaticFont(const char16_t* path) {
     RETURN_IF_NULL(path, nullptr);
 
     const auto normalizedPath = FileSystem::NormalizePath(path);
-    const auto rawFilename = FileSystem::GetFileName(normalizedPath, false);
 
     auto resources = Resources::GetInstance();
     if (resources == nullptr) {
@@ -188,21 +591,37 @@ std::shared_ptr<Font> Font::LoadStaticFont(const char16_t* path) {
         return nullptr;
     }
 
-    std::lock_guard<std::mutex> lock(mtx);
-
     auto cache = std::dynamic_pointer_cast<Font>(resources->GetResourceContainer(ResourceType::Font)->Get(normalizedPath));
-    if (cache != nullptr && cache->GetRef() > 0 && cache->GetIsStaticFont()) {
+    if (cache != nullptr && cache->GetIsStaticFont()) {
         return cache;
     }
 
     auto file = StaticFile::Create(normalizedPath.c_str());
     if (file == nullptr) return nullptr;
 
-    BinaryReader reader(file);
-
     auto font = MakeAsdShared<Font>(normalizedPath);
     font->resources_ = resources;
     font->file_ = file;
+    font->fileData_ = file->GetDataOwner();
+    font->fileDataSize_ = file->GetSize();
+
+    int32_t magic = 0;
+    if (file->GetSize() >= sizeof(int32_t)) {
+        std::memcpy(&magic, file->GetData(), sizeof(int32_t));
+    }
+
+    if (magic == StaticFontMagic) {
+        return LoadStaticFontV2(font, file);
+    }
+
+    return LoadStaticFontV1(font, file, normalizedPath);
+}
+
+std::shared_ptr<Font> Font::LoadStaticFontV1(std::shared_ptr<Font>& font, std::shared_ptr<StaticFile>& file, const std::u16string& normalizedPath) {
+    const auto rawFilename = FileSystem::GetFileName(normalizedPath, false);
+
+    BinaryReader reader(file);
+
     reader.Get(&font->samplingSize_);
     reader.Get(&font->ascent_);
     reader.Get(&font->descent_);
@@ -226,19 +645,142 @@ std::shared_ptr<Font> Font::LoadStaticFont(const char16_t* path) {
         font->glyphs_[character] = glyph;
 
         for (size_t l = 0; l < glyphCount; l++) {
-            font->kernings_[std::make_pair(reader.Get<int32_t>(), reader.Get<int32_t>())] = reader.Get<int32_t>();
+            KerningPair pair;
+            pair.First = reader.Get<int32_t>();
+            pair.Second = reader.Get<int32_t>();
+            pair.Value = reader.Get<int32_t>();
+            if (pair.Value != 0) font->kernings_.push_back(pair);
         }
     }
 
+    std::sort(font->kernings_.begin(), font->kernings_.end(), [](const KerningPair& a, const KerningPair& b) {
+        return std::make_pair(a.First, a.Second) < std::make_pair(b.First, b.Second);
+    });
+
+    font->staticFontVersion_ = 1;
+
     return font;
 }
 
+std::shared_ptr<Font> Font::LoadStaticFontV2(std::shared_ptr<Font>& font, std::shared_ptr<StaticFile>& file) {
+    const auto data = static_cast<const uint8_t*>(file->GetData());
+    const int64_t size = file->GetSize();
+
+    if (size < sizeof(StaticFontHeader)) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Font::LoadStaticFont: Header is broken");
+        return nullptr;
+    }
+
+    StaticFontHeader header;
+    std::memcpy(&header, data, sizeof(StaticFontHeader));
+
+    if (header.Version != StaticFontVersion) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Font::LoadStaticFont: Unsupported version {0}", header.Version);
+        return nullptr;
+    }
+
+    const auto isInFile = [size](int32_t offset, int32_t count, size_t recordSize) {
+        return 0 <= offset && 0 <= count && offset + static_cast<int64_t>(count) * recordSize <= size;
+    };
+
+    if (!isInFile(header.GlyphTableOffset, header.GlyphCount, sizeof(StaticFontGlyphRecord)) ||
+        !isInFile(header.KerningTableOffset, header.KerningCount, sizeof(StaticFontKerningRecord)) ||
+        !isInFile(header.PageTableOffset, header.PageCount, sizeof(StaticFontPageRecord))) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Font::LoadStaticFont: Table is out of range");
+        return nullptr;
+    }
+
+    font->samplingSize_ = header.SamplingSize;
+    font->ascent_ = header.Ascent;
+    font->descent_ = header.Descent;
+    font->lineGap_ = header.LineGap;
+    font->emSize_ = header.EmSize;
+    font->textureSize_ = Vector2I(header.TextureSizeX, header.TextureSizeY);
+
+    font->staticFontVersion_ = StaticFontVersion;
+    font->glyphTableOffset_ = header.GlyphTableOffset;
+    font->glyphCount_ = header.GlyphCount;
+    font->kerningTableOffset_ = header.KerningTableOffset;
+    font->kerningCount_ = header.KerningCount;
+    font->pageTableOffset_ = header.PageTableOffset;
+
+    // textures are loaded when they are required
+    font->textures_.resize(header.PageCount);
+
+    return font;
+}
+
+std::shared_ptr<Glyph> Font::FindStaticGlyph(const int32_t character) {
+    const auto data = static_cast<const uint8_t*>(fileData_.get());
+
+    int32_t lower = 0;
+    int32_t upper = glyphCount_;
+    while (lower < upper) {
+        const auto middle = lower + (upper - lower) / 2;
+        const auto record = ReadStaticFontRecord<StaticFontGlyphRecord>(data, glyphTableOffset_, middle);
+        if (record.Character == character) {
+            return MakeAsdShared<Glyph>(
+                    textureSize_,
+                    record.TextureIndex,
+                    Vector2I(record.PositionX, record.PositionY),
+                    Vector2I(record.SizeX, record.SizeY),
+                    Vector2F(record.OffsetX, record.OffsetY),
+                    record.Advance);
+        }
+
+        if (record.Character < character) {
+            lower = middle + 1;
+        } else {
+            upper = middle;
+        }
+    }
+
+    return nullptr;
+}
+
+std::shared_ptr<Texture2D> Font::LoadStaticFontTexture(int32_t index) {
+    const auto data = static_cast<const uint8_t*>(fileData_.get());
+    const auto page = ReadStaticFontRecord<StaticFontPageRecord>(data, pageTableOffset_, index);
+
+    const int64_t expectedSize = static_cast<int64_t>(textureSize_.X) * textureSize_.Y * 4;
+    if (page.RawSize != expectedSize || page.Offset < 0 || page.StoredSize < 0 || page.Offset + static_cast<int64_t>(page.StoredSize) > fileDataSize_) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Font::LoadStaticFontTexture: Texture{0} is broken", index);
+        return nullptr;
+    }
+
+    std::vector<uint8_t> pixels;
+    const uint8_t* src = data + page.Offset;
+
+    if (page.Compression == static_cast<int32_t>(StaticFontPageCompression::Deflate)) {
+        pixels.resize(page.RawSize);
+        uLongf rawSize = static_cast<uLongf>(page.RawSize);
+        if (uncompress(pixels.data(), &rawSize, src, static_cast<uLong>(page.StoredSize)) != Z_OK || rawSize != page.RawSize) {
+            Log::GetInstance()->Error(LogCategory::Core, u"Font::LoadStaticFontTexture: Failed to decompress Texture{0}", index);
+            return nullptr;
+        }
+        src = pixels.data();
+    } else if (page.Compression != static_cast<int32_t>(StaticFontPageCompression::None) || page.StoredSize != page.RawSize) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Font::LoadStaticFontTexture: Texture{0} is broken", index);
+        return nullptr;
+    }
+
+    auto llgiTexture = Graphics::GetInstance()->CreateTexture(const_cast<uint8_t*>(src), textureSize_.X, textureSize_.Y, 4);
+    if (llgiTexture == nullptr) return nullptr;
+
+    return MakeAsdShared<Texture2D>(Resources::GetInstance(), llgiTexture, u"");
+}
+
 std::shared_ptr<Font> Font::CreateImageFont(std::shared_ptr<Font> baseFont) {
     RETURN_IF_NULL(baseFont, nullptr);
     return std::static_pointer_cast<Font>(MakeAsdShared<ImageFont>(baseFont));
 }
 
 bool Font::GenerateFontFile(const char16_t* dynamicFontPath, const char16_t* staticFontPath, int32_t samplingSize, const char16_t* characters) {
+    return GenerateFontFile(dynamicFontPath, staticFontPath, samplingSize, characters, true);
+}
+
+bool Font::GenerateFontFile(
+        const char16_t* dynamicFontPath, const char16_t* staticFontPath, int32_t samplingSize, const char16_t* characters, bool isTextureCompressed) {
     EASY_BLOCK("Altseed2(C++).Font.GenerateFontFile");
 
     RETURN_IF_NULL(dynamicFontPath, false);
@@ -247,14 +789,12 @@ bool Font::GenerateFontFile(const char16_t* dynamicFontPath, const char16_t* sta
 
     const auto nDynamicFontPath = FileSystem::NormalizePath(dynamicFontPath);
     const auto nStaticFontPath = FileSystem::NormalizePath(staticFontPath);
-    const auto staticFontRawFilename = FileSystem::GetFileName(nStaticFontPath, false);
 
     auto parentDir = FileSystem::GetParentPath(FileSystem::GetAbusolutePath(nStaticFontPath));
     if (!FileSystem::GetIsDirectory(parentDir)) {
         Log::GetInstance()->Error(LogCategory::Core, u"Font::GenerateFontFile: The output directory cannot be accessed.");
         return false;
     }
-    BinaryWriter writer;
 
     auto font = Font::LoadDynamicFont(nDynamicFontPath.c_str(), samplingSize);
     if (font == nullptr) {
@@ -262,13 +802,6 @@ bool Font::GenerateFontFile(const char16_t* dynamicFontPath, const char16_t* sta
         return false;
     }
 
-    writer.Push(font->samplingSize_);
-    writer.Push(font->ascent_);
-    writer.Push(font->descent_);
-    writer.Push(font->lineGap_);
-    writer.Push(font->emSize_);
-    writer.Push(font->textureSize_);
-
     // add characters
     std::u16string addCharacters(characters);
     addCharacters += u'\0';
@@ -288,33 +821,104 @@ bool Font::GenerateFontFile(const char16_t* dynamicFontPath, const char16_t* sta
         glyphs[character] = font->GetGlyph(character);
     }
 
-    // add glyph data
-    writer.Push((int32_t)font->textures_.size());
-    writer.Push((int32_t)glyphs.size());
-    for (auto glyph : glyphs) {
-        writer.Push(glyph.first);
-        writer.Push(glyph.second == nullptr);
+    // glyph table (std::map is sorted by character)
+    std::vector<uint8_t> glyphTable;
+    for (const auto& glyph : glyphs) {
         if (glyph.second == nullptr) continue;
-        writer.Push(glyph.second);
-        for (auto glyph2 : glyphs) {
-            writer.Push(glyph.first);
-            writer.Push(glyph2.first);
-            writer.Push(font->GetKerning(glyph.first, glyph2.first));
+
+        StaticFontGlyphRecord record;
+        record.Character = glyph.first;
+        record.TextureIndex = glyph.second->GetTextureIndex();
+        record.PositionX = glyph.second->GetPosition().X;
+        record.PositionY = glyph.second->GetPosition().Y;
+        record.SizeX = glyph.second->GetSize().X;
+        record.SizeY = glyph.second->GetSize().Y;
+        record.OffsetX = glyph.second->GetOffset().X;
+        record.OffsetY = glyph.second->GetOffset().Y;
+        record.Advance = glyph.second->GetAdvance();
+        WriteStaticFontRecord(glyphTable, record);
+    }
+
+    // kerning table (only non-zero pairs, sorted by (first, second))
+    std::vector<uint8_t> kerningTable;
+    int32_t kerningCount = 0;
+    for (const auto& glyph : glyphs) {
+        if (glyph.second == nullptr) continue;
+        for (const auto& glyph2 : glyphs) {
+            if (glyph2.second == nullptr) continue;
+            const auto kerning = font->GetKerning(glyph.first, glyph2.first);
+            if (kerning == 0) continue;
+
+            StaticFontKerningRecord record;
+            record.First = glyph.first;
+            record.Second = glyph2.first;
+            record.Value = kerning;
+            WriteStaticFontRecord(kerningTable, record);
+            kerningCount++;
         }
     }
 
-    // save font textures
-    const auto parentPath = FileSystem::GetParentPath(nStaticFontPath);
-    auto textureDir = parentPath + (parentPath.size() == 0 ? u"" : u"/") + staticFontRawFilename;
-    if (!FileSystem::GetIsDirectory(textureDir.c_str())) {
-        if (!FileSystem::CreateDirectory(textureDir.c_str())) {
-            Log::GetInstance()->Error(LogCategory::Core, u"Font::GenerateFontFile: Failed to create directory: {0}", utf16_to_utf8(textureDir));
-            return false;
+    // font textures
+    const auto pageCount = static_cast<int32_t>(font->textures_.size());
+    const auto rawPageSize = static_cast<size_t>(font->textureSize_.X) * font->textureSize_.Y * 4;
+    std::vector<std::vector<uint8_t>> pages(pageCount);
+    std::vector<StaticFontPageCompression> compressions(pageCount, StaticFontPageCompression::None);
+    for (int32_t i = 0; i < pageCount; i++) {
+        std::vector<uint8_t> raw(rawPageSize);
+        {
+            auto& llgiTexture = font->textures_[i]->GetNativeTexture();
+            auto buf = static_cast<const uint8_t*>(llgiTexture->Lock());
+            std::memcpy(raw.data(), buf, rawPageSize);
+            llgiTexture->Unlock();
         }
+
+        if (isTextureCompressed) {
+            std::vector<uint8_t> compressed(compressBound(static_cast<uLong>(rawPageSize)));
+            uLongf compressedSize = static_cast<uLongf>(compressed.size());
+            if (compress2(compressed.data(), &compressedSize, raw.data(), static_cast<uLong>(rawPageSize), Z_BEST_COMPRESSION) == Z_OK &&
+                compressedSize < rawPageSize) {
+                compressed.resize(compressedSize);
+                pages[i] = std::move(compressed);
+                compressions[i] = StaticFontPageCompression::Deflate;
+                continue;
+            }
+        }
+
+        pages[i] = std::move(raw);
     }
-    int i = 0;
-    for (auto& texture : font->textures_) {
-        texture->Save((textureDir + u"/Texture" + utf8_to_utf16(std::to_string(i++)) + u".png").c_str());
+
+    StaticFontHeader header;
+    header.Magic = StaticFontMagic;
+    header.Version = StaticFontVersion;
+    header.SamplingSize = font->samplingSize_;
+    header.Ascent = font->ascent_;
+    header.Descent = font->descent_;
+    header.LineGap = font->lineGap_;
+    header.EmSize = font->emSize_;
+    header.TextureSizeX = font->textureSize_.X;
+    header.TextureSizeY = font->textureSize_.Y;
+    header.GlyphCount = static_cast<int32_t>(glyphTable.size() / sizeof(StaticFontGlyphRecord));
+    header.GlyphTableOffset = sizeof(StaticFontHeader);
+    header.KerningCount = kerningCount;
+    header.KerningTableOffset = header.GlyphTableOffset + static_cast<int32_t>(glyphTable.size());
+    header.PageCount = pageCount;
+    header.PageTableOffset = header.KerningTableOffset + static_cast<int32_t>(kerningTable.size());
+
+    std::vector<uint8_t> pageTable;
+    int64_t pageOffset = header.PageTableOffset + static_cast<int64_t>(sizeof(StaticFontPageRecord)) * pageCount;
+    for (int32_t i = 0; i < pageCount; i++) {
+        if (pageOffset + static_cast<int64_t>(pages[i].size()) > INT32_MAX) {
+            Log::GetInstance()->Error(LogCategory::Core, u"Font::GenerateFontFile: Font textures are too large");
+            return false;
+        }
+
+        StaticFontPageRecord record;
+        record.Offset = static_cast<int32_t>(pageOffset);
+        record.StoredSize = static_cast<int32_t>(pages[i].size());
+        record.RawSize = static_cast<int32_t>(rawPageSize);
+        record.Compression = static_cast<int32_t>(compressions[i]);
+        WriteStaticFontRecord(pageTable, record);
+        pageOffset += pages[i].size();
     }
 
     std::ofstream fs;
@@ -325,20 +929,85 @@ bool Font::GenerateFontFile(const char16_t* dynamicFontPath, const char16_t* sta
 #endif
     if (!fs.is_open()) return false;
 
-    writer.WriteOut(fs);
+    fs.write(reinterpret_cast<const char*>(&header), sizeof(StaticFontHeader));
+    fs.write(reinterpret_cast<const char*>(glyphTable.data()), glyphTable.size());
+    fs.write(reinterpret_cast<const char*>(kerningTable.data()), kerningTable.size());
+    fs.write(reinterpret_cast<const char*>(pageTable.data()), pageTable.size());
+    for (const auto& page : pages) {
+        fs.write(reinterpret_cast<const char*>(page.data()), page.size());
+    }
+
+    return fs.good();
+}
+
+bool Font::Reload() {
+    // static fonts keep the data they were loaded from
+    if (isStaticFont_ || file_ == nullptr) return false;
+
+    // file_ has been reloaded before, as static files are reloaded first
+    const auto data = file_->GetDataOwner();
+    const int64_t size = file_->GetSize();
+    auto fontHandle = LoadFontHandle(data, size);
+    if (fontHandle == nullptr) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Font::Reload: Failed to initialize font '{0}'", utf16_to_utf8(sourcePath_).c_str());
+        return false;
+    }
+
+    // the faces refer to the old data, so they are released before it
+    hbFont_ = nullptr;
+    hbBuffer_ = nullptr;
+    ftFace_ = nullptr;
+    isShapingInitialized_ = false;
+    fontHandle_ = fontHandle;
+    fileData_ = data;
+    fileDataSize_ = size;
+
+    msdfgen::FontMetrics metrics;
+    msdfgen::getFontMetrics(metrics, fontHandle_.get());
+    ascent_ = static_cast<float>(metrics.ascenderY);
+    descent_ = static_cast<float>(metrics.descenderY);
+    emSize_ = static_cast<float>(metrics.emSize);
+    lineGap_ = static_cast<float>(metrics.lineHeight);
+
+    glyphs_.clear();
+    glyphsByIndex_.clear();
+    for (auto& cache : shapedRuns_) {
+        cache.Index.clear();
+        cache.Runs.clear();
+    }
+    kerningCache_.clear();
+
+    textures_.clear();
+    AddFontTexture();
+    AddGlyph('\0');
+
     return true;
 }
 
-bool Font::Reload() { return false; }
+int64_t Font::GetMemorySize() const {
+    // the font file is counted as a StaticFile
+    int64_t size = 0;
+    for (const auto& texture : textures_) {
+        if (texture != nullptr) size += texture->GetMemorySize();
+    }
+    return size;
+}
 
 void Font::AddFontTexture() {
-    std::vector<uint8_t> temp;
-    temp.resize(textureSize_.X * textureSize_.Y);
-    for (int32_t i = 0; i < textureSize_.X * textureSize_.Y; i++) {
-        temp[i] = 0;
+    std::shared_ptr<LLGI::Texture> llgiTexture;
+
+    if (distanceFieldType_ == FontDistanceFieldType::SDF) {
+        std::vector<uint8_t> temp(textureSize_.X * textureSize_.Y, 0);
+        llgiTexture = Graphics::GetInstance()->CreateTexture(temp.data(), textureSize_.X, textureSize_.Y, TextureFormatType::R8_UNORM);
+    } else if (distanceFieldType_ == FontDistanceFieldType::MTSDF) {
+        // alpha is also used as distance
+        std::vector<uint8_t> temp(textureSize_.X * textureSize_.Y * 4, 0);
+        llgiTexture = Graphics::GetInstance()->CreateTexture(temp.data(), textureSize_.X, textureSize_.Y, TextureFormatType::R8G8B8A8_UNORM);
+    } else {
+        std::vector<uint8_t> temp(textureSize_.X * textureSize_.Y, 0);
+        llgiTexture = Graphics::GetInstance()->CreateTexture(temp.data(), textureSize_.X, textureSize_.Y, 1);
     }
 
-    auto llgiTexture = Graphics::GetInstance()->CreateTexture(temp.data(), textureSize_.X, textureSize_.Y, 1);
     auto texture = MakeAsdShared<Texture2D>(Resources::GetInstance(), llgiTexture, u"");
     textures_.push_back(texture);
 
@@ -358,12 +1027,88 @@ void Font::AddGlyph(const int32_t character) {
         return;
     }
 
-    // 空白等形状なしのフォント
     if (shape.edgeCount() < 1) {
         Log::GetInstance()->Info(LogCategory::Core, u"Font::AddGlyph: Edge Count of '{0}' is less than 1", static_cast<char>(character));
-        auto glyph = MakeAsdShared<Glyph>(textureSize_, textures_.size() - 1, currentTexturePosition_, Vector2I(0, 0), Vector2F(), advance);
-        glyphs_[character] = glyph;
-        return;
+    }
+
+    glyphs_[character] = CreateGlyph(shape, advance);
+}
+
+namespace {
+
+//! builds msdfgen::Shape from a freetype outline in the same way as msdfgen::loadGlyph
+struct OutlineContext {
+    msdfgen::Shape* Shape;
+    msdfgen::Contour* Contour;
+    msdfgen::Point2 Position;
+};
+
+msdfgen::Point2 ToPoint2(const FT_Vector* vector) { return msdfgen::Point2(vector->x / 64.0, vector->y / 64.0); }
+
+int OutlineMoveTo(const FT_Vector* to, void* user) {
+    auto context = static_cast<OutlineContext*>(user);
+    if (context->Contour == nullptr || !context->Contour->edges.empty()) context->Contour = &context->Shape->addContour();
+    context->Position = ToPoint2(to);
+    return 0;
+}
+
+int OutlineLineTo(const FT_Vector* to, void* user) {
+    auto context = static_cast<OutlineContext*>(user);
+    const auto end = ToPoint2(to);
+    if (end != context->Position) {
+        context->Contour->addEdge(new msdfgen::LinearSegment(context->Position, end));
+        context->Position = end;
+    }
+    return 0;
+}
+
+int OutlineConicTo(const FT_Vector* control, const FT_Vector* to, void* user) {
+    auto context = static_cast<OutlineContext*>(user);
+    const auto end = ToPoint2(to);
+    context->Contour->addEdge(new msdfgen::QuadraticSegment(context->Position, ToPoint2(control), end));
+    context->Position = end;
+    return 0;
+}
+
+int OutlineCubicTo(const FT_Vector* control1, const FT_Vector* control2, const FT_Vector* to, void* user) {
+    auto context = static_cast<OutlineContext*>(user);
+    const auto end = ToPoint2(to);
+    context->Contour->addEdge(new msdfgen::CubicSegment(context->Position, ToPoint2(control1), ToPoint2(control2), end));
+    context->Position = end;
+    return 0;
+}
+
+}  // namespace
+
+bool Font::LoadGlyphShape(msdfgen::Shape& shape, uint32_t glyphIndex, double& advance) {
+    const auto face = ftFace_.get();
+    if (face == nullptr || FT_Load_Glyph(face, glyphIndex, FT_LOAD_NO_SCALE) != 0) return false;
+
+    advance = face->glyph->advance.x / 64.0;
+
+    shape.contours.clear();
+    shape.inverseYAxis = false;
+
+    OutlineContext context{&shape, nullptr, msdfgen::Point2()};
+
+    FT_Outline_Funcs funcs;
+    funcs.move_to = OutlineMoveTo;
+    funcs.line_to = OutlineLineTo;
+    funcs.conic_to = OutlineConicTo;
+    funcs.cubic_to = OutlineCubicTo;
+    funcs.shift = 0;
+    funcs.delta = 0;
+
+    if (FT_Outline_Decompose(&face->glyph->outline, &funcs, &context) != 0) return false;
+
+    if (!shape.contours.empty() && shape.contours.back().edges.empty()) shape.contours.pop_back();
+    return true;
+}
+
+std::shared_ptr<Glyph> Font::CreateGlyph(msdfgen::Shape& shape, double advance) {
+    // 空白等形状なしのフォント
+    if (shape.edgeCount() < 1) {
+        return MakeAsdShared<Glyph>(textureSize_, textures_.size() - 1, currentTexturePosition_, Vector2I(0, 0), Vector2F(), advance);
     }
 
     const auto bounds = shape.getBounds();
@@ -381,18 +1126,29 @@ void Font::AddGlyph(const int32_t character) {
     const auto heightWithPadding = height + TextureSamplingPaddingPixel;
 
     // MDFGデータ生成
-    msdfgen::Bitmap<float, 3> msdf(widthWithPadding, heightWithPadding);
+    // SDF は 1 チャンネル、MTSDF は MSDF に加えて SDF をアルファに格納する
+    const auto hasMultiChannel = distanceFieldType_ != FontDistanceFieldType::SDF;
+    const auto hasTrueDistance = distanceFieldType_ != FontDistanceFieldType::MSDF;
+
+    msdfgen::Bitmap<float, 3> msdf(hasMultiChannel ? widthWithPadding : 0, hasMultiChannel ? heightWithPadding : 0);
+    msdfgen::Bitmap<float, 1> sdf(hasTrueDistance ? widthWithPadding : 0, hasTrueDistance ? heightWithPadding : 0);
     {
         shape.inverseYAxis = true;
         shape.normalize();
         shape.orientContours();
-        msdfgen::edgeColoringSimple(shape, AngleThresholdDefault);
 
         const auto padding = static_cast<double>(TextureSamplingPaddingPixel / 2);
 
         const auto translate = msdfgen::Vector2(padding / width, padding / height - bounds.b - descent_);
 
-        msdfgen::generateMSDF(msdf, shape, PxRangeDefault, msdfgen::Vector2(scale), translate);
+        if (hasMultiChannel) {
+            msdfgen::edgeColoringSimple(shape, AngleThresholdDefault);
+            msdfgen::generateMSDF(msdf, shape, pxRange_, msdfgen::Vector2(scale), translate);
+        }
+
+        if (hasTrueDistance) {
+            msdfgen::generateSDF(sdf, shape, pxRange_, msdfgen::Vector2(scale), translate);
+        }
     }
 
     // 横幅が収まらない場合は次の行へ
@@ -408,16 +1164,31 @@ void Font::AddGlyph(const int32_t character) {
 
     {
         const auto llgiTexture = textures_.back()->GetNativeTexture();
-        const auto buf = (LLGI::Color8*)llgiTexture->Lock();
-
-        for (int32_t y = 0; y < heightWithPadding; y++) {
-            const auto ty = pos.Y + y;
-            for (int32_t x = 0; x < widthWithPadding; x++) {
-                const auto tx = x + pos.X;
-                buf[tx + ty * textureSize_.X].R = msdfgen::pixelFloatToByte(msdf(x, y)[0]);
-                buf[tx + ty * textureSize_.X].G = msdfgen::pixelFloatToByte(msdf(x, y)[1]);
-                buf[tx + ty * textureSize_.X].B = msdfgen::pixelFloatToByte(msdf(x, y)[2]);
-                // buf[x + y * textureSize_.X].A = 0;
+
+        if (distanceFieldType_ == FontDistanceFieldType::SDF) {
+            const auto buf = (uint8_t*)llgiTexture->Lock();
+
+            for (int32_t y = 0; y < heightWithPadding; y++) {
+                const auto ty = pos.Y + y;
+                for (int32_t x = 0; x < widthWithPadding; x++) {
+                    const auto tx = x + pos.X;
+                    buf[tx + ty * textureSize_.X] = msdfgen::pixelFloatToByte(sdf(x, y)[0]);
+                }
+            }
+        } else {
+            const auto buf = (LLGI::Color8*)llgiTexture->Lock();
+
+            for (int32_t y = 0; y < heightWithPadding; y++) {
+                const auto ty = pos.Y + y;
+                for (int32_t x = 0; x < widthWithPadding; x++) {
+                    const auto tx = x + pos.X;
+                    buf[tx + ty * textureSize_.X].R = msdfgen::pixelFloatToByte(msdf(x, y)[0]);
+                    buf[tx + ty * textureSize_.X].G = msdfgen::pixelFloatToByte(msdf(x, y)[1]);
+                    buf[tx + ty * textureSize_.X].B = msdfgen::pixelFloatToByte(msdf(x, y)[2]);
+                    if (hasTrueDistance) {
+                        buf[tx + ty * textureSize_.X].A = msdfgen::pixelFloatToByte(sdf(x, y)[0]);
+                    }
+                }
             }
         }
 
@@ -429,8 +1200,7 @@ void Font::AddGlyph(const int32_t character) {
 
     const auto glyphPos = pos + Vector2I(TextureSamplingPaddingPixel / 2, TextureSamplingPaddingPixel / 2);
 
-    const auto glyph = MakeAsdShared<Glyph>(textureSize_, textures_.size() - 1, glyphPos, Vector2I(width, height), offset, advance);
-    glyphs_[character] = glyph;
+    return MakeAsdShared<Glyph>(textureSize_, textures_.size() - 1, glyphPos, Vector2I(width, height), offset, advance);
 }
 
 }  // namespace Altseed2
@@ -5,8 +5,13 @@
 #include <msdfgen/msdfgen.h>
 
 #include <array>
+#include <future>
+#include <list>
 #include <map>
 #include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "../Common/BinaryReader.h"
 #include "../Common/BinaryWriter.h"
@@ -18,10 +23,25 @@
 #include "Color.h"
 #include "Texture2D.h"
 
+struct hb_font_t;
+struct hb_buffer_t;
+struct FT_FaceRec_;
+struct FT_LibraryRec_;
+
 namespace Altseed2 {
 enum class WritingDirection : int32_t { Vertical,
                                         Horizontal };
 
+//! 動的フォントのグリフの生成方法
+enum class FontDistanceFieldType : int32_t {
+    //! 3 channels (RGB)
+    MSDF,
+    //! 1 channel (R8 texture)
+    SDF,
+    //! MSDF in RGB and true SDF in A, which FontMTSDFUnlitPS uses for outline
+    MTSDF,
+};
+
 class Glyph : public BaseObject {
 private:
     Vector2I textureSize_;
@@ -73,10 +93,30 @@ public:
 #endif
 };
 
+#if !USE_CBG
+//! A glyph placed by harfbuzz. Units are same as Glyph::GetAdvance.
+struct ShapedGlyph {
+    //! glyph id in the font, which differs from the nominal glyph of Character in ligatures, contextual forms and complex scripts
+    int32_t GlyphIndex;
+
+    //! the first character of the cluster (for image glyphs)
+    int32_t Character;
+
+    float AdvanceX;
+    float OffsetX;
+    float OffsetY;
+};
+#endif
+
 class Font : public Resource {
 private:
     std::shared_ptr<Resources> resources_;
 
+    //! content of file_ which the faces and the tables refer to, kept until the font is reloaded
+    //! declared before them so that it is released after them
+    std::shared_ptr<const void> fileData_;
+    int64_t fileDataSize_;
+
     std::shared_ptr<msdfgen::FontHandle> fontHandle_;
     float ascent_, descent_, lineGap_, emSize_;
     int32_t samplingSize_;
@@ -92,12 +132,68 @@ private:
     std::u16string sourcePath_;
 
     bool isStaticFont_;
-    std::map<std::pair<int32_t, int32_t>, int32_t> kernings_;
 
+    FontDistanceFieldType distanceFieldType_;
+    float pxRange_;
+
+#if !USE_CBG
+    //! harfbuzz objects which refer to fileData_ (for dynamic font)
+    std::shared_ptr<hb_font_t> hbFont_;
+    std::shared_ptr<hb_buffer_t> hbBuffer_;
+    float hbScale_;
+    bool isShapingInitialized_;
+
+    //! freetype face which refers to fileData_, to load glyphs by glyph id (for dynamic font)
+    std::shared_ptr<FT_FaceRec_> ftFace_;
+
+    //! glyphs placed by harfbuzz, key is glyph id (for dynamic font)
+    std::map<int32_t, std::shared_ptr<Glyph>> glyphsByIndex_;
+
+    //! shaped runs in order of use, the least recently used one is evicted
+    struct ShapedRunCache {
+        std::list<std::pair<std::u16string, std::shared_ptr<const std::vector<ShapedGlyph>>>> Runs;
+        std::unordered_map<std::u16string_view, decltype(Runs)::iterator> Index;
+    };
+
+    //! indexed by whether kerning is enabled
+    std::array<ShapedRunCache, 2> shapedRuns_;
+
+    struct KerningPair {
+        int32_t First;
+        int32_t Second;
+        int32_t Value;
+    };
+
+    struct KerningCacheEntry {
+        uint64_t Key;
+        int32_t Value;
+    };
+
+    //! kernings queried from freetype, direct mapped by the hash of (c1 << 32 | c2) (for dynamic font)
+    std::vector<KerningCacheEntry> kerningCache_;
+
+    //! sorted by (First, Second), only non-zero pairs (for version 1 static font)
+    std::vector<KerningPair> kernings_;
+
+    //! offsets of the tables in fileData_ (for version 2 static font)
+    int32_t staticFontVersion_;
+    int32_t glyphTableOffset_;
+    int32_t glyphCount_;
+    int32_t kerningTableOffset_;
+    int32_t kerningCount_;
+    int32_t pageTableOffset_;
+#endif
+
+    //! serializes creation of faces in freetypeHandle_, which is not thread safe
     static std::mutex mtx;
 
     static std::shared_ptr<msdfgen::FreetypeHandle> freetypeHandle_;
 
+#if !USE_CBG
+    //! used to load glyphs by glyph id, which msdfgen::loadGlyph does not support
+    static std::shared_ptr<FT_LibraryRec_> ftLibrary_;
+#endif
+
 public:
     static constexpr float PxRangeDefault = 4.0;
     static constexpr float AngleThresholdDefault = 3.0;
@@ -106,12 +202,21 @@ public:
     static constexpr int32_t TextureAtlasMarginPixel = 4;
     static constexpr int32_t TextureSamplingPaddingPixel = 4;
 
+#if !USE_CBG
+    static constexpr int32_t ShapedRunCacheMax = 512;
+
+    //! the number of kerning pairs cached by a dynamic font, which must be a power of 2
+    static constexpr int32_t KerningCacheSize = 1024;
+#endif
+
     Font(std::u16string path);
     Font(std::shared_ptr<Resources>& resources,
          std::shared_ptr<StaticFile>& file,
          std::shared_ptr<msdfgen::FontHandle> fontHandle,
          int32_t samplingSize,
-         std::u16string path);
+         std::u16string path,
+         FontDistanceFieldType distanceFieldType = FontDistanceFieldType::MSDF,
+         float pxRange = PxRangeDefault);
 
     virtual ~Font();
 
@@ -126,26 +231,54 @@ public:
     virtual float GetLineGap() { return lineGap_; }
     virtual float GetEmSize() { return emSize_; }
     virtual bool GetIsStaticFont() { return isStaticFont_; }
+    virtual FontDistanceFieldType GetDistanceFieldType() { return distanceFieldType_; }
+    virtual float GetPxRange() { return pxRange_; }
 
     virtual std::shared_ptr<Glyph> GetGlyph(const int32_t character);
-    virtual std::shared_ptr<Texture2D> GetFontTexture(int32_t index) {
-        if (index >= textures_.size()) return nullptr;
-        return textures_[index];
-    }
+    virtual std::shared_ptr<Texture2D> GetFontTexture(int32_t index);
 
     virtual int32_t GetKerning(const int32_t c1, const int32_t c2);
 
+#if !USE_CBG
+    //! Shape a line (without '\n') horizontally. Returns nullptr if shaping is not supported (e.g. static font).
+    //! The result is kept alive by the returned pointer even if it is evicted from the cache.
+    virtual std::shared_ptr<const std::vector<ShapedGlyph>> Shape(const std::u16string& text, bool isKerningEnabled);
+
+    //! Get a glyph by the glyph id of ShapedGlyph. Returns nullptr if it is not supported (e.g. static font).
+    virtual std::shared_ptr<Glyph> GetGlyphByIndex(const int32_t glyphIndex);
+#endif
+
     static std::shared_ptr<Font> LoadDynamicFont(const char16_t* path, int32_t samplingSize);
+    static std::shared_ptr<Font> LoadDynamicFont(
+            const char16_t* path, int32_t samplingSize, FontDistanceFieldType distanceFieldType, float pxRange = PxRangeDefault);
+
+#if !USE_CBG
+    //! reads and parses the file in a background thread and creates the textures of the font in Core::DoEvent
+    static std::shared_future<std::shared_ptr<Font>> LoadDynamicFontAsync(
+            const char16_t* path,
+            int32_t samplingSize,
+            FontDistanceFieldType distanceFieldType = FontDistanceFieldType::MSDF,
+            float pxRange = PxRangeDefault);
+#endif
     static std::shared_ptr<Font> LoadStaticFont(const char16_t* path);
     static std::shared_ptr<Font> CreateImageFont(std::shared_ptr<Font> baseFont);
 
     static bool GenerateFontFile(const char16_t* dynamicFontPath, const char16_t* staticFontPath, int32_t samplingSize, const char16_t* characters);
 
+#if !USE_CBG
+    static bool GenerateFontFile(
+            const char16_t* dynamicFontPath, const char16_t* staticFontPath, int32_t samplingSize, const char16_t* characters, bool isTextureCompressed);
+#endif
+
     virtual void AddImageGlyph(const int32_t character, std::shared_ptr<TextureBase> texture) {}
     virtual std::shared_ptr<TextureBase> GetImageGlyph(const int32_t character) { return nullptr; }
 
     bool Reload() override;
 
+#if !USE_CBG
+    int64_t GetMemorySize() const override;
+#endif
+
     const char16_t* GetPath() const;
 
 private:
@@ -153,8 +286,36 @@ private:
     void AddFontTexture();
     void AddGlyph(const int32_t character);
 
-    static std::u16string GetKeyName(const char16_t* path, float samplingSize) {
-        return std::u16string(path) + utf8_to_utf16(std::to_string(samplingSize));
+    //! loads the face of a dynamic font from data, which it refers to without copy
+    static std::shared_ptr<msdfgen::FontHandle> LoadFontHandle(const std::shared_ptr<const void>& data, int64_t size);
+    std::shared_ptr<Glyph> CreateGlyph(msdfgen::Shape& shape, double advance);
+    bool LoadGlyphShape(msdfgen::Shape& shape, uint32_t glyphIndex, double& advance);
+    bool InitializeShaping();
+
+    //! parses the font file. does not create textures, so it can be called from any thread
+    static std::shared_ptr<Font> CreateDynamicFont(
+            std::shared_ptr<Resources>& resources,
+            std::shared_ptr<StaticFile>& file,
+            int32_t samplingSize,
+            const std::u16string& normalizedPath,
+            FontDistanceFieldType distanceFieldType,
+            float pxRange);
+
+    //! creates the first texture and registers the font, or returns the font registered meanwhile. call on the main thread
+    static std::shared_ptr<Font> RegisterDynamicFont(std::shared_ptr<Font>& font);
+
+    static std::shared_ptr<Font> LoadStaticFontV1(std::shared_ptr<Font>& font, std::shared_ptr<StaticFile>& file, const std::u16string& normalizedPath);
+    static std::shared_ptr<Font> LoadStaticFontV2(std::shared_ptr<Font>& font, std::shared_ptr<StaticFile>& file);
+
+    std::shared_ptr<Glyph> FindStaticGlyph(const int32_t character);
+    std::shared_ptr<Texture2D> LoadStaticFontTexture(int32_t index);
+
+    static std::u16string GetKeyName(const char16_t* path, float samplingSize, FontDistanceFieldType distanceFieldType, float pxRange) {
+        auto key = std::u16string(path) + utf8_to_utf16(std::to_string(samplingSize));
+        if (distanceFieldType != FontDistanceFieldType::MSDF || pxRange != PxRangeDefault) {
+            key += u":" + utf8_to_utf16(std::to_string(static_cast<int32_t>(distanceFieldType))) + u":" + utf8_to_utf16(std::to_string(pxRange));
+        }
+        return key;
     }
 #endif
 };
@@ -6,6 +6,7 @@
 #include "BuiltinShader.h"
 #include "CommandList.h"
 #include "FrameDebugger.h"
+#include "ImageHelper.h"
 
 #ifdef _WIN32
 #pragma comment(lib, "d3dcompiler.lib")
@@ -157,34 +158,9 @@ std::shared_ptr<LLGI::Texture> Graphics::CreateTexture(uint8_t* data, int32_t wi
     }
 
     if (data != nullptr) {
-        auto texture_buf = (LLGI::Color8*)texture->Lock();
-        if (channel == 4) {
-            for (int32_t y = 0; y < height; y++) {
-                for (int32_t x = 0; x < width; x++) {
-                    texture_buf[x + y * width].R = data[4 * (x + y * width)];
-                    texture_buf[x + y * width].G = data[4 * (x + y * width) + 1];
-                    texture_buf[x + y * width].B = data[4 * (x + y * width) + 2];
-                    texture_buf[x + y * width].A = data[4 * (x + y * width) + 3];
-                }
-            }
-        } else if (channel == 3) {
-            for (int32_t y = 0; y < height; y++) {
-                for (int32_t x = 0; x < width; x++) {
-                    texture_buf[x + y * width].R = data[3 * (x + y * width)];
-                    texture_buf[x + y * width].G = data[3 * (x + y * width) + 1];
-                    texture_buf[x + y * width].B = data[3 * (x + y * width) + 2];
-                    texture_buf[x + y * width].A = 255;
-                }
-            }
-        } else if (channel == 1) {
-            for (int32_t y = 0; y < height; y++) {
-                for (int32_t x = 0; x < width; x++) {
-                    texture_buf[x + y * width].R = data[x + y * width];
-                    texture_buf[x + y * width].G = data[x + y * width];
-                    texture_buf[x + y * width].B = data[x + y * width];
-                    texture_buf[x + y * width].A = 255;
-                }
-            }
+        auto texture_buf = static_cast<uint8_t*>(texture->Lock());
+        if (!ImageHelper::ConvertToRGBA8(data, channel, static_cast<int64_t>(width) * height, texture_buf)) {
+            Log::GetInstance()->Error(LogCategory::Core, u"Graphics::CreateTexture: channel {0} is not supported", channel);
         }
 
         texture->Unlock();
@@ -193,6 +169,36 @@ std::shared_ptr<LLGI::Texture> Graphics::CreateTexture(uint8_t* data, int32_t wi
     return texture;
 }
 
+std::shared_ptr<LLGI::Texture> Graphics::CreateTexture(uint8_t* data, int32_t width, int32_t height, TextureFormatType format) {
+    int32_t pixelSize = 0;
+    if (format == TextureFormatType::R8_UNORM) {
+        pixelSize = 1;
+    } else if (format == TextureFormatType::R8G8B8A8_UNORM) {
+        pixelSize = 4;
+    } else {
+        Log::GetInstance()->Error(LogCategory::Core, u"Graphics::CreateTexture: unsupported format");
+        return nullptr;
+    }
+
+    LLGI::TextureInitializationParameter params;
+    params.Format = textureFormatToLLGI(format);
+    params.Size = LLGI::Vec2I(width, height);
+
+    std::shared_ptr<LLGI::Texture> texture = LLGI::CreateSharedPtr(graphics_->CreateTexture(params));
+    if (texture == nullptr) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Graphics::CreateTexture: failed");
+        return nullptr;
+    }
+
+    if (data != nullptr) {
+        auto texture_buf = texture->Lock();
+        memcpy(texture_buf, data, static_cast<size_t>(width) * height * pixelSize);
+        texture->Unlock();
+    }
+
+    return texture;
+}
+
 std::shared_ptr<LLGI::Texture> Graphics::CreateRenderTexture(int32_t width, int32_t height, TextureFormatType format) {
     LLGI::RenderTextureInitializationParameter params;
     params.Format = textureFormatToLLGI(format);
@@ -101,6 +101,9 @@ public:
 
     std::shared_ptr<LLGI::Buffer> CreateBuffer(LLGI::BufferUsageType usage, int32_t size);
     std::shared_ptr<LLGI::Texture> CreateTexture(uint8_t* data, int32_t width, int32_t height, int32_t channel);
+
+    //! data must be tightly packed in the format (R8_UNORM or R8G8B8A8_UNORM)
+    std::shared_ptr<LLGI::Texture> CreateTexture(uint8_t* data, int32_t width, int32_t height, TextureFormatType format);
     std::shared_ptr<LLGI::Texture> CreateRenderTexture(int32_t width, int32_t height, TextureFormatType format = TextureFormatType::R8G8B8A8_UNORM);
     std::shared_ptr<LLGI::RenderPass> CreateRenderPass(LLGI::Texture* renderTexture);
     LLGI::Graphics* GetGraphicsLLGI() const { return graphics_; }
@@ -30,11 +30,24 @@ public:
 
     bool GetIsStaticFont() override { return baseFont_->GetIsStaticFont(); }
 
+#if !USE_CBG
+    FontDistanceFieldType GetDistanceFieldType() override { return baseFont_->GetDistanceFieldType(); }
+    float GetPxRange() override { return baseFont_->GetPxRange(); }
+#endif
+
     std::shared_ptr<Glyph> GetGlyph(const int32_t character) override { return baseFont_->GetGlyph(character); }
     std::shared_ptr<Texture2D> GetFontTexture(int32_t index) override { return baseFont_->GetFontTexture(index); }
 
     int32_t GetKerning(const int32_t c1, const int32_t c2) override { return baseFont_->GetKerning(c1, c2); }
 
+#if !USE_CBG
+    std::shared_ptr<const std::vector<ShapedGlyph>> Shape(const std::u16string& text, bool isKerningEnabled) override {
+        return baseFont_->Shape(text, isKerningEnabled);
+    }
+
+    std::shared_ptr<Glyph> GetGlyphByIndex(const int32_t glyphIndex) override { return baseFont_->GetGlyphByIndex(glyphIndex); }
+#endif
+
     void AddImageGlyph(const int32_t character, std::shared_ptr<TextureBase> texture) override;
     std::shared_ptr<TextureBase> GetImageGlyph(const int32_t character) override;
 };
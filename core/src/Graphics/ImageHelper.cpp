@@ -0,0 +1,113 @@
+#include "ImageHelper.h"
+
+#include <cstring>
+
+// SSSE3 is not enabled by the default x86-64 flags, so it is compiled for the function only and chosen at runtime
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <tmmintrin.h>
+#define ALTSEED2_IMAGE_SSSE3
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define ALTSEED2_TARGET_SSSE3
+#else
+#define ALTSEED2_TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ALTSEED2_IMAGE_NEON
+#endif
+
+namespace Altseed2 {
+
+namespace {
+
+#if defined(ALTSEED2_IMAGE_SSSE3)
+bool GetIsSSSE3Supported() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#else
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+//! returns the number of converted pixels
+ALTSEED2_TARGET_SSSE3 int64_t ConvertRGBToRGBA8SSSE3(const uint8_t* src, int64_t pixelCount, uint8_t* dst) {
+    int64_t i = 0;
+
+    // 4 pixels per iteration. 16 bytes are loaded, so the last pixels are left to the scalar loop
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int32_t>(0xFF000000));
+    for (; (i + 4) * 3 + 4 <= pixelCount * 3; i += 4) {
+        const __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+        const __m128i rgba = _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), rgba);
+    }
+
+    return i;
+}
+#endif
+
+void ConvertRGBToRGBA8(const uint8_t* src, int64_t pixelCount, uint8_t* dst) {
+    int64_t i = 0;
+
+#if defined(ALTSEED2_IMAGE_SSSE3)
+    static const bool isSSSE3Supported = GetIsSSSE3Supported();
+    if (isSSSE3Supported) {
+        i = ConvertRGBToRGBA8SSSE3(src, pixelCount, dst);
+    }
+#elif defined(ALTSEED2_IMAGE_NEON)
+    // 16 pixels per iteration
+    const uint8x16_t alpha = vdupq_n_u8(255);
+    for (; i + 16 <= pixelCount; i += 16) {
+        const uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+        uint8x16x4_t rgba;
+        rgba.val[0] = rgb.val[0];
+        rgba.val[1] = rgb.val[1];
+        rgba.val[2] = rgb.val[2];
+        rgba.val[3] = alpha;
+        vst4q_u8(dst + i * 4, rgba);
+    }
+#endif
+
+    for (; i < pixelCount; i++) {
+        dst[i * 4 + 0] = src[i * 3 + 0];
+        dst[i * 4 + 1] = src[i * 3 + 1];
+        dst[i * 4 + 2] = src[i * 3 + 2];
+        dst[i * 4 + 3] = 255;
+    }
+}
+
+}  // namespace
+
+bool ImageHelper::ConvertToRGBA8(const uint8_t* src, int32_t channel, int64_t pixelCount, uint8_t* dst) {
+    switch (channel) {
+        case 4:
+            memcpy(dst, src, static_cast<size_t>(pixelCount) * 4);
+            return true;
+        case 3:
+            ConvertRGBToRGBA8(src, pixelCount, dst);
+            return true;
+        case 2:
+            for (int64_t i = 0; i < pixelCount; i++) {
+                dst[i * 4 + 0] = src[i * 2];
+                dst[i * 4 + 1] = src[i * 2];
+                dst[i * 4 + 2] = src[i * 2];
+                dst[i * 4 + 3] = src[i * 2 + 1];
+            }
+            return true;
+        case 1:
+            for (int64_t i = 0; i < pixelCount; i++) {
+                dst[i * 4 + 0] = src[i];
+                dst[i * 4 + 1] = src[i];
+                dst[i * 4 + 2] = src[i];
+                dst[i * 4 + 3] = 255;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+}  // namespace Altseed2
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+#if !USE_CBG
+
+namespace Altseed2 {
+
+class ImageHelper {
+public:
+    //! expands pixels with 1 (gray), 2 (gray, alpha), 3 (RGB) or 4 (RGBA) channels into RGBA8
+    //! returns false if channel is not supported
+    static bool ConvertToRGBA8(const uint8_t* src, int32_t channel, int64_t pixelCount, uint8_t* dst);
+};
+
+}  // namespace Altseed2
+
+#endif
@@ -39,7 +39,7 @@ Vector4F MaterialPropertyBlock::GetVector4F(const char16_t* key) const {
 
     if (it != vector4s_.end()) return it->second;
 
-    Log::GetInstance()->Error(LogCategory::Core, u"MaterialPropertyBlock::GetVector4F: '{0}' is not found", utf16_to_utf8(key).c_str());
+    LOG_ERROR(LogCategory::Core, u"MaterialPropertyBlock::GetVector4F: '{0}' is not found", utf16_to_utf8(key).c_str());
     return Vector4F();
 }
 
@@ -53,7 +53,6 @@ bool MaterialPropertyBlock::GetVector4F(const char16_t* key, Vector4F& value) {
         return true;
     }
 
-    Log::GetInstance()->Error(LogCategory::Core, u"MaterialPropertyBlock::GetVector4F: '{0}' is not found", utf16_to_utf8(key).c_str());
     return false;
 }
 
@@ -74,7 +73,6 @@ bool MaterialPropertyBlock::GetMatrix44F(const char16_t* key, Matrix44F& value)
         return true;
     }
 
-    Log::GetInstance()->Error(LogCategory::Core, u"MaterialPropertyBlock::GetMatrix44F: '{0}' is not found", utf16_to_utf8(key).c_str());
     return false;
 }
 
@@ -83,7 +81,7 @@ std::shared_ptr<TextureBase> MaterialPropertyBlock::GetTexture(const char16_t* k
 
     if (it != textures_.end()) return it->second;
 
-    Log::GetInstance()->Error(LogCategory::Core, u"MaterialPropertyBlock::GetTexture: '{0}' is not found", utf16_to_utf8(key).c_str());
+    LOG_ERROR(LogCategory::Core, u"MaterialPropertyBlock::GetTexture: '{0}' is not found", utf16_to_utf8(key).c_str());
     return nullptr;
 }
 
@@ -97,7 +95,6 @@ bool MaterialPropertyBlock::GetTexture(const char16_t* key, std::shared_ptr<Text
         return true;
     }
 
-    Log::GetInstance()->Error(LogCategory::Core, u"MaterialPropertyBlock::GetTexture: '{0}' is not found", utf16_to_utf8(key).c_str());
     return false;
 }
 
@@ -113,8 +110,7 @@ Vector4F MaterialPropertyBlockCollection::GetVector4F(const char16_t* key) const
         }
     }
 
-    Log::GetInstance()->Error(
-            LogCategory::Core, u"MaterialPropertyBlockCollection::GetVector4F: '{0}' is not found", utf16_to_utf8(key).c_str());
+    LOG_ERROR(LogCategory::Core, u"MaterialPropertyBlockCollection::GetVector4F: '{0}' is not found", utf16_to_utf8(key).c_str());
     return ret;
 }
 
@@ -126,8 +122,7 @@ Matrix44F MaterialPropertyBlockCollection::GetMatrix44F(const char16_t* key) con
         }
     }
 
-    Log::GetInstance()->Error(
-            LogCategory::Core, u"MaterialPropertyBlockCollection::GetMatrix44F: '{0}' is not found", utf16_to_utf8(key).c_str());
+    LOG_ERROR(LogCategory::Core, u"MaterialPropertyBlockCollection::GetMatrix44F: '{0}' is not found", utf16_to_utf8(key).c_str());
     return ret;
 }
 
@@ -139,8 +134,7 @@ std::shared_ptr<TextureBase> MaterialPropertyBlockCollection::GetTexture(const c
         }
     }
 
-    Log::GetInstance()->Error(
-            LogCategory::Core, u"MaterialPropertyBlockCollection::GetTexture: '{0}' is not found", utf16_to_utf8(key).c_str());
+    LOG_ERROR(LogCategory::Core, u"MaterialPropertyBlockCollection::GetTexture: '{0}' is not found", utf16_to_utf8(key).c_str());
     return ret;
 }
 
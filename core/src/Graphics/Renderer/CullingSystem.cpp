@@ -23,7 +23,7 @@ void CullingSystem::Register(std::shared_ptr<Rendered> rendered) {
     std::lock_guard<std::mutex> lock(mtx_);
 
     if (renderedProxyIdMap_.count(rendered.get()) > 0) {
-        Log::GetInstance()->Warn(LogCategory::Core, u"CullingSystem::Unregister: rendered is already registered in the culling system.");
+        LOG_WARN(LogCategory::Core, u"CullingSystem::Unregister: rendered is already registered in the culling system.");
         return;
     }
 
@@ -85,7 +85,7 @@ void CullingSystem::Unregister(std::shared_ptr<Rendered> rendered) {
     std::lock_guard<std::mutex> lock(mtx_);
 
     if (renderedProxyIdMap_.count(rendered.get()) == 0) {
-        Log::GetInstance()->Warn(LogCategory::Core, u"CullingSystem::Unregister: rendered is not registered");
+        LOG_WARN(LogCategory::Core, u"CullingSystem::Unregister: rendered is not registered");
         return;
     }
 
@@ -40,6 +40,20 @@ public:
 #if !USE_CBG
     //! for Core only
     void RequestUpdateAABB(Rendered* rendered);
+
+    //! requests to update the AABBs of count objects, locking once
+    template <typename T>
+    void RequestUpdateAABB(T* const* rendereds, int32_t count) {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        for (int32_t i = 0; i < count; i++) {
+            auto it = renderedProxyIdMap_.find(rendereds[i]);
+            if (it != renderedProxyIdMap_.end()) {
+                updateIds_.insert(it->second);
+            }
+        }
+    }
+
     bool GetIsExists(Rendered* rendered);
 #endif
 
@@ -30,9 +30,12 @@ void RenderedPolygon::CreateVertexesByVector2F(std::shared_ptr<Vector2FArray> ve
         vertexes_->Resize(vectors->GetCount());
     }
 
+    // read through the pointer so that a borrowed array is not copied
+    auto vs = vectors->GetPointer();
+
     float xMin, xMax, yMin, yMax;
     {
-        auto& v = vectors->GetVector()[0];
+        auto& v = vs[0];
         xMin = v.X;
         xMax = v.X;
         yMin = v.Y;
@@ -41,7 +44,7 @@ void RenderedPolygon::CreateVertexesByVector2F(std::shared_ptr<Vector2FArray> ve
 
     auto count = vertexes_->GetCount();
     for (int32_t i = 0; i < count; i++) {
-        auto& v = vectors->GetVector()[i];
+        auto& v = vs[i];
         auto& vertex = vertexes_->GetVector()[i];
 
         vertex.Pos = Vector3F(v.X, v.Y, 0.5f);
@@ -71,8 +74,10 @@ void RenderedPolygon::CreateVertexesByVector2F(std::shared_ptr<Vector2FArray> ve
 }
 
 void RenderedPolygon::OverwriteVertexesColor(Color color) {
-    for (auto&& v : vertexes_->GetVector()) {
-        v.Col = color;
+    auto vs = static_cast<BatchVertex*>(vertexes_->GetData());
+    auto count = vertexes_->GetCount();
+    for (int32_t i = 0; i < count; i++) {
+        vs[i].Col = color;
     }
 }
 
@@ -94,8 +99,10 @@ b2AABB RenderedPolygon::GetAABB() {
     b2AABB res;
     res.lowerBound = b2Vec2(FLT_MAX, FLT_MAX);
     res.upperBound = b2Vec2(-FLT_MAX, -FLT_MAX);
-    for (auto&& _v : GetVertexes()->GetVector()) {
-        auto v = transform_.Transform3D(_v.Pos);
+    auto vs = GetVertexes()->GetPointer();
+    auto count = GetVertexes()->GetCount();
+    for (int32_t i = 0; i < count; i++) {
+        auto v = transform_.Transform3D(vs[i].Pos);
         res.lowerBound = b2Vec2(res.lowerBound.x > v.X ? v.X : res.lowerBound.x, res.lowerBound.y > v.Y ? v.Y : res.lowerBound.y);
         res.upperBound = b2Vec2(res.upperBound.x < v.X ? v.X : res.upperBound.x, res.upperBound.y < v.Y ? v.Y : res.upperBound.y);
     }
@@ -103,12 +110,12 @@ b2AABB RenderedPolygon::GetAABB() {
 }
 
 void RenderedPolygon::SetDefaultIndexBuffer() {
-    auto vs = vertexes_->GetVector();
-    if (vs.size() < 3) {
+    auto count = vertexes_->GetCount();
+    if (count < 3) {
         buffers_->GetVector().resize(0);
         return;
     }
-    auto length = vs.size() - 2;
+    auto length = count - 2;
     buffers_->GetVector().resize(length * 3);
     for (int i = 0; i < length; i++) {
         buffers_->GetVector()[i * 3] = 0;
@@ -1,6 +1,7 @@
 #include "RenderedSprite.h"
 
 #include "../../Common/Array.h"
+#include "../../Logger/Log.h"
 #include "../Material.h"
 #include "CullingSystem.h"
 
@@ -29,6 +30,33 @@ std::shared_ptr<Material> RenderedSprite::GetMaterial() const { return material_
 
 void RenderedSprite::SetMaterial(const std::shared_ptr<Material>& material) { material_ = material; }
 
+void RenderedSprite::SetBatch(void* sprites, void* transforms, void* srcs, void* colors, int32_t count) {
+    RETURN_IF_NULL(sprites, );
+    if (count <= 0) return;
+
+    auto sprites_ = static_cast<RenderedSprite* const*>(sprites);
+    auto transforms_ = static_cast<const Matrix44F*>(transforms);
+    auto srcs_ = static_cast<const RectF*>(srcs);
+    auto colors_ = static_cast<const Color*>(colors);
+
+    for (int32_t i = 0; i < count; i++) {
+        auto sprite = sprites_[i];
+        if (sprite == nullptr) continue;
+
+        if (transforms_ != nullptr) sprite->transform_ = transforms_[i];
+        if (srcs_ != nullptr) sprite->src_ = srcs_[i];
+        if (colors_ != nullptr) sprite->color_ = colors_[i];
+    }
+
+    // AABBs depend on the transforms and the srcs only
+    if (transforms_ == nullptr && srcs_ == nullptr) return;
+
+    auto cullingSystem = CullingSystem::GetInstance();
+    if (cullingSystem != nullptr) {
+        cullingSystem->RequestUpdateAABB(sprites_, count);
+    }
+}
+
 b2AABB RenderedSprite::GetAABB() {
     b2AABB res;
     auto vertexes = std::array<Vector3F, 4>();
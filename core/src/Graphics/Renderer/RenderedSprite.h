@@ -40,6 +40,13 @@ public:
     std::shared_ptr<Material> GetMaterial() const;
     void SetMaterial(const std::shared_ptr<Material>& material);
 
+    /**
+     * @brief 複数のスプライトの変換行列、描画範囲、色を一度に設定する
+     * 危険！：C# 連携用！sprites は RenderedSprite のポインタの配列、transforms, srcs, colors は Matrix44F, RectF, Color の配列で、
+     * それぞれ count 個の要素を持つこと。transforms, srcs, colors は nullptr なら設定しない
+     */
+    static void SetBatch(void* sprites, void* transforms, void* srcs, void* colors, int32_t count);
+
 #if !USE_CBG
 
     b2AABB GetAABB() override;
@@ -12,6 +12,7 @@ std::shared_ptr<RenderedText> RenderedText::Create() {
     auto t = MakeAsdShared<RenderedText>();
     t->SetAlphaBlend(AlphaBlend::Normal());
     t->SetIsEnableKerning(true);
+    t->SetIsEnableShaping(false);
     t->SetWritingDirection(WritingDirection::Horizontal);
     t->SetText(u"");
     t->SetCharacterSpace(0);
@@ -45,6 +46,12 @@ Vector2F RenderedText::IterateTexts(std::function<void(Vector2F pos, RectF src,
 
     const auto writingDir = GetWritingDirection();
 
+    // harfbuzz で行単位に整形する (横書きのみ)
+    if (GetIsEnableShaping() && writingDir == WritingDirection::Horizontal) {
+        Vector2F size;
+        if (IterateShapedTexts(font, doEachText, size)) return size;
+    }
+
     const auto lineSpace = GetLineGap();
 
     // 各文字のオフセットを格納する
@@ -161,6 +168,92 @@ Vector2F RenderedText::IterateTexts(std::function<void(Vector2F pos, RectF src,
     }
 }
 
+bool RenderedText::IterateShapedTexts(
+        const std::shared_ptr<Font>& font,
+        std::function<void(Vector2F pos, RectF uv, float texScale, std::shared_ptr<TextureBase>& texture, bool isGlyph)>& doEachText,
+        Vector2F& size) {
+    const auto& characters = GetTextAsStr();
+
+    const auto fontSize = GetFontSize();
+    const auto samplingSize = (float)font->GetSamplingSize();
+    const auto fontScale = fontSize / font->GetEmSize();
+    const auto glyphScale = samplingSize / (font->GetAscent() - font->GetDescent());
+
+    const auto lineSpace = GetLineGap();
+    const auto space = GetCharacterSpace();
+
+    Vector2F offset(0, 0);
+    float lineMax = 0.0f;
+
+    const auto hasReturn = characters.find(u'\n') != std::u16string::npos;
+
+    size_t lineBegin = 0;
+    while (true) {
+        const auto lineEnd = characters.find(u'\n', lineBegin);
+
+        // 改行を含まない場合は文字列をそのままキーにする
+        const auto shaped = hasReturn
+                                    ? font->Shape(characters.substr(lineBegin, lineEnd == std::u16string::npos ? std::u16string::npos : lineEnd - lineBegin), GetIsEnableKerning())
+                                    : font->Shape(characters, GetIsEnableKerning());
+        if (shaped == nullptr) return false;
+
+        for (size_t i = 0; i < shaped->size(); i++) {
+            const auto& shapedGlyph = (*shaped)[i];
+
+            RectF src;
+            Vector2F pos;
+            float texScale;
+            float advance;
+            std::shared_ptr<Glyph> glyph = nullptr;
+
+            auto texture = font->GetImageGlyph(shapedGlyph.Character);
+
+            if (texture != nullptr) {
+                auto texSize = texture->GetSize();
+
+                src = RectF(0, 0, texSize.X, texSize.Y);
+                pos = offset + Vector2F(0, font->GetAscent() * fontScale - fontSize);
+                texScale = fontSize / texSize.Y;
+                advance = (float)texSize.X * fontSize / texSize.Y;
+            } else {
+                glyph = font->GetGlyphByIndex(shapedGlyph.GlyphIndex);
+                if (glyph == nullptr) continue;
+
+                texture = font->GetFontTexture(glyph->GetTextureIndex());
+
+                auto glyphPos = glyph->GetPosition();
+                auto glyphSize = glyph->GetSize();
+                src = RectF(glyphPos.X, glyphPos.Y, glyphSize.X, glyphSize.Y);
+
+                pos = offset + Vector2F(0, font->GetAscent() * fontScale) + glyph->GetOffset() * fontScale +
+                      Vector2F(shapedGlyph.OffsetX, shapedGlyph.OffsetY) * fontScale;
+                texScale = fontScale / glyphScale;
+                advance = shapedGlyph.AdvanceX * fontScale;
+            }
+
+            if (doEachText != nullptr) {
+                doEachText(pos, src, texScale, texture, glyph != nullptr);
+            }
+
+            offset.X += advance;
+
+            // character spcae
+            if (i != shaped->size() - 1) {
+                offset.X += space;
+            }
+        }
+
+        if (lineEnd == std::u16string::npos) break;
+
+        lineMax = std::fmax(lineMax, offset.X);
+        offset = Vector2F(0, offset.Y + lineSpace);
+        lineBegin = lineEnd + 1;
+    }
+
+    size = Vector2F(std::fmax(lineMax, offset.X), offset.Y + lineSpace);
+    return true;
+}
+
 Vector2F RenderedText::GetRenderingSize() {
     return IterateTexts(nullptr);
 }
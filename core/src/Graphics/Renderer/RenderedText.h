@@ -23,6 +23,7 @@ private:
     Color color_;
     // float weight_;
     bool isEnableKerning_;
+    bool isEnableShaping_;
     WritingDirection writingDirection_;
     float characterSpace_;
     float lineGap_;
@@ -63,6 +64,12 @@ public:
     void SetIsEnableKerning(bool isEnableKerning) { isEnableKerning_ = isEnableKerning; }
     bool GetIsEnableKerning() { return isEnableKerning_; }
 
+    void SetIsEnableShaping(bool isEnableShaping) {
+        isEnableShaping_ = isEnableShaping;
+        cullingSystem_->RequestUpdateAABB(this);
+    }
+    bool GetIsEnableShaping() { return isEnableShaping_; }
+
     void SetWritingDirection(WritingDirection wrintingDirection) {
         writingDirection_ = wrintingDirection;
         cullingSystem_->RequestUpdateAABB(this);
@@ -106,6 +113,12 @@ public:
 
     b2AABB GetAABB() override;
 
+private:
+    bool IterateShapedTexts(
+            const std::shared_ptr<Font>& font,
+            std::function<void(Vector2F pos, RectF uv, float texScale, std::shared_ptr<TextureBase>& texture, bool isGlyph)>& doEachText,
+            Vector2F& size);
+
 #endif
 };
 
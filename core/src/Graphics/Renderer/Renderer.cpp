@@ -13,6 +13,7 @@
 #include "RenderedPolygon.h"
 #include "RenderedSprite.h"
 #include "RenderedText.h"
+#include "TextBatch.h"
 
 #ifdef _WIN32
 #undef DrawText
@@ -20,6 +21,22 @@
 
 namespace Altseed2 {
 
+namespace {
+
+std::shared_ptr<Material> GetMaterialDefaultGlyph(
+        const std::shared_ptr<BatchRenderer>& batchRenderer, FontDistanceFieldType distanceFieldType, const AlphaBlend blend) {
+    switch (distanceFieldType) {
+        case FontDistanceFieldType::SDF:
+            return batchRenderer->GetMaterialDefaultTextSDF(blend);
+        case FontDistanceFieldType::MTSDF:
+            return batchRenderer->GetMaterialDefaultTextMTSDF(blend);
+        default:
+            return batchRenderer->GetMaterialDefaultText(blend);
+    }
+}
+
+}  // namespace
+
 std::shared_ptr<Renderer> Renderer::instance_;
 
 std::shared_ptr<Renderer>& Renderer::GetInstance() { return instance_; }
@@ -43,7 +60,7 @@ Renderer::~Renderer() {}
 
 void Renderer::DrawPolygon(std::shared_ptr<RenderedPolygon> polygon) {
     if (polygon->GetVertexes() == nullptr) {
-        Log::GetInstance()->Warn(LogCategory::Core, u"Renderer::DrawPolygon: Vertexes is null");
+        LOG_WARN(LogCategory::Core, u"Renderer::DrawPolygon: Vertexes is null");
         return;
     }
 
@@ -57,21 +74,19 @@ void Renderer::DrawPolygon(std::shared_ptr<RenderedPolygon> polygon) {
         size = texture->GetSize().To2F();
     }
 
-    auto vs = std::vector<BatchVertex>(polygon->GetVertexes()->GetVector());
-    for (auto&& v : vs) {
-        // NOTE: Do NOT overwrite UV1, UV2 and Col so that original values which RenderedPolygon provides are applied.
-        v.Pos = polygon->GetTransform().Transform3D(v.Pos);
-    }
-
     auto material = polygon->GetMaterial();
 
     if (material == nullptr) {
         material = batchRenderer_->GetMaterialDefaultSprite(polygon->GetAlphaBlend());
     }
 
-    auto ib = polygon->GetBuffers()->GetVector();
+    // the vertexes and the indexes are read in place (they may be borrowed from the caller) and transformed in the batch
+    const auto vertexes = polygon->GetVertexes();
+    const auto buffers = polygon->GetBuffers();
+    const auto& transform = polygon->GetTransform();
 
-    batchRenderer_->Draw(vs.data(), ib.data(), vs.size(), ib.size(), texture, material, nullptr);
+    batchRenderer_->Draw(
+            vertexes->GetPointer(), buffers->GetPointer(), vertexes->GetCount(), buffers->GetCount(), texture, material, nullptr, &transform);
 }
 
 void Renderer::Render() {
@@ -153,7 +168,7 @@ void Renderer::DrawText(std::shared_ptr<RenderedText> text) {
 
     auto materialGlyph = text->GetMaterialGlyph();
     if (materialGlyph == nullptr) {
-        materialGlyph = batchRenderer_->GetMaterialDefaultText(text->GetAlphaBlend());
+        materialGlyph = GetMaterialDefaultGlyph(batchRenderer_, font->GetDistanceFieldType(), text->GetAlphaBlend());
     }
 
     auto materialImage = text->GetMaterialImage();
@@ -207,6 +222,83 @@ void Renderer::DrawText(std::shared_ptr<RenderedText> text) {
     });
 }
 
+void Renderer::DrawTextBatch(std::shared_ptr<TextBatch> batch) {
+    if (batch->GetFont() == nullptr || batch->GetCount() == 0) return;
+
+    auto materialGlyph = batch->GetMaterialGlyph();
+    if (materialGlyph == nullptr) {
+        materialGlyph = GetMaterialDefaultGlyph(batchRenderer_, batch->GetFont()->GetDistanceFieldType(), batch->GetAlphaBlend());
+    }
+
+    auto materialImage = batch->GetMaterialImage();
+    if (materialImage == nullptr) {
+        materialImage = batchRenderer_->GetMaterialDefaultSprite(batch->GetAlphaBlend());
+    }
+
+    batch->IterateTexts([&](const Color& color, Vector2F pos, RectF src, float texScale, std::shared_ptr<TextureBase>& texture, bool isGlyph) {
+        // space や tab など大きさ0の文字の描画は行わない
+        if (src.Width == 0 || src.Height == 0) return;
+
+        const auto& material = isGlyph ? materialGlyph : materialImage;
+
+        // 描画順を保つため、直前の文字とテクスチャかマテリアルが異なれば溜めた分を描画する
+        auto bucket = &textBatchBucket_;
+        if (bucket->texture != texture || bucket->material != material) {
+            FlushTextBatchBucket();
+            bucket->texture = texture;
+            bucket->material = material;
+        }
+
+        const auto base = static_cast<int32_t>(bucket->vertexes.size());
+        const auto textureSize = texture->GetSize().To2F();
+
+        std::array<BatchVertex, 4> vs;
+        vs[0].Pos = Vector3F(pos.X, pos.Y, 0.5f);
+        vs[1].Pos = Vector3F(pos.X + src.Width * texScale, pos.Y, 0.5f);
+        vs[2].Pos = Vector3F(pos.X + src.Width * texScale, pos.Y + src.Height * texScale, 0.5f);
+        vs[3].Pos = Vector3F(pos.X, pos.Y + src.Height * texScale, 0.5f);
+
+        vs[0].UV1 = Vector2F(src.X, src.Y);
+        vs[1].UV1 = Vector2F(src.X + src.Width, src.Y);
+        vs[2].UV1 = Vector2F(src.X + src.Width, src.Y + src.Height);
+        vs[3].UV1 = Vector2F(src.X, src.Y + src.Height);
+
+        for (size_t i = 0; i < 4; i++) {
+            vs[i].UV1 /= textureSize;
+            vs[i].UV2 = Vector2F();
+            vs[i].Col = color;
+            bucket->vertexes.emplace_back(vs[i]);
+        }
+
+        for (const auto index : {0, 1, 2, 2, 3, 0}) {
+            bucket->indexes.emplace_back(base + index);
+        }
+    });
+
+    FlushTextBatchBucket();
+
+    // 次のフレームまでテクスチャを保持しない
+    textBatchBucket_.texture = nullptr;
+    textBatchBucket_.material = nullptr;
+}
+
+void Renderer::FlushTextBatchBucket() {
+    auto& bucket = textBatchBucket_;
+    if (bucket.indexes.size() == 0) return;
+
+    batchRenderer_->Draw(
+            bucket.vertexes.data(),
+            bucket.indexes.data(),
+            static_cast<int32_t>(bucket.vertexes.size()),
+            static_cast<int32_t>(bucket.indexes.size()),
+            bucket.texture,
+            bucket.material,
+            nullptr);
+
+    bucket.vertexes.clear();
+    bucket.indexes.clear();
+}
+
 void Renderer::SetCamera(std::shared_ptr<RenderedCamera> camera) {
     std::shared_ptr<RenderTexture> texture;
     if (camera->GetTargetTexture() != nullptr) {
@@ -17,6 +17,7 @@ namespace Altseed2 {
 class Texture2D;
 class RenderedSprite;
 class RenderedText;
+class TextBatch;
 class RenderedPolygon;
 class RenderedCamera;
 class CommandList;
@@ -32,6 +33,20 @@ private:
     std::vector<std::shared_ptr<RenderedCamera>> cameras_;
     std::shared_ptr<RenderedCamera> currentCamera_;
 
+#if !USE_CBG
+    //! consecutive quads of TextBatch which share texture and material (reused between frames)
+    struct TextBatchBucket {
+        std::shared_ptr<TextureBase> texture;
+        std::shared_ptr<Material> material;
+        std::vector<BatchVertex> vertexes;
+        std::vector<int32_t> indexes;
+    };
+
+    TextBatchBucket textBatchBucket_;
+
+    void FlushTextBatchBucket();
+#endif
+
 public:
     Renderer(std::shared_ptr<Window> window, std::shared_ptr<Graphics> graphics, std::shared_ptr<CullingSystem> cullingSystem);
     virtual ~Renderer();
@@ -45,9 +60,16 @@ public:
     void DrawPolygon(std::shared_ptr<RenderedPolygon> polygon);
     void DrawSprite(std::shared_ptr<RenderedSprite> sprite);
     void DrawText(std::shared_ptr<RenderedText> text);
+    //! texts are drawn in the order they are added, so overlapping texts are drawn as with DrawText
+    void DrawTextBatch(std::shared_ptr<TextBatch> batch);
 
     void Render();
 
+#if !USE_CBG
+    //! number of batches drawn since the last Render
+    int32_t GetBatchCount() const { return batchRenderer_->GetBatchCount(); }
+#endif
+
     void SetCamera(std::shared_ptr<RenderedCamera> camera);
     void ResetCamera();
 };
@@ -0,0 +1,112 @@
+#include "TextBatch.h"
+
+#include "../../Common/StringHelper.h"
+
+namespace Altseed2 {
+
+std::shared_ptr<TextBatch> TextBatch::Create() {
+    auto t = MakeAsdShared<TextBatch>();
+    t->SetAlphaBlend(AlphaBlend::Normal());
+    t->SetMaterialGlyph(nullptr);
+    t->SetMaterialImage(nullptr);
+    t->SetFont(nullptr);
+    t->SetFontSize(32);
+    t->SetIsEnableKerning(true);
+    return t;
+}
+
+void TextBatch::Add(const char16_t* text, const Vector2F& position, const Color& color) {
+    if (text == nullptr) return;
+
+    Entry entry;
+    entry.TextOffset = texts_.size();
+    entry.TextLength = std::char_traits<char16_t>::length(text);
+    entry.Position = position;
+    entry.TextColor = color;
+
+    if (entry.TextLength == 0) return;
+
+    texts_.append(text, entry.TextLength);
+    entries_.emplace_back(entry);
+}
+
+void TextBatch::Clear() {
+    texts_.clear();
+    entries_.clear();
+}
+
+void TextBatch::IterateTexts(std::function<void(const Color& color, Vector2F pos, RectF src, float texScale, std::shared_ptr<TextureBase>& texture, bool isGlyph)> doEachText) {
+    const auto font = GetFont();
+    if (font == nullptr || doEachText == nullptr) return;
+
+    const auto fontSize = GetFontSize();
+    if (fontSize == 0.0f) return;
+
+    // フォントに依存する値はまとめて一度だけ計算する
+    const auto samplingSize = (float)font->GetSamplingSize();
+    const auto fontScale = fontSize / font->GetEmSize();
+    const auto glyphScale = samplingSize / (font->GetAscent() - font->GetDescent());
+    const auto ascent = font->GetAscent() * fontScale;
+    const auto lineSpace = font->GetLineGap() * fontScale;
+    const auto isEnableKerning = GetIsEnableKerning();
+
+    for (const auto& entry : entries_) {
+        const auto characters = texts_.data() + entry.TextOffset;
+        const auto length = entry.TextLength;
+
+        Vector2F offset = entry.Position;
+
+        for (size_t i = 0; i < length; i++) {
+            char32_t tmp = 0;
+            ConvChU16ToU32({characters[i], i + 1 < length ? characters[i + 1] : u'\0'}, tmp);
+            int32_t character = static_cast<int32_t>(tmp);
+
+            if (character == '\n') {
+                offset = Vector2F(entry.Position.X, offset.Y + lineSpace);
+                continue;
+            }
+
+            // Surrogate pair
+            if (characters[i] >= 0xD800 && characters[i] <= 0xDBFF) {
+                i++;
+            }
+
+            RectF src;
+            Vector2F pos;
+            float texScale;
+            std::shared_ptr<Glyph> glyph = nullptr;
+
+            auto texture = font->GetImageGlyph(character);
+
+            if (texture != nullptr) {
+                auto texSize = texture->GetSize();
+                src = RectF(0, 0, texSize.X, texSize.Y);
+                pos = offset + Vector2F(0, ascent - fontSize);
+                texScale = fontSize / texSize.Y;
+                offset.X += (float)texSize.X * fontSize / texSize.Y;
+            } else {
+                glyph = font->GetGlyph(character);
+                if (glyph == nullptr) continue;
+
+                texture = font->GetFontTexture(glyph->GetTextureIndex());
+
+                auto glyphPos = glyph->GetPosition();
+                auto glyphSize = glyph->GetSize();
+                src = RectF(glyphPos.X, glyphPos.Y, glyphSize.X, glyphSize.Y);
+                pos = offset + Vector2F(0, ascent) + glyph->GetOffset() * fontScale;
+                texScale = fontScale / glyphScale;
+                offset.X += glyph->GetAdvance() * fontScale;
+            }
+
+            doEachText(entry.TextColor, pos, src, texScale, texture, glyph != nullptr);
+
+            // kerning
+            if (isEnableKerning && i + 1 < length) {
+                ConvChU16ToU32({characters[i + 1], i + 2 < length ? characters[i + 2] : u'\0'}, tmp);
+                offset.X += font->GetKerning(character, static_cast<int32_t>(tmp)) * fontScale;
+            }
+        }
+    }
+}
+
+}  // namespace Altseed2
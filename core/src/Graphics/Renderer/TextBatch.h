@@ -0,0 +1,72 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "../../BaseObject.h"
+#include "../../Math/RectF.h"
+#include "../../Math/Vector2F.h"
+#include "../Color.h"
+#include "../Font.h"
+#include "../Material.h"
+
+namespace Altseed2 {
+
+//! 同じフォントで描画する多数の文字列をまとめて扱う
+class TextBatch : public BaseObject {
+private:
+    struct Entry {
+        size_t TextOffset;
+        size_t TextLength;
+        Vector2F Position;
+        Color TextColor;
+    };
+
+    AlphaBlend alphaBlend_;
+    std::shared_ptr<Material> materialGlyph_;
+    std::shared_ptr<Material> materialImage_;
+    std::shared_ptr<Font> font_;
+    float fontSize_;
+    bool isEnableKerning_;
+
+    //! all added texts are stored in one buffer
+    std::u16string texts_;
+    std::vector<Entry> entries_;
+
+public:
+    static std::shared_ptr<TextBatch> Create();
+
+    AlphaBlend GetAlphaBlend() const { return alphaBlend_; }
+    void SetAlphaBlend(AlphaBlend alphaBlend) { alphaBlend_ = alphaBlend; }
+
+    std::shared_ptr<Material> GetMaterialGlyph() const { return materialGlyph_; }
+    void SetMaterialGlyph(const std::shared_ptr<Material>& material) { materialGlyph_ = material; }
+
+    std::shared_ptr<Material> GetMaterialImage() const { return materialImage_; }
+    void SetMaterialImage(const std::shared_ptr<Material>& material) { materialImage_ = material; }
+
+    std::shared_ptr<Font> GetFont() const { return font_; }
+    void SetFont(const std::shared_ptr<Font>& font) { font_ = font; }
+
+    float GetFontSize() const { return fontSize_; }
+    void SetFontSize(float fontSize) { fontSize_ = fontSize; }
+
+    bool GetIsEnableKerning() const { return isEnableKerning_; }
+    void SetIsEnableKerning(bool isEnableKerning) { isEnableKerning_ = isEnableKerning; }
+
+    int32_t GetCount() const { return static_cast<int32_t>(entries_.size()); }
+
+    void Add(const char16_t* text, const Vector2F& position, const Color& color);
+
+    void Clear();
+
+#if !USE_CBG
+
+    //! Lay out all texts horizontally in one pass
+    void IterateTexts(std::function<void(const Color& color, Vector2F pos, RectF src, float texScale, std::shared_ptr<TextureBase>& texture, bool isGlyph)> doEachText);
+
+#endif
+};
+
+}  // namespace Altseed2
@@ -3,11 +3,20 @@
 #include <libpng16/png.h>
 #include <stb_image.h>
 
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <unordered_map>
+
+#include "../Common/Array.h"
+#include "../Common/Profiler.h"
 #include "../Common/Resources.h"
 #include "../Common/StringHelper.h"
 #include "../IO/File.h"
 #include "../Logger/Log.h"
+#include "../System/AsyncLoader.h"
 #include "Graphics.h"
+#include "ImageHelper.h"
 
 namespace Altseed2 {
 std::mutex Texture2D::mtx;
@@ -18,9 +27,8 @@ Texture2D::Texture2D(const std::shared_ptr<Resources>& resources, const std::sha
 }
 
 Texture2D::~Texture2D() {
-    std::lock_guard<std::mutex> lock(mtx);
     if (sourcePath_ != u"") {
-        resources_->GetResourceContainer(ResourceType::Texture2D)->Unregister(sourcePath_);
+        resources_->GetResourceContainer(ResourceType::Texture2D)->Unregister(sourcePath_, this);
         resources_ = nullptr;
     }
 }
@@ -38,10 +46,8 @@ std::shared_ptr<Texture2D> Texture2D::Load(const char16_t* path) {
         return nullptr;
     }
 
-    std::lock_guard<std::mutex> lock(mtx);
-
     auto cache = std::dynamic_pointer_cast<Texture2D>(resources->GetResourceContainer(ResourceType::Texture2D)->Get(path));
-    if (cache != nullptr && cache->GetRef() > 0) {
+    if (cache != nullptr) {
         return cache;
     }
 
@@ -59,20 +65,227 @@ std::shared_ptr<Texture2D> Texture2D::Load(const char16_t* path) {
         return nullptr;
     }
 
-    auto llgiTexture = Graphics::GetInstance()->CreateTexture(data, w, h, channel);
+    auto res = CreateFromImage(resources, path, data, w, h, channel);
+    stbi_image_free(data);
+
+    return res;
+}
+
+std::shared_future<std::shared_ptr<Texture2D>> Texture2D::LoadAsync(const char16_t* path) {
+    RETURN_IF_NULL(path, AsyncLoader::MakeReadyFuture<Texture2D>(nullptr));
+
+    auto loader = AsyncLoader::GetInstance();
+    if (loader == nullptr || Resources::GetInstance() == nullptr) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Texture2D::LoadAsync: Core is not initialized.");
+        return AsyncLoader::MakeReadyFuture<Texture2D>(nullptr);
+    }
+
+    auto promise = std::make_shared<std::promise<std::shared_ptr<Texture2D>>>();
+    auto future = promise->get_future().share();
+    const std::u16string path_ = path;
+
+    loader->PostIO([promise, path_]() -> void {
+        auto resources = Resources::GetInstance();
+
+        auto cache = std::dynamic_pointer_cast<Texture2D>(resources->GetResourceContainer(ResourceType::Texture2D)->Get(path_.c_str()));
+        if (cache != nullptr) {
+            promise->set_value(cache);
+            return;
+        }
+
+        auto file = StaticFile::Create(path_.c_str());
+        if (file == nullptr) {
+            Log::GetInstance()->Error(LogCategory::Core, u"Texture2D::LoadAsync: Failed to create file from '{0}'", utf16_to_utf8(path_).c_str());
+            promise->set_value(nullptr);
+            return;
+        }
+
+        AsyncLoader::GetInstance()->PostDecode([promise, path_, file, resources]() -> void {
+            int32_t w, h, channel;
+            uint8_t* data = (uint8_t*)stbi_load_from_memory((stbi_uc*)file->GetData(), file->GetSize(), &w, &h, &channel, 0);
+
+            if (data == nullptr) {
+                Log::GetInstance()->Error(LogCategory::Core, u"Texture2D::LoadAsync: Failed to load data from '{0}'", utf16_to_utf8(path_).c_str());
+                promise->set_value(nullptr);
+                return;
+            }
+
+            std::shared_ptr<uint8_t> image(data, stbi_image_free);
+
+            AsyncLoader::GetInstance()->PostMain([promise, path_, resources, image, w, h, channel]() -> void {
+                // the same path may have been loaded while decoding
+                auto cache = std::dynamic_pointer_cast<Texture2D>(resources->GetResourceContainer(ResourceType::Texture2D)->Get(path_.c_str()));
+                if (cache != nullptr) {
+                    promise->set_value(cache);
+                    return;
+                }
+
+                promise->set_value(CreateFromImage(resources, path_, image.get(), w, h, channel));
+            });
+        });
+    });
+
+    return future;
+}
+
+std::vector<std::shared_ptr<Texture2D>> Texture2D::LoadBatch(const std::vector<std::u16string>& paths, int32_t maxDecodedCount) {
+    EASY_BLOCK("Altseed2(C++).Texture2D.LoadBatch");
+
+    std::vector<std::shared_ptr<Texture2D>> results(paths.size());
+
+    auto resources = Resources::GetInstance();
+    if (resources == nullptr) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Resources is not initialized.");
+        return results;
+    }
+
+    auto loader = AsyncLoader::GetInstance();
+    if (loader == nullptr) {
+        for (size_t i = 0; i < paths.size(); i++) {
+            results[i] = Load(paths[i].c_str());
+        }
+        return results;
+    }
+
+    // indexes to decode, without cached textures and duplicated paths
+    std::vector<size_t> decodingIndexes;
+    std::unordered_map<std::u16string, size_t> firstIndexes;
+    for (size_t i = 0; i < paths.size(); i++) {
+        if (!firstIndexes.emplace(paths[i], i).second) continue;
+
+        auto cache = std::dynamic_pointer_cast<Texture2D>(resources->GetResourceContainer(ResourceType::Texture2D)->Get(paths[i]));
+        if (cache != nullptr) {
+            results[i] = cache;
+        } else {
+            decodingIndexes.push_back(i);
+        }
+    }
+
+    struct Decoded {
+        size_t Index;
+        std::vector<uint8_t> Pixels;
+        int32_t Width;
+        int32_t Height;
+    };
+
+    struct State {
+        std::mutex Mtx;
+        std::condition_variable Cv;
+        std::deque<Decoded> Completed;
+
+        void Complete(Decoded&& decoded) {
+            std::lock_guard<std::mutex> lock(Mtx);
+            Completed.push_back(std::move(decoded));
+            Cv.notify_one();
+        }
+    };
+
+    auto state = std::make_shared<State>();
+
+    const auto decodeThreadCount = static_cast<size_t>(loader->GetDecodeThreadCount());
+    const auto maxInFlight = maxDecodedCount > 0 ? static_cast<size_t>(maxDecodedCount) : decodeThreadCount * 2;
+
+    size_t next = 0;
+    size_t inFlight = 0;
+    std::deque<Decoded> completed;
+
+    while (next < decodingIndexes.size() || inFlight > 0) {
+        // decoded images waiting for the upload are bounded to limit the memory
+        while (next < decodingIndexes.size() && inFlight < maxInFlight) {
+            const auto index = decodingIndexes[next++];
+            const auto path = paths[index];
+            inFlight++;
+
+            // files are read on the I/O pool and handed to the decode pool
+            loader->PostIO([state, index, path]() -> void {
+                Decoded decoded;
+                decoded.Index = index;
+                decoded.Width = 0;
+                decoded.Height = 0;
+
+                auto file = StaticFile::Create(path.c_str());
+                if (file == nullptr) {
+                    Log::GetInstance()->Error(LogCategory::Core, u"Texture2D::LoadBatch: Failed to create file from '{0}'", utf16_to_utf8(path).c_str());
+                    state->Complete(std::move(decoded));
+                    return;
+                }
+
+                AsyncLoader::GetInstance()->PostDecode([state, path, file, decoded]() mutable -> void {
+                    int32_t w, h, channel;
+                    uint8_t* data = (uint8_t*)stbi_load_from_memory((stbi_uc*)file->GetData(), file->GetSize(), &w, &h, &channel, 0);
+
+                    if (data == nullptr) {
+                        Log::GetInstance()->Error(LogCategory::Core, u"Texture2D::LoadBatch: Failed to load data from '{0}'", utf16_to_utf8(path).c_str());
+                    } else {
+                        // expand to RGBA here so that the upload is a plain copy
+                        decoded.Pixels.resize(static_cast<size_t>(w) * h * 4);
+                        if (ImageHelper::ConvertToRGBA8(data, channel, static_cast<int64_t>(w) * h, decoded.Pixels.data())) {
+                            decoded.Width = w;
+                            decoded.Height = h;
+                        } else {
+                            decoded.Pixels.clear();
+                        }
+                        stbi_image_free(data);
+                    }
+
+                    state->Complete(std::move(decoded));
+                });
+            });
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(state->Mtx);
+            state->Cv.wait(lock, [&state]() -> bool { return !state->Completed.empty(); });
+            completed.swap(state->Completed);
+        }
+
+        for (auto& decoded : completed) {
+            inFlight--;
+            if (decoded.Pixels.empty()) continue;
+
+            const auto& path = paths[decoded.Index];
+
+            auto cache = std::dynamic_pointer_cast<Texture2D>(resources->GetResourceContainer(ResourceType::Texture2D)->Get(path));
+            if (cache != nullptr) {
+                results[decoded.Index] = cache;
+            } else {
+                results[decoded.Index] = CreateFromImage(resources, path, decoded.Pixels.data(), decoded.Width, decoded.Height, 4);
+            }
+        }
+        completed.clear();
+    }
+
+    for (size_t i = 0; i < paths.size(); i++) {
+        const auto first = firstIndexes[paths[i]];
+        if (first != i) results[i] = results[first];
+    }
+
+    return results;
+}
+
+std::shared_ptr<Texture2D> Texture2D::CreateFromImage(
+        const std::shared_ptr<Resources>& resources, const std::u16string& path, uint8_t* data, int32_t width, int32_t height, int32_t channel) {
+    std::shared_ptr<LLGI::Texture> llgiTexture;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        llgiTexture = Graphics::GetInstance()->CreateTexture(data, width, height, channel);
+    }
+
     if (llgiTexture == nullptr) {
-        stbi_image_free(data);
         Log::GetInstance()->Error(LogCategory::Core, u"Texture2D::Load: Failed to CreateTexture from '{0}'", utf16_to_utf8(path).c_str());
         return nullptr;
     }
 
     auto res = MakeAsdShared<Texture2D>(resources, llgiTexture, path);
-    resources->GetResourceContainer(ResourceType::Texture2D)
-            ->Register(path, std::make_shared<ResourceContainer::ResourceInfomation>(res, path));
+    auto registered = std::dynamic_pointer_cast<Texture2D>(resources->GetResourceContainer(ResourceType::Texture2D)
+                                                                   ->GetOrRegister(path, std::make_shared<ResourceContainer::ResourceInfomation>(res, path)));
 
-    stbi_image_free(data);
+    // the same path may have been loaded by another thread meanwhile
+    if (registered != res) {
+        res->sourcePath_.clear();
+    }
 
-    return res;
+    return registered;
 }
 
 std::shared_ptr<Texture2D> Texture2D::Create(Vector2I size) {
@@ -83,4 +296,27 @@ std::shared_ptr<Texture2D> Texture2D::Create(Vector2I size) {
     return MakeAsdShared<Texture2D>(nullptr, llgiTexture, u"");
 }
 
+bool Texture2D::Write(std::shared_ptr<Int8Array> data) {
+    RETURN_IF_NULL(data, false);
+
+    const auto size = GetMemorySize();
+    if (data->GetCount() != size) {
+        Log::GetInstance()->Error(
+                LogCategory::Core, u"Texture2D::Write: the size of data ({0}) does not match the size of the texture ({1})", data->GetCount(), size);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto buf = GetNativeTexture()->Lock();
+    if (buf == nullptr) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Texture2D::Write: Failed to lock the texture");
+        return false;
+    }
+
+    std::memcpy(buf, data->GetPointer(), static_cast<size_t>(size));
+    GetNativeTexture()->Unlock();
+    return true;
+}
+
 }  // namespace Altseed2
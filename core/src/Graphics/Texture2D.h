@@ -2,6 +2,7 @@
 
 #include <LLGI.Base.h>
 
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
@@ -15,20 +16,47 @@
 #include "TextureBase.h"
 
 namespace Altseed2 {
+
+template <typename T>
+class Array;
+using Int8Array = Array<int8_t>;
+
 class Texture2D : public TextureBase {
 private:
+    //! serializes uploads to the GPU. the resource container is not locked by this
     static std::mutex mtx;
 
     std::u16string sourcePath_;
     std::shared_ptr<Resources> resources_ = nullptr;
 
+#if !USE_CBG
+    //! creates a texture from decoded pixels and registers it. returns the texture already registered if any
+    static std::shared_ptr<Texture2D> CreateFromImage(
+            const std::shared_ptr<Resources>& resources, const std::u16string& path, uint8_t* data, int32_t width, int32_t height, int32_t channel);
+#endif
+
 public:
     Texture2D(const std::shared_ptr<Resources>& resources, const std::shared_ptr<LLGI::Texture>& texture, const std::u16string& sourcePath);
     virtual ~Texture2D();
 
     bool Reload() override;
     static std::shared_ptr<Texture2D> Load(const char16_t* path);
+
+#if !USE_CBG
+    //! reads and decodes in background threads and uploads in Core::DoEvent
+    //! the future is not completed until Core::DoEvent is called on the main thread
+    static std::shared_future<std::shared_ptr<Texture2D>> LoadAsync(const char16_t* path);
+
+    //! decodes images in parallel and uploads them on the calling thread as they are decoded
+    //! at most maxDecodedCount decoded images are kept waiting for the upload (0 means twice the decode threads)
+    //! results are in the same order as paths, and nullptr for the failed ones
+    static std::vector<std::shared_ptr<Texture2D>> LoadBatch(const std::vector<std::u16string>& paths, int32_t maxDecodedCount = 0);
+#endif
     static std::shared_ptr<Texture2D> Create(Vector2I size);
+
+    //! uploads pixels in the format of the texture. data is read in place, so a borrowed array is not copied
+    bool Write(std::shared_ptr<Int8Array> data);
+
     const char16_t* GetPath() const;
 };
 }  // namespace Altseed2
@@ -113,6 +113,27 @@ void TextureBase::SetFilterType(TextureFilterType filterMode) { filterMode_ = fi
 
 TextureFormatType TextureBase::GetFormat() const { return format_; }
 
+int64_t TextureBase::GetMemorySize() const {
+    int64_t bytesPerPixel = 4;
+    switch (format_) {
+        case TextureFormatType::R16G16B16A16_FLOAT:
+            bytesPerPixel = 8;
+            break;
+        case TextureFormatType::R32G32B32A32_FLOAT:
+            bytesPerPixel = 16;
+            break;
+        case TextureFormatType::D32S8:
+            bytesPerPixel = 8;
+            break;
+        case TextureFormatType::R8_UNORM:
+            bytesPerPixel = 1;
+            break;
+        default:
+            break;
+    }
+    return static_cast<int64_t>(size_.X) * size_.Y * bytesPerPixel;
+}
+
 bool TextureBase::Save(const char16_t* path) {
     FILE* f;
 #ifdef _WIN32
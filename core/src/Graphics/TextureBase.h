@@ -75,6 +75,8 @@ public:
 
     std::shared_ptr<LLGI::Texture>& GetNativeTexture() { return texture_; }
 
+    int64_t GetMemorySize() const override;
+
 #endif
 };
 }  // namespace Altseed2
@@ -2,13 +2,15 @@
 
 #include <assert.h>
 
+#include <algorithm>
+
 #include "../Common/StringHelper.h"
 
 namespace Altseed2 {
-BaseFileReader::BaseFileReader(const std::u16string& path) : BaseObject(), path_(path), length_(-1), position_(0), file_(nullptr) {
+BaseFileReader::BaseFileReader(const std::u16string& path) : BaseObject(), path_(path), length_(-1), position_(0), contentHash_(0), file_(nullptr) {
 }
 
-BaseFileReader::BaseFileReader(std::shared_ptr<std::ifstream>& file, const std::u16string& path) : BaseObject(), path_(path), length_(-1), position_(0), file_(file) {
+BaseFileReader::BaseFileReader(std::shared_ptr<std::ifstream>& file, const std::u16string& path) : BaseObject(), path_(path), length_(-1), position_(0), contentHash_(0), file_(file) {
     ASD_ASSERT(file_ != nullptr && file_->good(), "bad ifstream");
 }
 
@@ -31,35 +33,77 @@ int64_t BaseFileReader::GetSize() {
     return length_;
 }
 
-void BaseFileReader::ReadBytes(std::vector<uint8_t>& buffer, const int64_t count) {
+int64_t BaseFileReader::Read(void* buffer, const int64_t count) {
     ASD_ASSERT(file_ != nullptr, "file_ is null");
     const auto size = GetSize();
 
     std::unique_lock<std::recursive_mutex> lock(readerMtx_);
 
-    if (position_ + count > GetSize() || count < 0) {
+    const auto readSize = std::min(count, size - position_);
+    if (readSize <= 0) return 0;
+
+    file_->read(static_cast<char*>(buffer), readSize);
+    const auto actual = static_cast<int64_t>(file_->gcount());
+
+    position_ += actual;
+    return actual;
+}
+
+int64_t BaseFileReader::ReadScatter(const ReadSegment* segments, const int32_t count) {
+    std::unique_lock<std::recursive_mutex> lock(readerMtx_);
+
+    int64_t total = 0;
+    for (int32_t i = 0; i < count; i++) {
+        const auto read = Read(segments[i].Data, segments[i].Size);
+        total += read;
+        if (read < segments[i].Size) break;
+    }
+    return total;
+}
+
+int64_t BaseFileReader::ReadRanges(const ReadRange* ranges, const int32_t count) {
+    const auto size = GetSize();
+
+    std::unique_lock<std::recursive_mutex> lock(readerMtx_);
+    const auto tmp = position_;
+
+    int64_t total = 0;
+    for (int32_t i = 0; i < count; i++) {
+        if (ranges[i].Offset < 0 || ranges[i].Offset >= size) continue;
+        Seek(ranges[i].Offset);
+        total += Read(ranges[i].Data, ranges[i].Size);
+    }
+
+    if (tmp < size) Seek(tmp);
+    position_ = tmp;
+    return total;
+}
+
+void BaseFileReader::ReadBytes(std::vector<uint8_t>& buffer, const int64_t count) {
+    std::unique_lock<std::recursive_mutex> lock(readerMtx_);
+
+    if (count < 0 || position_ + count > GetSize()) {
         buffer.resize(0);
         buffer.clear();
         return;
     }
 
     buffer.resize(count);
-    file_->read(reinterpret_cast<char*>(&buffer[0]), count);
-
-    position_ += count;
+    if (count > 0) Read(buffer.data(), count);
 }
-uint32_t BaseFileReader::ReadUInt32() {
-    std::vector<uint8_t> buffer;
-    ReadBytes(buffer, sizeof(uint32_t));
 
-    return *reinterpret_cast<const uint32_t*>(buffer.data());
+uint32_t BaseFileReader::ReadUInt32() {
+    uint32_t value = 0;
+    Read(&value, sizeof(uint32_t));
+    return value;
 }
-uint64_t BaseFileReader::ReadUInt64() {
-    std::vector<uint8_t> buffer;
-    ReadBytes(buffer, sizeof(uint64_t));
 
-    return *reinterpret_cast<const uint64_t*>(buffer.data());
+uint64_t BaseFileReader::ReadUInt64() {
+    uint64_t value = 0;
+    Read(&value, sizeof(uint64_t));
+    return value;
 }
+
 void BaseFileReader::ReadAllBytes(std::vector<uint8_t>& buffer) {
     std::unique_lock<std::recursive_mutex> lock(readerMtx_);
     const auto tmp = position_;
@@ -82,7 +126,7 @@ void BaseFileReader::Seek(const int64_t offset, const SeekOrigin origin) {
         case SeekOrigin::Current:
             assert(0 <= position_ + offset && position_ + offset < size);
             file_->seekg(offset, file_->cur);
-            position_ = offset + offset;
+            position_ += offset;
             break;
         case SeekOrigin::End:
             assert(0 <= offset + size && offset <= 0 && offset);
@@ -97,6 +141,15 @@ void BaseFileReader::Seek(const int64_t offset, const SeekOrigin origin) {
 
 bool BaseFileReader::GetIsInPackage() const { return false; }
 
+const void* BaseFileReader::GetMappedData(std::shared_ptr<MappedFile>& mapping) {
+    mapping = FileSystem::MapFile(path_);
+    if (mapping == nullptr || mapping->GetSize() != GetSize()) {
+        mapping = nullptr;
+        return nullptr;
+    }
+    return mapping->GetData();
+}
+
 void BaseFileReader::Close() {
     if (!GetIsInPackage() && file_ != nullptr) {
         file_->close();
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "../BaseObject.h"
+#include "../Platform/FileSystem.h"
 
 #if !USE_CBG
 
@@ -16,6 +17,19 @@ enum class SeekOrigin { Begin,
                         Current,
                         End };
 
+//! destination of ReadScatter
+struct ReadSegment {
+    void* Data;
+    int64_t Size;
+};
+
+//! destination and source offset of ReadRanges
+struct ReadRange {
+    int64_t Offset;
+    void* Data;
+    int64_t Size;
+};
+
 class BaseFileReader : public BaseObject {
 private:
     std::shared_ptr<std::ifstream> file_;
@@ -24,6 +38,7 @@ protected:
     int64_t position_;
     int64_t length_;
     std::u16string path_;
+    uint64_t contentHash_;
     std::recursive_mutex readerMtx_;
 
     //! for PackFileReader
@@ -38,7 +53,17 @@ public:
 
     virtual int64_t GetSize();
 
-    virtual void ReadBytes(std::vector<uint8_t>& buffer, const int64_t count);
+    //! reads up to count bytes into buffer and returns the number of bytes read
+    virtual int64_t Read(void* buffer, const int64_t count);
+
+    //! reads consecutive bytes into segments in order and returns the total number of bytes read
+    int64_t ReadScatter(const ReadSegment* segments, const int32_t count);
+
+    //! reads each range from its offset and returns the total number of bytes read. the position is not changed
+    int64_t ReadRanges(const ReadRange* ranges, const int32_t count);
+
+    //! resizes buffer to count, or to 0 if count bytes can not be read
+    void ReadBytes(std::vector<uint8_t>& buffer, const int64_t count);
     uint32_t ReadUInt32();
     uint64_t ReadUInt64();
     void ReadAllBytes(std::vector<uint8_t>& buffer);
@@ -47,6 +72,14 @@ public:
 
     virtual bool GetIsInPackage() const;
 
+    //! returns the whole content without copying, or nullptr if it can not be mapped
+    //! the content is valid while mapping is alive
+    virtual const void* GetMappedData(std::shared_ptr<MappedFile>& mapping);
+
+    //! hash of the content known without reading it (see PackBuilder::GetContentHash), or 0
+    uint64_t GetContentHash() const { return contentHash_; }
+    void SetContentHash(uint64_t value) { contentHash_ = value; }
+
     //! for core
     void Close();
 };
@@ -2,12 +2,15 @@
 
 #include <zip.h>
 
+#include <algorithm>
 #include <fstream>
 #include <stack>
+#include <unordered_set>
 
 #include "../Common/StringHelper.h"
 #include "../Logger/Log.h"
 #include "../Platform/FileSystem.h"
+#include "PackBuilder.h"
 #include "PackFileReader.h"
 
 namespace Altseed2 {
@@ -19,6 +22,14 @@ bool File::Initialize(std::shared_ptr<Resources> resources) {
 
     instance->m_resources = resources;
 
+    // only the files reported by the watcher are reloaded while hot reload is enabled
+    if (resources != nullptr) {
+        resources->SetChangedPathsProvider([](std::vector<std::u16string>& paths) -> bool {
+            auto file = File::GetInstance();
+            return file != nullptr && file->PopChangedPaths(paths);
+        });
+    }
+
     std::lock_guard<std::mutex> lock(instance->m_rootMtx);
     // add default file root
     instance->m_roots.push_back(std::make_shared<FileRoot>(u"."));
@@ -26,44 +37,69 @@ bool File::Initialize(std::shared_ptr<Resources> resources) {
     return true;
 }
 
-void File::Terminate() { instance = nullptr; }
+void File::Terminate() {
+    if (instance != nullptr && instance->m_resources != nullptr) {
+        instance->m_resources->SetChangedPathsProvider(nullptr);
+    }
+    instance = nullptr;
+}
 
 std::shared_ptr<File>& File::GetInstance() { return instance; }
 
 std::shared_ptr<BaseFileReader> File::CreateFileReader(const char16_t* path) {
     RETURN_IF_NULL(path, nullptr);
+    return CreateFileReader(PathTable::Intern(path));
+}
+
+std::shared_ptr<BaseFileReader> File::CreateFileReader(const std::shared_ptr<const InternedPath>& path) {
+    RETURN_IF_NULL(path, nullptr);
 
-    std::shared_ptr<BaseFileReader> reader = nullptr;
     std::lock_guard<std::mutex> lock(m_rootMtx);
-    for (auto i = m_roots.rbegin(), e = m_roots.rend(); i != e; ++i) {
-        if ((*i)->IsPack()) {
-            if ((*i)->GetPackFile()->Exists(path)) {
-                auto zipFile = (*i)->GetPackFile()->Load(path);
-                if (zipFile == nullptr) {
-                    // TODO: log failure to get zip_file
-                    continue;
-                }
-                zip_stat_t* stat = (*i)->GetPackFile()->GetZipStat(path);
-                reader = MakeAsdShared<PackFileReader>(zipFile, path, stat);
-                break;
+
+    ResolvedPath storage;
+    auto startRoot = static_cast<int32_t>(m_roots.size()) - 1;
+
+    while (true) {
+        const auto resolved = ResolvePath(path, startRoot, storage);
+        if (!resolved->IsFound) return nullptr;
+
+        if (resolved->RootIndex >= 0 && m_roots[resolved->RootIndex]->IsPack()) {
+            const auto& root = m_roots[resolved->RootIndex];
+            const auto entry = resolved->Entry;
+
+            // stored entries are served from the mapping of the pack without decompression
+            auto storedData = root->GetPackFile()->GetStoredData(*entry);
+            if (storedData != nullptr) {
+                auto reader = MakeAsdShared<PackFileReader>(root->GetPackFile()->GetMapping(), storedData, entry->Size, path->Path);
+                reader->SetContentHash(entry->ContentHash);
+                return reader;
+            }
+
+            auto zipFile = root->GetPackFile()->Load(*entry);
+            if (zipFile != nullptr) {
+                zip_stat_t* stat = root->GetPackFile()->GetZipStat(*entry);
+                auto reader = MakeAsdShared<PackFileReader>(zipFile, path->Path, stat);
+                reader->SetContentHash(entry->ContentHash);
+                return reader;
             }
-        } else if (FileSystem::GetIsFile((*i)->GetPath() + path)) {
-            auto file = GetStream((*i)->GetPath() + path);
-            if (file == nullptr)
-                return nullptr;
-            reader = MakeAsdShared<BaseFileReader>(file, (*i)->GetPath() + path);
-            break;
+
+            Log::GetInstance()->Error(
+                    LogCategory::Core, u"File::CreateFileReader: Failed to open '{0}' in '{1}'", utf16_to_utf8(path->Path).c_str(), utf16_to_utf8(root->GetPath()).c_str());
+
+            // look for the path in the roots below
+            startRoot = resolved->RootIndex - 1;
+            continue;
         }
-    }
 
-    if (reader == nullptr && FileSystem::GetIsFile(path)) {
-        auto file = GetStream(path);
-        if (file == nullptr)
+        auto fullPath = resolved->FullPath;
+        auto file = GetStream(fullPath);
+        if (file == nullptr) {
+            // the cached result is stale
+            m_pathCache.erase(path->Hash);
             return nullptr;
-        reader = MakeAsdShared<BaseFileReader>(file, path);
+        }
+        return MakeAsdShared<BaseFileReader>(file, fullPath);
     }
-
-    return reader;
 }
 
 bool File::AddRootDirectory(const char16_t* path) {
@@ -78,6 +114,10 @@ bool File::AddRootDirectory(const char16_t* path) {
 
     std::lock_guard<std::mutex> lock(m_rootMtx);
     m_roots.push_back(std::make_shared<FileRoot>(path_));
+    m_pathCache.clear();
+    if (m_pathWatcher != nullptr && !m_pathWatcher->AddDirectory(path_)) {
+        Log::GetInstance()->Warn(LogCategory::Core, u"File::AddRootDirectory: Failed to watch '{0}'", utf16_to_utf8(path_).c_str());
+    }
     return true;
 }
 
@@ -110,8 +150,12 @@ bool File::AddRootPackageWithPassword(const char16_t* path, const char16_t* pass
         return false;
     }
 
+    auto packFile = MakeAsdShared<PackFile>(zip_, path_, true);
+
     std::lock_guard<std::mutex> lock(m_rootMtx);
-    m_roots.push_back(std::make_shared<FileRoot>(path_, MakeAsdShared<PackFile>(zip_, true)));
+    m_roots.push_back(std::make_shared<FileRoot>(path_, packFile));
+    MergeIndex(static_cast<int32_t>(m_roots.size()) - 1);
+    m_pathCache.clear();
     return true;
 }
 
@@ -132,37 +176,236 @@ bool File::AddRootPackage(const char16_t* path) {
         return false;
     }
 
+    // the index of the pack is built here, outside of m_rootMtx
+    auto packFile = MakeAsdShared<PackFile>(zip_, path_);
+
     std::lock_guard<std::mutex> lock(m_rootMtx);
-    m_roots.push_back(std::make_shared<FileRoot>(path_, MakeAsdShared<PackFile>(zip_)));
+    m_roots.push_back(std::make_shared<FileRoot>(path_, packFile));
+    MergeIndex(static_cast<int32_t>(m_roots.size()) - 1);
+    m_pathCache.clear();
     return true;
 }
 
 void File::ClearRootDirectories() {
     std::lock_guard<std::mutex> lock(m_rootMtx);
     m_roots.clear();
+    m_vfsIndex.clear();
+    m_pathCache.clear();
 
     // add default file root
     m_roots.push_back(std::make_shared<FileRoot>(u"."));
+
+    ResetPathWatcher();
 }
 
 bool File::Exists(const char16_t* path) const {
     RETURN_IF_NULL(path, false);
 
-    auto path_ = FileSystem::NormalizePath(path);
+    const auto path_ = PathTable::Intern(path);
+
+    std::lock_guard<std::mutex> lock(m_rootMtx);
+
+    ResolvedPath storage;
+    return ResolvePath(path_, static_cast<int32_t>(m_roots.size()) - 1, storage)->IsFound;
+}
+
+bool File::GetIsPathCacheEnabled() const { return m_isPathCacheEnabled; }
+
+void File::SetIsPathCacheEnabled(bool value) {
+    std::lock_guard<std::mutex> lock(m_rootMtx);
+
+    if (m_isPathCacheEnabled == value) return;
+    m_isPathCacheEnabled = value;
+    m_pathCache.clear();
+
+    ResetPathWatcher();
+}
+
+void File::ClearPathCache() {
+    std::lock_guard<std::mutex> lock(m_rootMtx);
+    m_pathCache.clear();
+}
+
+bool File::GetIsHotReloadEnabled() const { return m_isHotReloadEnabled; }
+
+void File::SetIsHotReloadEnabled(bool value) {
+    std::lock_guard<std::mutex> lock(m_rootMtx);
+
+    if (m_isHotReloadEnabled == value) return;
+    m_isHotReloadEnabled = value;
+
+    {
+        std::lock_guard<std::mutex> changedLock(m_changedPathsMtx);
+        m_changedPaths.clear();
+    }
+
+    ResetPathWatcher();
+
+    if (value && m_pathWatcher == nullptr) {
+        Log::GetInstance()->Warn(LogCategory::Core, u"File::SetIsHotReloadEnabled: Changes of files can not be watched. Resources::Reload checks every resource.");
+    }
+}
+
+bool File::PopChangedPaths(std::vector<std::u16string>& paths) {
+    paths.clear();
+
+    std::lock_guard<std::mutex> lock(m_rootMtx);
+    if (!m_isHotReloadEnabled || m_pathWatcher == nullptr) return false;
+
+    std::vector<std::u16string> changedPaths;
+    {
+        std::lock_guard<std::mutex> changedLock(m_changedPathsMtx);
+        changedPaths.swap(m_changedPaths);
+    }
+
+    // a file may be saved several times and be under several roots
+    std::unordered_set<std::u16string> keys;
+    for (auto& path : changedPaths) {
+        // roots may be added with backslashes, while the watcher joins paths with slashes
+        std::replace(path.begin(), path.end(), u'\\', u'/');
+        keys.insert(path);
+
+        for (const auto& root : m_roots) {
+            if (root->IsPack()) continue;
+
+            auto rootPath = root->GetPath();
+            std::replace(rootPath.begin(), rootPath.end(), u'\\', u'/');
+            if (path.size() > rootPath.size() && path.compare(0, rootPath.size(), rootPath) == 0) {
+                keys.insert(path.substr(rootPath.size()));
+            }
+        }
+    }
+
+    paths.assign(keys.begin(), keys.end());
+    return true;
+}
+
+const File::ResolvedPath* File::ResolvePath(const std::shared_ptr<const InternedPath>& path, int32_t startRoot, ResolvedPath& storage) const {
+    const auto hash = path->Hash;
+    const bool isCached = m_isPathCacheEnabled && startRoot == static_cast<int32_t>(m_roots.size()) - 1;
+
+    if (isCached) {
+        if (m_isPathCacheDirty.exchange(false)) {
+            m_pathCache.clear();
+        }
+
+        auto it = m_pathCache.find(hash);
+        if (it != m_pathCache.end() && it->second.Path == path) {
+            return &it->second;
+        }
+    }
+
+    const auto& path_ = path->Path;
+
+    storage.Path = path;
+    storage.FullPath.clear();
+    storage.RootIndex = -1;
+    storage.Entry = nullptr;
+    storage.IsFound = false;
 
     if (FileSystem::GetIsAbsolutePath(path_)) {
-        return FileSystem::GetIsFile(path_);
+        storage.IsFound = FileSystem::GetIsFile(path_);
+        if (storage.IsFound) storage.FullPath = path_;
+    } else {
+        const PackFile::Entry* topEntry = nullptr;
+        const auto packRoot = FindPackRoot(path.get(), topEntry);
+
+        for (auto i = startRoot; i >= 0; i--) {
+            const auto& root = m_roots[i];
+            if (root->IsPack()) {
+                // packs above the topmost hit of the merged index do not contain the path
+                if (i > packRoot) continue;
+
+                auto entry = i == packRoot ? topEntry : root->GetPackFile()->Find(hash, path_);
+                if (entry == nullptr) continue;
+
+                storage.RootIndex = i;
+                storage.Entry = entry;
+                storage.IsFound = true;
+                break;
+            } else if (FileSystem::GetIsFile(root->GetPath() + path_)) {
+                storage.FullPath = root->GetPath() + path_;
+                storage.RootIndex = i;
+                storage.IsFound = true;
+                break;
+            }
+        }
+
+        if (!storage.IsFound && FileSystem::GetIsFile(path_)) {
+            storage.FullPath = path_;
+            storage.IsFound = true;
+        }
+    }
+
+    if (isCached) {
+        if (!storage.IsFound && m_pathCache.size() >= static_cast<size_t>(PathCacheMaxCount)) {
+            for (auto it = m_pathCache.begin(); it != m_pathCache.end();) {
+                it = it->second.IsFound ? std::next(it) : m_pathCache.erase(it);
+            }
+
+            // found paths are bounded by the files, but the cache is cleared if they fill it
+            if (m_pathCache.size() >= static_cast<size_t>(PathCacheMaxCount)) m_pathCache.clear();
+        }
+
+        return &(m_pathCache[hash] = storage);
+    }
+
+    return &storage;
+}
+
+void File::ResetPathWatcher() {
+    m_pathWatcher = nullptr;
+    m_isPathCacheDirty = false;
+
+    if (!m_isPathCacheEnabled && !m_isHotReloadEnabled) return;
+
+    const bool isHotReloadEnabled = m_isHotReloadEnabled;
+    m_pathWatcher = DirectoryWatcher::Create([this, isHotReloadEnabled](const std::u16string& path) -> void {
+        m_isPathCacheDirty = true;
+
+        if (isHotReloadEnabled) {
+            std::lock_guard<std::mutex> lock(m_changedPathsMtx);
+            m_changedPaths.push_back(path);
+        }
+    });
+    if (m_pathWatcher == nullptr) return;
+
+    for (const auto& root : m_roots) {
+        if (!root->IsPack() && !m_pathWatcher->AddDirectory(root->GetPath())) {
+            Log::GetInstance()->Warn(
+                    LogCategory::Core, u"File::ResetPathWatcher: Failed to watch '{0}'. Call ClearPathCache after changing files.", utf16_to_utf8(root->GetPath()).c_str());
+        }
     }
+}
+
+void File::MergeIndex(int32_t rootIndex) {
+    const auto& entries = m_roots[rootIndex]->GetPackFile()->GetEntries();
+    m_vfsIndex.reserve(m_vfsIndex.size() + entries.size());
 
-    for (auto i = m_roots.rbegin(), e = m_roots.rend(); i != e; ++i) {
-        if ((*i)->IsPack()) {
-            if ((*i)->GetPackFile()->Exists(path_)) return true;
-        } else if (FileSystem::GetIsFile((*i)->GetPath() + path_))
-            return true;
+    // roots added later take precedence
+    for (const auto& e : entries) {
+        const auto range = m_vfsIndex.equal_range(e.first);
+        auto it = range.first;
+        while (it != range.second && !PackFile::GetIsSamePath(it->second.Entry->Name, e.second.Name)) ++it;
+
+        if (it != range.second) {
+            it->second = VfsEntry{rootIndex, &e.second};
+        } else {
+            m_vfsIndex.emplace(e.first, VfsEntry{rootIndex, &e.second});
+        }
     }
+}
 
-    if (FileSystem::GetIsFile(path)) return true;
-    return false;
+int32_t File::FindPackRoot(const InternedPath* path, const PackFile::Entry*& entry) const {
+    const auto range = m_vfsIndex.equal_range(path->Hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (PackFile::GetIsSamePath(it->second.Entry->Name, path->Path)) {
+            entry = it->second.Entry;
+            return it->second.RootIndex;
+        }
+    }
+    entry = nullptr;
+    return -1;
 }
 
 bool File::Pack(const char16_t* srcPath, const char16_t* dstPath) const {
@@ -178,17 +421,11 @@ bool File::Pack(const char16_t* srcPath, const char16_t* dstPath) const {
         return false;
     }
 
-    int error;
-    zip_t* zip_ = zip_open(utf16_to_utf8(dstPath).c_str(), ZIP_TRUNCATE | ZIP_CREATE, &error);
-    if (zip_ == nullptr) {
-        Log::GetInstance()->Error(LogCategory::Core, u"File::Pack: Failed to create '{0}'", utf16_to_utf8(dstPath).c_str());
-        return false;
-    }
-
-    auto res = MakePackage(zip_, src);
-    zip_close(zip_);
+    // unencrypted packs are written by PackBuilder, which compresses the files in parallel
+    PackBuilder builder;
+    auto res = builder.Build(src, dstPath);
     if (!res) {
-        Log::GetInstance()->Error(LogCategory::Core, u"File::PackWithPassword: Filed to MakePackage '{0}'", utf16_to_utf8(srcPath).c_str());
+        Log::GetInstance()->Error(LogCategory::Core, u"File::Pack: Failed to pack '{0}'", utf16_to_utf8(srcPath).c_str());
     }
     return res;
 }
@@ -234,6 +471,7 @@ bool File::PackWithPassword(const char16_t* srcPath, const char16_t* dstPath, co
 }
 
 bool File::MakePackage(zip_t* zipPtr, const std::u16string& path, bool isEncrypt) const {
+    const PackBuilder storeOnlyRules;
     std::stack<std::u16string> children;
 
     std::u16string current;
@@ -253,31 +491,28 @@ bool File::MakePackage(zip_t* zipPtr, const std::u16string& path, bool isEncrypt
                 if (zip_dir_add(zipPtr, utf16_to_utf8(zipPath).c_str(), ZIP_FL_ENC_UTF_8) == -1) return false;
                 children.push(i);
             } else if (FileSystem::GetIsFile(i)) {
+                // the file is read by libzip on zip_close instead of being buffered here
+                zip_source_t* zipSource;
+                zip_error error;
+                zip_error_init(&error);
 #if _WIN32
-                std::ifstream file((wchar_t*)i.c_str(), std::ios::binary);
+                // the path is opened as wide characters so that non-ASCII paths work
+                zipSource = zip_source_win32w_create(reinterpret_cast<const wchar_t*>(i.c_str()), 0, 0, &error);
 #else
-                std::ifstream file(utf16_to_utf8(i).c_str(), std::ios::binary);
+                zipSource = zip_source_file_create(utf16_to_utf8(i).c_str(), 0, 0, &error);
 #endif
-                if (!file.is_open()) return false;
-
-                int size = FileSystem::GetFileSize(i);
-
-                // libzip requires malloced buffer (not new)
-                char* buffer = static_cast<char*>(malloc(size));
-                file.read(buffer, size);
-                zip_source_t* zipSource;
-                zip_error error;
-                if ((zipSource = zip_source_buffer_create(buffer, size, 1, &error)) == nullptr) return false;
+                zip_error_fini(&error);
+                if (zipSource == nullptr) return false;
 
                 zip_int64_t index;
                 if ((index = zip_file_add(zipPtr, utf16_to_utf8(zipPath).c_str(), zipSource, ZIP_FL_ENC_UTF_8)) == -1) {
                     zip_source_free(zipSource);
                     return false;
                 }
-                if (isEncrypt && zip_file_set_encryption(zipPtr, index, ZIP_EM_AES_256, nullptr) == -1) {
-                    zip_source_free(zipSource);
-                    return false;
-                }
+
+                // the source is owned by the archive once added
+                if (storeOnlyRules.GetIsStoreOnly(i) && zip_set_file_compression(zipPtr, index, ZIP_CM_STORE, 0) == -1) return false;
+                if (isEncrypt && zip_file_set_encryption(zipPtr, index, ZIP_EM_AES_256, nullptr) == -1) return false;
             }
         }
     }
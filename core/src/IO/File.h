@@ -1,13 +1,17 @@
 ﻿#pragma once
 
+#include <atomic>
 #include <ios>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "../Common/ResourceContainer.h"
 #include "../Common/Resources.h"
+#include "../Platform/FileSystem.h"
 #include "FileRoot.h"
+#include "PathTable.h"
 #include "StaticFile.h"
 #include "StreamFile.h"
 
@@ -21,9 +25,52 @@ private:
 
     std::vector<std::shared_ptr<FileRoot>> m_roots;
 
-    std::mutex m_rootMtx;
+#if !USE_CBG
+    //! entry of the index merged across all pack roots
+    struct VfsEntry {
+        int32_t RootIndex;
+        const PackFile::Entry* Entry;
+    };
+
+    //! hash of path -> topmost pack root containing it
+    //! paths whose hashes collide share the key, so Entry->Name is compared on lookup
+    std::unordered_multimap<uint64_t, VfsEntry> m_vfsIndex;
+
+    //! result of resolving a path through the roots
+    struct ResolvedPath {
+        //! path as requested, kept interned while it is cached
+        std::shared_ptr<const InternedPath> Path;
+        //! path to open for a directory root or no root
+        std::u16string FullPath;
+        //! -1 if the path is found without roots
+        int32_t RootIndex;
+        const PackFile::Entry* Entry;
+        bool IsFound;
+    };
+
+    //! hash of requested path -> result, including paths not found
+    //! paths not found are evicted when the cache exceeds PathCacheMaxCount
+    mutable std::unordered_map<uint64_t, ResolvedPath> m_pathCache;
+    static const int32_t PathCacheMaxCount = 16 * 1024;
+    bool m_isPathCacheEnabled = false;
+    mutable std::atomic<bool> m_isPathCacheDirty{false};
+#endif
+
+    mutable std::mutex m_rootMtx;
     std::mutex streamMtx_;
 
+#if !USE_CBG
+    bool m_isHotReloadEnabled = false;
+
+    //! paths reported by m_pathWatcher since the last PopChangedPaths
+    std::vector<std::u16string> m_changedPaths;
+    std::mutex m_changedPathsMtx;
+
+    //! clears m_pathCache and collects changed files in directory roots
+    //! declared last so that its thread stops before the members above are destroyed
+    std::shared_ptr<DirectoryWatcher> m_pathWatcher;
+#endif
+
 public:
 #if !USE_CBG
     static bool Initialize(std::shared_ptr<Resources> resources);
@@ -35,6 +82,7 @@ public:
 
 #if !USE_CBG
     std::shared_ptr<BaseFileReader> CreateFileReader(const char16_t* path);
+    std::shared_ptr<BaseFileReader> CreateFileReader(const std::shared_ptr<const InternedPath>& path);
 #endif
 
     bool AddRootDirectory(const char16_t* path);
@@ -47,6 +95,22 @@ public:
 
     bool Exists(const char16_t* path) const;
 
+    bool GetIsPathCacheEnabled() const;
+
+    void SetIsPathCacheEnabled(bool value);
+
+    void ClearPathCache();
+
+    bool GetIsHotReloadEnabled() const;
+
+    void SetIsHotReloadEnabled(bool value);
+
+#if !USE_CBG
+    //! gets the paths of the files changed since the last call, as the keys of resources
+    //! returns false if changes are not watched, in which case the resources have to be checked one by one
+    bool PopChangedPaths(std::vector<std::u16string>& paths);
+#endif
+
     bool Pack(const char16_t* srcPath, const char16_t* dstPath) const;
 
     bool PackWithPassword(const char16_t* srcPath, const char16_t* dstPath, const char16_t* password) const;
@@ -59,6 +123,21 @@ public:
 #endif
 
 private:
+#if !USE_CBG
+    //! registers entries of the pack root m_roots[rootIndex] to m_vfsIndex
+    void MergeIndex(int32_t rootIndex);
+
+    //! returns the index of the topmost pack root containing the path or -1
+    int32_t FindPackRoot(const InternedPath* path, const PackFile::Entry*& entry) const;
+
+    //! resolves path through m_roots[startRoot] and below. m_rootMtx must be locked
+    //! returns an entry of m_pathCache or storage, valid until the next call
+    const ResolvedPath* ResolvePath(const std::shared_ptr<const InternedPath>& path, int32_t startRoot, ResolvedPath& storage) const;
+
+    //! (re)creates m_pathWatcher for the current directory roots, or removes it if nothing uses it. m_rootMtx must be locked
+    void ResetPathWatcher();
+#endif
+
     bool MakePackage(zip_t* zipPtr, const std::u16string& path, bool isEncrypt = false) const;
 };
 
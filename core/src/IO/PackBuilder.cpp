@@ -0,0 +1,618 @@
+#include "PackBuilder.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <mutex>
+#include <stack>
+#include <thread>
+#include <unordered_map>
+
+#include "../Common/StringHelper.h"
+#include "../Logger/Log.h"
+#include "../Platform/FileSystem.h"
+#include "../System/ThreadPool.h"
+
+namespace Altseed2 {
+
+namespace {
+
+const uint32_t LocalHeaderSignature = 0x04034b50;
+const uint32_t CentralHeaderSignature = 0x02014b50;
+const uint32_t Zip64EndOfCentralDirectorySignature = 0x06064b50;
+const uint32_t Zip64EndOfCentralDirectoryLocatorSignature = 0x07064b50;
+const uint32_t EndOfCentralDirectorySignature = 0x06054b50;
+
+const uint16_t Zip64ExtraFieldId = 0x0001;
+const uint16_t FlagUtf8 = 0x0800;
+const uint16_t MethodStore = 0;
+const uint16_t MethodDeflate = 8;
+const uint16_t VersionDefault = 20;
+const uint16_t VersionZip64 = 45;
+const uint32_t AttributeDirectory = 0x10;
+
+const int64_t LocalHeaderSize = 30;
+const int64_t DictionarySize = 32 * 1024;
+
+void WriteLE16(std::vector<uint8_t>& buffer, uint16_t value) {
+    buffer.push_back(static_cast<uint8_t>(value));
+    buffer.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void WriteLE32(std::vector<uint8_t>& buffer, uint32_t value) {
+    for (int i = 0; i < 4; i++) buffer.push_back(static_cast<uint8_t>(value >> (i * 8)));
+}
+
+void WriteLE64(std::vector<uint8_t>& buffer, uint64_t value) {
+    for (int i = 0; i < 8; i++) buffer.push_back(static_cast<uint8_t>(value >> (i * 8)));
+}
+
+uint64_t Mix(uint64_t value) {
+    // finalizer of splitmix64
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+uint32_t Clamp32(int64_t value) { return value >= 0xFFFFFFFFLL ? 0xFFFFFFFF : static_cast<uint32_t>(value); }
+
+bool OpenInput(const std::u16string& path, std::ifstream& file) {
+#if _WIN32
+    file.open((wchar_t*)path.c_str(), std::ios::binary);
+#else
+    file.open(utf16_to_utf8(path).c_str(), std::ios::binary);
+#endif
+    return file.is_open();
+}
+
+//! returns 0 if the file can not be read
+uint64_t HashFile(const std::u16string& path, int64_t size) {
+    std::ifstream file;
+    if (!OpenInput(path, file)) return 0;
+
+    std::vector<uint8_t> buffer(static_cast<size_t>(std::min(size, PackBuilder::BlockSize)));
+    uint64_t hash = 0;
+    for (int64_t offset = 0; offset < size; offset += PackBuilder::BlockSize) {
+        const auto count = std::min(PackBuilder::BlockSize, size - offset);
+        if (!file.read(reinterpret_cast<char*>(buffer.data()), count)) return 0;
+        hash = PackBuilder::CombineBlockHash(hash, PackBuilder::GetBlockHash(buffer.data(), count));
+    }
+    return PackBuilder::FinishContentHash(hash, size);
+}
+
+bool CompareFiles(const std::u16string& path1, const std::u16string& path2, int64_t size) {
+    std::ifstream file1, file2;
+    if (!OpenInput(path1, file1) || !OpenInput(path2, file2)) return false;
+
+    const int64_t chunkSize = 64 * 1024;
+    std::vector<char> buffer1(chunkSize), buffer2(chunkSize);
+    for (int64_t offset = 0; offset < size; offset += chunkSize) {
+        const auto count = std::min(chunkSize, size - offset);
+        if (!file1.read(buffer1.data(), count) || !file2.read(buffer2.data(), count)) return false;
+        if (std::memcmp(buffer1.data(), buffer2.data(), static_cast<size_t>(count)) != 0) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+struct PackBuilder::Block {
+    int32_t EntryIndex;
+    int64_t Offset;
+    int64_t Size;
+    bool IsLast;
+
+    std::vector<uint8_t> Output;
+    uint32_t Crc;
+    uint64_t Hash;
+    bool IsDone;
+    bool IsFailed;
+};
+
+PackBuilder::PackBuilder() : threadCount_(0), compressionLevel_(Z_DEFAULT_COMPRESSION), isDeduplicated_(false) {
+    // already compressed formats gain almost nothing from deflate
+    for (auto extension : {u".png", u".jpg", u".jpeg", u".ogg", u".mp3", u".zip"}) {
+        storeOnlyExtensions_.insert(extension);
+    }
+}
+
+uint64_t PackBuilder::GetContentHash(const void* data, int64_t size) {
+    const auto bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 0;
+    for (int64_t offset = 0; offset < size; offset += BlockSize) {
+        hash = CombineBlockHash(hash, GetBlockHash(bytes + offset, std::min(BlockSize, size - offset)));
+    }
+    return FinishContentHash(hash, size);
+}
+
+uint64_t PackBuilder::GetBlockHash(const void* data, int64_t size) {
+    // FNV-1a
+    const auto bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 14695981039346656037ULL;
+    for (int64_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t PackBuilder::CombineBlockHash(uint64_t hash, uint64_t blockHash) { return Mix(hash ^ blockHash); }
+
+uint64_t PackBuilder::FinishContentHash(uint64_t hash, int64_t size) {
+    hash = Mix(hash + static_cast<uint64_t>(size) + 0x9E3779B97F4A7C15ULL);
+
+    // 0 means unknown
+    return hash != 0 ? hash : 1;
+}
+
+void PackBuilder::AddStoreOnlyExtension(const std::u16string& extension) {
+    auto ext = extension;
+    if (ext.empty()) return;
+    if (ext.front() != u'.') ext = u'.' + ext;
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](char16_t c) -> char16_t { return u'A' <= c && c <= u'Z' ? c - u'A' + u'a' : c; });
+    storeOnlyExtensions_.insert(ext);
+}
+
+bool PackBuilder::GetIsStoreOnly(const std::u16string& path) const {
+    const auto dot = path.find_last_of(u'.');
+    if (dot == std::u16string::npos) return false;
+
+    const auto separator = path.find_last_of(u"/\\");
+    if (separator != std::u16string::npos && separator > dot) return false;
+
+    auto ext = path.substr(dot);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](char16_t c) -> char16_t { return u'A' <= c && c <= u'Z' ? c - u'A' + u'a' : c; });
+    return storeOnlyExtensions_.count(ext) > 0;
+}
+
+bool PackBuilder::CollectEntries(const std::u16string& srcPath, std::vector<Entry>& entries) const {
+    std::stack<std::u16string> children;
+    children.push(srcPath);
+
+    std::vector<std::u16string> paths;
+    while (!children.empty()) {
+        const auto current = children.top();
+        children.pop();
+
+        FileSystem::GetChildPaths(current, paths);
+
+        // the order of the entries does not depend on the file system
+        std::sort(paths.begin(), paths.end());
+
+        for (const auto& path : paths) {
+            auto zipPath = path.substr(srcPath.size());
+            std::replace(zipPath.begin(), zipPath.end(), u'\\', u'/');
+
+            Entry entry;
+            entry.SourcePath = path;
+            entry.Size = 0;
+            entry.FirstBlock = 0;
+            entry.BlockCount = 0;
+            entry.DuplicateOf = -1;
+            entry.Crc = 0;
+            entry.ContentHash = 0;
+            entry.CompressedSize = 0;
+            entry.LocalHeaderOffset = 0;
+            entry.IsZip64 = false;
+
+            if (FileSystem::GetIsDirectory(path)) {
+                entry.Name = utf16_to_utf8(zipPath) + "/";
+                entry.IsDirectory = true;
+                entry.IsStored = true;
+                children.push(path);
+            } else if (FileSystem::GetIsFile(path)) {
+                std::ifstream file;
+                if (!OpenInput(path, file)) {
+                    Log::GetInstance()->Error(LogCategory::Core, u"PackBuilder::Build: Failed to open '{0}'", utf16_to_utf8(path).c_str());
+                    return false;
+                }
+                file.seekg(0, std::ios::end);
+
+                entry.Name = utf16_to_utf8(zipPath);
+                entry.IsDirectory = false;
+                entry.Size = static_cast<int64_t>(file.tellg());
+                entry.IsStored = entry.Size == 0 || compressionLevel_ == 0 || GetIsStoreOnly(path);
+            } else {
+                continue;
+            }
+
+            if (entry.Name.size() > 0xFFFF) {
+                Log::GetInstance()->Error(LogCategory::Core, u"PackBuilder::Build: Path '{0}' is too long", utf16_to_utf8(path).c_str());
+                return false;
+            }
+
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    return true;
+}
+
+void PackBuilder::FindDuplicates(std::vector<Entry>& entries, int32_t threadCount) const {
+    // only files of the same size can be identical
+    std::unordered_map<int64_t, std::vector<int32_t>> sizeGroups;
+    for (int32_t i = 0; i < static_cast<int32_t>(entries.size()); i++) {
+        if (!entries[i].IsDirectory && entries[i].Size > 0) {
+            sizeGroups[entries[i].Size].push_back(i);
+        }
+    }
+
+    ThreadPool pool(threadCount);
+
+    for (const auto& group : sizeGroups) {
+        if (group.second.size() < 2) continue;
+
+        // the groups are disjoint, so the tasks do not share entries
+        const auto indices = &group.second;
+        pool.Post([&entries, indices]() -> void {
+            std::vector<uint64_t> hashes;
+            hashes.reserve(indices->size());
+            for (auto index : *indices) {
+                hashes.push_back(HashFile(entries[index].SourcePath, entries[index].Size));
+            }
+
+            for (size_t i = 1; i < indices->size(); i++) {
+                if (hashes[i] == 0) continue;
+
+                auto& entry = entries[(*indices)[i]];
+                for (size_t j = 0; j < i; j++) {
+                    const auto& original = entries[(*indices)[j]];
+                    if (original.DuplicateOf >= 0 || hashes[j] != hashes[i]) continue;
+
+                    // the hash only narrows down the candidates
+                    if (CompareFiles(original.SourcePath, entry.SourcePath, entry.Size)) {
+                        entry.DuplicateOf = (*indices)[j];
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    pool.Stop();
+}
+
+void PackBuilder::ProcessBlock(const Entry& entry, Block& block, int32_t compressionLevel) {
+    std::ifstream file;
+    if (!OpenInput(entry.SourcePath, file)) {
+        block.IsFailed = true;
+        return;
+    }
+
+    if (entry.IsStored) {
+        block.Output.resize(static_cast<size_t>(block.Size));
+        file.seekg(block.Offset);
+        if (!file.read(reinterpret_cast<char*>(block.Output.data()), block.Size)) {
+            block.IsFailed = true;
+            return;
+        }
+        block.Crc = crc32(0, block.Output.data(), static_cast<uInt>(block.Size));
+        block.Hash = GetBlockHash(block.Output.data(), block.Size);
+        return;
+    }
+
+    // the end of the previous block primes the dictionary so that splitting hardly affects the ratio
+    const auto dictionarySize = std::min(DictionarySize, block.Offset);
+    std::vector<uint8_t> input(static_cast<size_t>(dictionarySize + block.Size));
+    file.seekg(block.Offset - dictionarySize);
+    if (!file.read(reinterpret_cast<char*>(input.data()), input.size())) {
+        block.IsFailed = true;
+        return;
+    }
+
+    const auto data = input.data() + dictionarySize;
+    block.Crc = crc32(0, data, static_cast<uInt>(block.Size));
+    block.Hash = GetBlockHash(data, block.Size);
+
+    z_stream stream = {};
+    if (deflateInit2(&stream, compressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        block.IsFailed = true;
+        return;
+    }
+
+    if (dictionarySize > 0) {
+        deflateSetDictionary(&stream, input.data(), static_cast<uInt>(dictionarySize));
+    }
+
+    // a sync flush ends a non-final block on a byte boundary, so the outputs of the blocks can be concatenated
+    block.Output.resize(deflateBound(&stream, static_cast<uLong>(block.Size)) + 16);
+    stream.next_in = data;
+    stream.avail_in = static_cast<uInt>(block.Size);
+    stream.next_out = block.Output.data();
+    stream.avail_out = static_cast<uInt>(block.Output.size());
+
+    const auto result = deflate(&stream, block.IsLast ? Z_FINISH : Z_SYNC_FLUSH);
+    const bool isSucceeded = block.IsLast ? result == Z_STREAM_END : (result == Z_OK && stream.avail_in == 0 && stream.avail_out > 0);
+    block.Output.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    if (!isSucceeded) block.IsFailed = true;
+}
+
+bool PackBuilder::Build(const std::u16string& srcPath, const std::u16string& dstPath) const {
+    auto src = srcPath;
+    if (src.empty() || (src.back() != u'/' && src.back() != u'\\')) src += u'/';
+
+    if (!FileSystem::GetIsDirectory(src)) {
+        Log::GetInstance()->Error(LogCategory::Core, u"PackBuilder::Build: Directory '{0}' is not found", utf16_to_utf8(srcPath).c_str());
+        return false;
+    }
+
+    std::vector<Entry> entries;
+    if (!CollectEntries(src, entries)) return false;
+
+    auto threadCount = threadCount_ > 0 ? threadCount_ : static_cast<int32_t>(std::thread::hardware_concurrency());
+    threadCount = std::max(threadCount, 1);
+
+    if (isDeduplicated_) {
+        FindDuplicates(entries, threadCount);
+    }
+
+    std::vector<Block> blocks;
+    for (int32_t i = 0; i < static_cast<int32_t>(entries.size()); i++) {
+        auto& entry = entries[i];
+        entry.FirstBlock = static_cast<int32_t>(blocks.size());
+        if (entry.DuplicateOf >= 0) continue;
+
+        for (int64_t offset = 0; offset < entry.Size; offset += BlockSize) {
+            Block block;
+            block.EntryIndex = i;
+            block.Offset = offset;
+            block.Size = std::min(BlockSize, entry.Size - offset);
+            block.IsLast = offset + block.Size == entry.Size;
+            block.Crc = 0;
+            block.Hash = 0;
+            block.IsDone = false;
+            block.IsFailed = false;
+            blocks.push_back(std::move(block));
+        }
+
+        entry.BlockCount = static_cast<int32_t>(blocks.size()) - entry.FirstBlock;
+
+        // sizes are written before compression, so entries which may exceed 4GiB always use zip64
+        entry.IsZip64 = entry.Size >= 0xFFFFFFFFLL - (entry.Size >> 8) - 0x10000;
+    }
+
+    std::ofstream file;
+#if _WIN32
+    file.open((wchar_t*)dstPath.c_str(), std::ios::binary | std::ios::trunc);
+#else
+    file.open(utf16_to_utf8(dstPath).c_str(), std::ios::binary | std::ios::trunc);
+#endif
+    if (!file.is_open()) {
+        Log::GetInstance()->Error(LogCategory::Core, u"PackBuilder::Build: Failed to create '{0}'", utf16_to_utf8(dstPath).c_str());
+        return false;
+    }
+
+    // DOS date and time of the entries
+    const auto now = std::time(nullptr);
+    const auto local = *std::localtime(&now);
+    const auto dosTime = static_cast<uint16_t>((local.tm_hour << 11) | (local.tm_min << 5) | (local.tm_sec / 2));
+    const auto dosDate = static_cast<uint16_t>((std::max(local.tm_year - 80, 0) << 9) | ((local.tm_mon + 1) << 5) | local.tm_mday);
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::atomic<bool> isCancelled(false);
+
+    // bounds the memory used by the outputs waiting to be written
+    const auto maxBlocksInFlight = static_cast<size_t>(threadCount) * 4;
+    size_t postedCount = 0;
+
+    bool isSucceeded = true;
+    int64_t position = 0;
+    std::vector<uint8_t> header;
+
+    {
+        // the workers are joined at the end of this scope, before the blocks are released
+        ThreadPool pool(threadCount);
+
+        for (auto& entry : entries) {
+            // the data of duplicates is not written
+            if (entry.DuplicateOf >= 0) continue;
+
+            entry.LocalHeaderOffset = position;
+
+            header.clear();
+            WriteLE32(header, LocalHeaderSignature);
+            WriteLE16(header, entry.IsZip64 ? VersionZip64 : VersionDefault);
+            WriteLE16(header, FlagUtf8);
+            WriteLE16(header, entry.IsStored ? MethodStore : MethodDeflate);
+            WriteLE16(header, dosTime);
+            WriteLE16(header, dosDate);
+
+            // crc and sizes are patched after the data is written
+            WriteLE32(header, 0);
+            WriteLE32(header, entry.IsZip64 ? 0xFFFFFFFF : 0);
+            WriteLE32(header, entry.IsZip64 ? 0xFFFFFFFF : 0);
+            WriteLE16(header, static_cast<uint16_t>(entry.Name.size()));
+            WriteLE16(header, entry.IsZip64 ? 20 : 0);
+            header.insert(header.end(), entry.Name.begin(), entry.Name.end());
+            if (entry.IsZip64) {
+                WriteLE16(header, Zip64ExtraFieldId);
+                WriteLE16(header, 16);
+                WriteLE64(header, 0);
+                WriteLE64(header, 0);
+            }
+
+            file.write(reinterpret_cast<const char*>(header.data()), header.size());
+            position += static_cast<int64_t>(header.size());
+
+            for (int32_t i = entry.FirstBlock; i < entry.FirstBlock + entry.BlockCount; i++) {
+                while (postedCount < blocks.size() && postedCount < static_cast<size_t>(i) + maxBlocksInFlight) {
+                    const auto block = &blocks[postedCount++];
+                    const auto blockEntry = &entries[block->EntryIndex];
+                    const auto compressionLevel = compressionLevel_;
+                    pool.Post([&mtx, &cv, &isCancelled, block, blockEntry, compressionLevel]() -> void {
+                        if (!isCancelled) {
+                            ProcessBlock(*blockEntry, *block, compressionLevel);
+                        } else {
+                            block->IsFailed = true;
+                        }
+
+                        std::lock_guard<std::mutex> lock(mtx);
+                        block->IsDone = true;
+                        cv.notify_all();
+                    });
+                }
+
+                auto& block = blocks[i];
+                {
+                    std::unique_lock<std::mutex> lock(mtx);
+                    cv.wait(lock, [&block]() -> bool { return block.IsDone; });
+                }
+
+                if (block.IsFailed) {
+                    Log::GetInstance()->Error(
+                            LogCategory::Core, u"PackBuilder::Build: Failed to read or compress '{0}'", utf16_to_utf8(entry.SourcePath).c_str());
+                    isSucceeded = false;
+                    break;
+                }
+
+                file.write(reinterpret_cast<const char*>(block.Output.data()), block.Output.size());
+                position += static_cast<int64_t>(block.Output.size());
+                entry.CompressedSize += static_cast<int64_t>(block.Output.size());
+                entry.Crc = static_cast<uint32_t>(crc32_combine(entry.Crc, block.Crc, static_cast<z_off_t>(block.Size)));
+                entry.ContentHash = CombineBlockHash(entry.ContentHash, block.Hash);
+                std::vector<uint8_t>().swap(block.Output);
+            }
+
+            if (!isSucceeded) break;
+
+            entry.ContentHash = FinishContentHash(entry.ContentHash, entry.Size);
+
+            if (!entry.IsZip64 && entry.CompressedSize >= 0xFFFFFFFFLL) {
+                Log::GetInstance()->Error(LogCategory::Core, u"PackBuilder::Build: '{0}' is too large", utf16_to_utf8(entry.SourcePath).c_str());
+                isSucceeded = false;
+                break;
+            }
+
+            header.clear();
+            WriteLE32(header, entry.Crc);
+            WriteLE32(header, entry.IsZip64 ? 0xFFFFFFFF : static_cast<uint32_t>(entry.CompressedSize));
+            WriteLE32(header, entry.IsZip64 ? 0xFFFFFFFF : static_cast<uint32_t>(entry.Size));
+            file.seekp(entry.LocalHeaderOffset + 14);
+            file.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+            if (entry.IsZip64) {
+                header.clear();
+                WriteLE64(header, static_cast<uint64_t>(entry.Size));
+                WriteLE64(header, static_cast<uint64_t>(entry.CompressedSize));
+                file.seekp(entry.LocalHeaderOffset + LocalHeaderSize + static_cast<int64_t>(entry.Name.size()) + 4);
+                file.write(reinterpret_cast<const char*>(header.data()), header.size());
+            }
+
+            file.seekp(position);
+
+            if (!file.good()) {
+                Log::GetInstance()->Error(LogCategory::Core, u"PackBuilder::Build: Failed to write '{0}'", utf16_to_utf8(dstPath).c_str());
+                isSucceeded = false;
+                break;
+            }
+        }
+
+        isCancelled = !isSucceeded;
+    }
+
+    if (!isSucceeded) return false;
+
+    // central directory
+    const auto centralDirectoryOffset = position;
+    for (const auto& named : entries) {
+        // duplicates refer to the data of the original
+        const auto& entry = named.DuplicateOf >= 0 ? entries[named.DuplicateOf] : named;
+
+        std::vector<uint8_t> extra;
+        if (entry.IsZip64) {
+            WriteLE64(extra, static_cast<uint64_t>(entry.Size));
+            WriteLE64(extra, static_cast<uint64_t>(entry.CompressedSize));
+        }
+        if (entry.LocalHeaderOffset >= 0xFFFFFFFFLL) {
+            WriteLE64(extra, static_cast<uint64_t>(entry.LocalHeaderOffset));
+        }
+        if (!extra.empty()) {
+            std::vector<uint8_t> field;
+            WriteLE16(field, Zip64ExtraFieldId);
+            WriteLE16(field, static_cast<uint16_t>(extra.size()));
+            extra.insert(extra.begin(), field.begin(), field.end());
+        }
+        if (!entry.IsDirectory) {
+            WriteLE16(extra, ContentHashExtraFieldId);
+            WriteLE16(extra, 8);
+            WriteLE64(extra, entry.ContentHash);
+        }
+
+        const auto version = entry.IsZip64 || entry.LocalHeaderOffset >= 0xFFFFFFFFLL ? VersionZip64 : VersionDefault;
+
+        header.clear();
+        WriteLE32(header, CentralHeaderSignature);
+        WriteLE16(header, version);
+        WriteLE16(header, version);
+        WriteLE16(header, FlagUtf8);
+        WriteLE16(header, entry.IsStored ? MethodStore : MethodDeflate);
+        WriteLE16(header, dosTime);
+        WriteLE16(header, dosDate);
+        WriteLE32(header, entry.Crc);
+        WriteLE32(header, entry.IsZip64 ? 0xFFFFFFFF : static_cast<uint32_t>(entry.CompressedSize));
+        WriteLE32(header, entry.IsZip64 ? 0xFFFFFFFF : static_cast<uint32_t>(entry.Size));
+        WriteLE16(header, static_cast<uint16_t>(named.Name.size()));
+        WriteLE16(header, static_cast<uint16_t>(extra.size()));
+        WriteLE16(header, 0);
+        WriteLE16(header, 0);
+        WriteLE16(header, 0);
+        WriteLE32(header, entry.IsDirectory ? AttributeDirectory : 0);
+        WriteLE32(header, Clamp32(entry.LocalHeaderOffset));
+        header.insert(header.end(), named.Name.begin(), named.Name.end());
+        header.insert(header.end(), extra.begin(), extra.end());
+
+        file.write(reinterpret_cast<const char*>(header.data()), header.size());
+        position += static_cast<int64_t>(header.size());
+    }
+
+    const auto centralDirectorySize = position - centralDirectoryOffset;
+    const auto count = static_cast<int64_t>(entries.size());
+
+    header.clear();
+    if (count >= 0xFFFF || centralDirectoryOffset >= 0xFFFFFFFFLL || centralDirectorySize >= 0xFFFFFFFFLL) {
+        WriteLE32(header, Zip64EndOfCentralDirectorySignature);
+        WriteLE64(header, 44);
+        WriteLE16(header, VersionZip64);
+        WriteLE16(header, VersionZip64);
+        WriteLE32(header, 0);
+        WriteLE32(header, 0);
+        WriteLE64(header, static_cast<uint64_t>(count));
+        WriteLE64(header, static_cast<uint64_t>(count));
+        WriteLE64(header, static_cast<uint64_t>(centralDirectorySize));
+        WriteLE64(header, static_cast<uint64_t>(centralDirectoryOffset));
+
+        WriteLE32(header, Zip64EndOfCentralDirectoryLocatorSignature);
+        WriteLE32(header, 0);
+        WriteLE64(header, static_cast<uint64_t>(position));
+        WriteLE32(header, 1);
+    }
+
+    WriteLE32(header, EndOfCentralDirectorySignature);
+    WriteLE16(header, 0);
+    WriteLE16(header, 0);
+    WriteLE16(header, static_cast<uint16_t>(std::min<int64_t>(count, 0xFFFF)));
+    WriteLE16(header, static_cast<uint16_t>(std::min<int64_t>(count, 0xFFFF)));
+    WriteLE32(header, Clamp32(centralDirectorySize));
+    WriteLE32(header, Clamp32(centralDirectoryOffset));
+    WriteLE16(header, 0);
+
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    file.close();
+
+    if (file.fail()) {
+        Log::GetInstance()->Error(LogCategory::Core, u"PackBuilder::Build: Failed to write '{0}'", utf16_to_utf8(dstPath).c_str());
+        return false;
+    }
+
+    return true;
+}
+
+}  // namespace Altseed2
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#if !USE_CBG
+
+namespace Altseed2 {
+
+//! writes a pack (zip archive) of a directory, compressing the files in parallel
+/**
+    files are split into blocks of BlockSize and each block is deflated on a worker thread with the previous 32KiB as the dictionary.
+    the blocks are written in order as they complete, so memory usage is bounded by the number of blocks in flight
+    regardless of the size of the files.
+    files with identical contents are stored once and the other entries of the central directory refer to the same data.
+*/
+class PackBuilder {
+public:
+    static constexpr int64_t BlockSize = 1024 * 1024;
+
+private:
+    struct Entry {
+        //! path in the pack, '/' separated. ends with '/' for directories
+        std::string Name;
+        std::u16string SourcePath;
+        bool IsDirectory;
+        bool IsStored;
+        int64_t Size;
+        int32_t FirstBlock;
+        int32_t BlockCount;
+
+        //! index of the entry with the same content whose data is shared, or -1
+        int32_t DuplicateOf;
+
+        // filled on writing
+        uint32_t Crc;
+        uint64_t ContentHash;
+        int64_t CompressedSize;
+        int64_t LocalHeaderOffset;
+        bool IsZip64;
+    };
+
+    struct Block;
+
+    int32_t threadCount_;
+    int32_t compressionLevel_;
+    bool isDeduplicated_;
+    std::unordered_set<std::u16string> storeOnlyExtensions_;
+
+    bool CollectEntries(const std::u16string& srcPath, std::vector<Entry>& entries) const;
+
+    //! sets DuplicateOf of the entries whose contents equal an earlier entry
+    void FindDuplicates(std::vector<Entry>& entries, int32_t threadCount) const;
+
+    static void ProcessBlock(const Entry& entry, Block& block, int32_t compressionLevel);
+
+public:
+    //! id of the extra field in the central directory which holds the content hash of an entry
+    static constexpr uint16_t ContentHashExtraFieldId = 0x3241;
+
+    PackBuilder();
+
+    //! hash of a content, the same as the one written to the packs
+    /**
+        each BlockSize of the content is hashed separately so that the blocks can be hashed in parallel.
+    */
+    static uint64_t GetContentHash(const void* data, int64_t size);
+    static uint64_t GetBlockHash(const void* data, int64_t size);
+    static uint64_t CombineBlockHash(uint64_t hash, uint64_t blockHash);
+    static uint64_t FinishContentHash(uint64_t hash, int64_t size);
+
+    //! 0 uses the number of hardware threads
+    void SetThreadCount(int32_t value) { threadCount_ = value; }
+    int32_t GetThreadCount() const { return threadCount_; }
+
+    //! zlib compression level from 0 to 9, or -1 for the default
+    void SetCompressionLevel(int32_t value) { compressionLevel_ = value; }
+    int32_t GetCompressionLevel() const { return compressionLevel_; }
+
+    //! files with the extension (e.g. u".png", case insensitive) are stored without compression
+    void AddStoreOnlyExtension(const std::u16string& extension);
+    void ClearStoreOnlyExtensions() { storeOnlyExtensions_.clear(); }
+    bool GetIsStoreOnly(const std::u16string& path) const;
+
+    //! deduplicates files with identical contents (disabled by default)
+    //! the entries share one data in the pack, which some zip tools (e.g. unzip -t) report as an error
+    void SetIsDeduplicated(bool value) { isDeduplicated_ = value; }
+    bool GetIsDeduplicated() const { return isDeduplicated_; }
+
+    //! packs the files under srcPath into dstPath. encryption is not supported (see File::PackWithPassword)
+    bool Build(const std::u16string& srcPath, const std::u16string& dstPath) const;
+};
+
+}  // namespace Altseed2
+
+#endif
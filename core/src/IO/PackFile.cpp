@@ -1,26 +1,254 @@
 ﻿#include "PackFile.h"
 
+#include <algorithm>
+
 #include "../Common/StringHelper.h"
+#include "../Logger/Log.h"
+#include "PackBuilder.h"
 
 namespace Altseed2 {
 
-PackFile::PackFile(zip_t* zipPtr, bool isUsePassword) : m_zip(zipPtr), m_isUsePassword(isUsePassword) {}
+namespace {
+
+const uint32_t LocalHeaderSignature = 0x04034b50;
+const uint32_t CentralHeaderSignature = 0x02014b50;
+const uint32_t EndOfCentralDirectorySignature = 0x06054b50;
+const uint32_t Zip64EndOfCentralDirectorySignature = 0x06064b50;
+const uint32_t Zip64EndOfCentralDirectoryLocatorSignature = 0x07064b50;
+const uint16_t Zip64ExtraFieldId = 0x0001;
+
+const int64_t LocalHeaderSize = 30;
+const int64_t CentralHeaderSize = 46;
+const int64_t EndOfCentralDirectorySize = 22;
+const int64_t Zip64EndOfCentralDirectorySize = 56;
+const int64_t Zip64EndOfCentralDirectoryLocatorSize = 20;
+
+uint16_t ReadLE16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+
+uint32_t ReadLE32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t ReadLE64(const uint8_t* p) { return static_cast<uint64_t>(ReadLE32(p)) | (static_cast<uint64_t>(ReadLE32(p + 4)) << 32); }
+
+}  // namespace
+
+PackFile::PackFile(zip_t* zipPtr, const std::u16string& path, bool isUsePassword) : m_zip(zipPtr), m_isUsePassword(isUsePassword) {
+    m_mapping = FileSystem::MapFile(path);
+    BuildIndex();
+}
 
 PackFile::~PackFile() { zip_close(m_zip); }
 
-zip_file_t* PackFile::Load(const std::u16string& path) { return zip_fopen(m_zip, utf16_to_utf8(path).c_str(), ZIP_FL_UNCHANGED); }
+void PackFile::BuildIndex() {
+    const auto count = zip_get_num_entries(m_zip, ZIP_FL_UNCHANGED);
+    if (count <= 0) return;
+
+    m_entries.reserve(static_cast<size_t>(count));
+
+    // libzip does not expose where the data of an entry is, so it is read from the central directory
+    std::vector<CentralEntry> centralEntries;
+    if (m_mapping != nullptr && (!ReadCentralDirectory(centralEntries) || centralEntries.size() != static_cast<size_t>(count))) {
+        m_mapping = nullptr;
+        centralEntries.clear();
+    }
+
+    zip_stat_t stat;
+    for (zip_int64_t i = 0; i < count; i++) {
+        zip_stat_init(&stat);
+        if (zip_stat_index(m_zip, static_cast<zip_uint64_t>(i), ZIP_FL_UNCHANGED, &stat) == -1 || (stat.valid & ZIP_STAT_NAME) == 0) {
+            continue;
+        }
+
+        const auto name = utf8_to_utf16(stat.name);
+        const auto hash = GetPathHash(name);
+        if (Find(hash, name) != nullptr) {
+            Log::GetInstance()->Warn(LogCategory::Core, u"PackFile::BuildIndex: '{0}' is contained more than once", stat.name);
+            continue;
+        }
+
+        Entry entry;
+        entry.Name = name;
+        std::replace(entry.Name.begin(), entry.Name.end(), u'\\', u'/');
+        entry.Index = static_cast<zip_uint64_t>(i);
+        entry.Size = (stat.valid & ZIP_STAT_SIZE) != 0 ? static_cast<int64_t>(stat.size) : -1;
+        entry.CompressedSize = (stat.valid & ZIP_STAT_COMP_SIZE) != 0 ? static_cast<int64_t>(stat.comp_size) : -1;
+        entry.CompressionMethod = (stat.valid & ZIP_STAT_COMP_METHOD) != 0 ? stat.comp_method : ZIP_CM_DEFAULT;
+        entry.EncryptionMethod = (stat.valid & ZIP_STAT_ENCRYPTION_METHOD) != 0 ? stat.encryption_method : ZIP_EM_NONE;
+        entry.LocalHeaderOffset = -1;
+        entry.ContentHash = !centralEntries.empty() && entry.EncryptionMethod == ZIP_EM_NONE ? centralEntries[i].ContentHash : 0;
+
+        if (m_mapping != nullptr && entry.CompressionMethod == ZIP_CM_STORE && entry.EncryptionMethod == ZIP_EM_NONE &&
+            entry.Size >= 0 && entry.Size == entry.CompressedSize) {
+            entry.LocalHeaderOffset = centralEntries[i].LocalHeaderOffset;
+        }
+
+        m_entries.emplace(hash, std::move(entry));
+    }
+}
+
+bool PackFile::ReadCentralDirectory(std::vector<CentralEntry>& entries) const {
+    const auto data = static_cast<const uint8_t*>(m_mapping->GetData());
+    const auto size = m_mapping->GetSize();
+    if (size < EndOfCentralDirectorySize) return false;
+
+    // the end of central directory record is followed by a comment up to 65535 bytes
+    int64_t eocd = -1;
+    const auto last = size - EndOfCentralDirectorySize;
+    const auto first = std::max<int64_t>(0, last - 0xFFFF);
+    for (auto i = last; i >= first; i--) {
+        if (ReadLE32(data + i) == EndOfCentralDirectorySignature) {
+            eocd = i;
+            break;
+        }
+    }
+    if (eocd < 0) return false;
+
+    int64_t count = ReadLE16(data + eocd + 10);
+    int64_t cdSize = ReadLE32(data + eocd + 12);
+    int64_t cdOffset = ReadLE32(data + eocd + 16);
+    int64_t cdEnd = eocd;
+
+    // large packs (e.g. written by PackBuilder) have the zip64 end of central directory record
+    if (count == 0xFFFF || cdSize == 0xFFFFFFFF || cdOffset == 0xFFFFFFFF) {
+        const auto locator = eocd - Zip64EndOfCentralDirectoryLocatorSize;
+        if (locator < 0 || ReadLE32(data + locator) != Zip64EndOfCentralDirectoryLocatorSignature) return false;
+
+        const auto record = static_cast<int64_t>(ReadLE64(data + locator + 8));
+        if (record < 0 || record + Zip64EndOfCentralDirectorySize > locator || ReadLE32(data + record) != Zip64EndOfCentralDirectorySignature) {
+            return false;
+        }
+
+        count = static_cast<int64_t>(ReadLE64(data + record + 32));
+        cdSize = static_cast<int64_t>(ReadLE64(data + record + 40));
+        cdOffset = static_cast<int64_t>(ReadLE64(data + record + 48));
+        cdEnd = record;
+    }
+
+    if (count < 0 || cdSize < 0 || cdOffset < 0 || cdOffset + cdSize > cdEnd) return false;
+
+    entries.clear();
+    entries.reserve(static_cast<size_t>(std::min<int64_t>(count, cdSize / CentralHeaderSize)));
+
+    auto p = cdOffset;
+    for (int64_t i = 0; i < count; i++) {
+        if (p + CentralHeaderSize > cdEnd || ReadLE32(data + p) != CentralHeaderSignature) return false;
+
+        const auto flags = ReadLE16(data + p + 8);
+        const auto nameSize = ReadLE16(data + p + 28);
+        const auto extraSize = ReadLE16(data + p + 30);
+        const auto commentSize = ReadLE16(data + p + 32);
+        if (p + CentralHeaderSize + nameSize + extraSize + commentSize > cdEnd) return false;
+
+        const bool isCompSize64 = ReadLE32(data + p + 20) == 0xFFFFFFFF;
+        const bool isUncompSize64 = ReadLE32(data + p + 24) == 0xFFFFFFFF;
+        const bool isOffset64 = ReadLE32(data + p + 42) == 0xFFFFFFFF;
 
-bool PackFile::Exists(const std::u16string& path) { return zip_name_locate(m_zip, utf16_to_utf8(path).c_str(), ZIP_FL_ENC_GUESS) != -1; }
+        CentralEntry entry;
+        entry.LocalHeaderOffset = isOffset64 ? -1 : static_cast<int64_t>(ReadLE32(data + p + 42));
+        entry.ContentHash = 0;
+
+        auto extra = p + CentralHeaderSize + nameSize;
+        const auto extraEnd = extra + extraSize;
+        while (extra + 4 <= extraEnd) {
+            const auto id = ReadLE16(data + extra);
+            const auto size = ReadLE16(data + extra + 2);
+            if (extra + 4 + size > extraEnd) break;
+
+            // values saturated in the header are in the zip64 extra field, in the order of uncompressed size, compressed size and offset
+            if (id == Zip64ExtraFieldId && isOffset64) {
+                const auto field = extra + 4 + (isUncompSize64 ? 8 : 0) + (isCompSize64 ? 8 : 0);
+                if (field + 8 <= extra + 4 + size) {
+                    entry.LocalHeaderOffset = static_cast<int64_t>(ReadLE64(data + field));
+                }
+            } else if (id == PackBuilder::ContentHashExtraFieldId && size == 8) {
+                entry.ContentHash = ReadLE64(data + extra + 4);
+            }
+
+            extra += 4 + size;
+        }
+
+        // encrypted entries are read through libzip
+        if ((flags & 1) != 0) entry.LocalHeaderOffset = -1;
+        entries.push_back(entry);
+
+        p += CentralHeaderSize + nameSize + extraSize + commentSize;
+    }
+
+    return true;
+}
+
+const uint8_t* PackFile::GetStoredData(const Entry& entry) const {
+    if (m_mapping == nullptr || entry.LocalHeaderOffset < 0) return nullptr;
+
+    const auto data = static_cast<const uint8_t*>(m_mapping->GetData());
+    const auto size = m_mapping->GetSize();
+
+    const auto header = entry.LocalHeaderOffset;
+    if (header + LocalHeaderSize > size || ReadLE32(data + header) != LocalHeaderSignature) return nullptr;
+
+    const auto offset = header + LocalHeaderSize + ReadLE16(data + header + 26) + ReadLE16(data + header + 28);
+    if (offset + entry.Size > size) return nullptr;
+
+    return data + offset;
+}
+
+zip_file_t* PackFile::Load(const std::u16string& path) {
+    auto entry = Find(path);
+    if (entry == nullptr) return nullptr;
+    return Load(*entry);
+}
+
+bool PackFile::Exists(const std::u16string& path) { return Find(path) != nullptr; }
 
 zip_stat_t* PackFile::GetZipStat(const std::u16string& path) {
+    auto entry = Find(path);
+    if (entry == nullptr) return nullptr;
+    return GetZipStat(*entry);
+}
+
+bool PackFile::GetIsUsePassword() { return m_isUsePassword; }
+
+const PackFile::Entry* PackFile::Find(const std::u16string& path) const { return Find(GetPathHash(path), path); }
+
+const PackFile::Entry* PackFile::Find(uint64_t pathHash, const std::u16string& path) const {
+    const auto range = m_entries.equal_range(pathHash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (GetIsSamePath(it->second.Name, path)) return &it->second;
+    }
+    return nullptr;
+}
+
+zip_file_t* PackFile::Load(const Entry& entry) { return zip_fopen_index(m_zip, entry.Index, ZIP_FL_UNCHANGED); }
+
+zip_stat_t* PackFile::GetZipStat(const Entry& entry) {
     zip_stat_t* res = new zip_stat_t();
-    if (zip_stat(m_zip, utf16_to_utf8(path).c_str(), ZIP_FL_UNCHANGED, res) == -1) {
+    if (zip_stat_index(m_zip, entry.Index, ZIP_FL_UNCHANGED, res) == -1) {
         delete res;
         return nullptr;
     }
     return res;
 }
 
-bool PackFile::GetIsUsePassword() { return m_isUsePassword; }
+uint64_t PackFile::GetPathHash(const std::u16string& path) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto c : path) {
+        if (c == u'\\') c = u'/';
+        hash ^= static_cast<uint64_t>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool PackFile::GetIsSamePath(const std::u16string& path1, const std::u16string& path2) {
+    if (path1.size() != path2.size()) return false;
+    for (size_t i = 0; i < path1.size(); i++) {
+        const auto c1 = path1[i] == u'\\' ? u'/' : path1[i];
+        const auto c2 = path2[i] == u'\\' ? u'/' : path2[i];
+        if (c1 != c2) return false;
+    }
+    return true;
+}
 
-}  // namespace Altseed2
\ No newline at end of file
+}  // namespace Altseed2
@@ -2,27 +2,91 @@
 
 #include <zip.h>
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "../BaseObject.h"
+#include "../Platform/FileSystem.h"
 
 #if !USE_CBG
 
 namespace Altseed2 {
 class PackFile : public BaseObject {
+public:
+    //! entry of the pack index
+    struct Entry {
+        //! name of the entry with '\\' replaced by '/', compared on lookup because hashes may collide
+        std::u16string Name;
+
+        //! index of the entry in the central directory of the archive
+        zip_uint64_t Index;
+        int64_t Size;
+        int64_t CompressedSize;
+        int32_t CompressionMethod;
+        int32_t EncryptionMethod;
+
+        //! offset of the local file header in the pack, or -1 if the entry can not be read through the mapping
+        int64_t LocalHeaderOffset;
+
+        //! hash of the content written by PackBuilder (see PackBuilder::GetContentHash), or 0
+        uint64_t ContentHash;
+    };
+
 private:
     zip_t* m_zip;
     bool m_isUsePassword;
 
+    //! hash of normalized path -> entries, built once on construction
+    //! entries whose hashes collide share the key
+    std::unordered_multimap<uint64_t, Entry> m_entries;
+
+    //! mapping of the whole pack to serve stored entries without copying
+    std::shared_ptr<MappedFile> m_mapping;
+
+    void BuildIndex();
+
+    //! entry of the central directory as read from the mapping
+    struct CentralEntry {
+        //! -1 if the entry is encrypted
+        int64_t LocalHeaderOffset;
+        uint64_t ContentHash;
+    };
+
+    //! entries in the order of the central directory. returns false if the archive is not supported
+    bool ReadCentralDirectory(std::vector<CentralEntry>& entries) const;
+
 public:
-    PackFile(zip_t* zipPtr, bool isUsePassword = false);
+    PackFile(zip_t* zipPtr, const std::u16string& path, bool isUsePassword = false);
     virtual ~PackFile();
 
     zip_file_t* Load(const std::u16string& path);
     bool Exists(const std::u16string& path);
     zip_stat_t* GetZipStat(const std::u16string& path);
     bool GetIsUsePassword();
+
+    //! returns nullptr if the path is not contained in the pack
+    const Entry* Find(const std::u16string& path) const;
+    //! pathHash must be GetPathHash(path)
+    const Entry* Find(uint64_t pathHash, const std::u16string& path) const;
+
+    zip_file_t* Load(const Entry& entry);
+    zip_stat_t* GetZipStat(const Entry& entry);
+
+    const std::unordered_multimap<uint64_t, Entry>& GetEntries() const { return m_entries; }
+
+    //! returns the content of a stored (uncompressed and unencrypted) entry in the mapping, or nullptr
+    const uint8_t* GetStoredData(const Entry& entry) const;
+    const std::shared_ptr<MappedFile>& GetMapping() const { return m_mapping; }
+
+    //! hash of a path in the form used as a key of the pack index ('\\' is treated as '/')
+    static uint64_t GetPathHash(const std::u16string& path);
+
+    //! compares paths in the same way as GetPathHash
+    static bool GetIsSamePath(const std::u16string& path1, const std::u16string& path2);
 };
 }  // namespace Altseed2
 
-#endif
\ No newline at end of file
+#endif
@@ -1,11 +1,11 @@
 ﻿#include "PackFileReader.h"
 
 #include <algorithm>
-#include <iterator>
+#include <cstring>
 
 namespace Altseed2 {
 PackFileReader::PackFileReader(zip_file* zipFile, const std::u16string& path, const zip_stat_t* stat)
-    : BaseFileReader(path), m_zipFile(zipFile), m_isUseBuffer(false) {
+    : BaseFileReader(path), m_zipFile(zipFile), m_mappedData(nullptr), m_isUseBuffer(false) {
     if (stat != nullptr) {
         std::unique_lock<std::recursive_mutex> lock(readerMtx_);
 
@@ -17,10 +17,17 @@ PackFileReader::PackFileReader(zip_file* zipFile, const std::u16string& path, co
     }
 }
 
-PackFileReader::~PackFileReader() { zip_fclose(m_zipFile); }
+PackFileReader::PackFileReader(const std::shared_ptr<MappedFile>& mapping, const uint8_t* data, int64_t size, const std::u16string& path)
+    : BaseFileReader(path), m_zipFile(nullptr), m_mapping(mapping), m_mappedData(data), m_isUseBuffer(false) {
+    length_ = size;
+}
+
+PackFileReader::~PackFileReader() {
+    if (m_zipFile != nullptr) zip_fclose(m_zipFile);
+}
 
 int64_t PackFileReader::GetSize() {
-    if (length_ < 0) {
+    if (length_ < 0 && m_zipFile != nullptr) {
         std::unique_lock<std::recursive_mutex> lock(readerMtx_);
 
         zip_fseek(m_zipFile, 0, SEEK_END);
@@ -32,23 +39,25 @@ int64_t PackFileReader::GetSize() {
     return length_;
 }
 
-void PackFileReader::ReadBytes(std::vector<uint8_t>& buffer, const int64_t count) {
+int64_t PackFileReader::Read(void* buffer, const int64_t count) {
     std::unique_lock<std::recursive_mutex> lock(readerMtx_);
 
-    if (position_ + count > GetSize() || count < 0) {
-        buffer.resize(0);
-        buffer.clear();
-        return;
-    }
+    const auto readSize = std::min(count, GetSize() - position_);
+    if (readSize <= 0) return 0;
 
-    if (m_isUseBuffer)
-        std::copy(m_buffer.begin() + position_, m_buffer.begin() + position_ + count, std::back_inserter(buffer));
+    if (m_mappedData != nullptr)
+        memcpy(buffer, m_mappedData + position_, static_cast<size_t>(readSize));
+    else if (m_isUseBuffer)
+        memcpy(buffer, m_buffer.data() + position_, static_cast<size_t>(readSize));
     else {
-        buffer.resize(count);
-        zip_fread(m_zipFile, reinterpret_cast<char*>(&buffer[0]), count);
+        const auto actual = zip_fread(m_zipFile, buffer, readSize);
+        if (actual <= 0) return 0;
+        position_ += actual;
+        return actual;
     }
 
-    position_ += count;
+    position_ += readSize;
+    return readSize;
 }
 
 void PackFileReader::Seek(const int64_t offset, const SeekOrigin origin) {
@@ -56,15 +65,15 @@ void PackFileReader::Seek(const int64_t offset, const SeekOrigin origin) {
 
     switch (origin) {
         case SeekOrigin::Begin:
-            if (!m_isUseBuffer) zip_fseek(m_zipFile, offset, SEEK_SET);
+            if (m_zipFile != nullptr && !m_isUseBuffer) zip_fseek(m_zipFile, offset, SEEK_SET);
             position_ = offset;
             break;
         case SeekOrigin::Current:
-            if (!m_isUseBuffer) zip_fseek(m_zipFile, offset, SEEK_CUR);
+            if (m_zipFile != nullptr && !m_isUseBuffer) zip_fseek(m_zipFile, offset, SEEK_CUR);
             position_ += offset;
             break;
         case SeekOrigin::End:
-            if (!m_isUseBuffer) zip_fseek(m_zipFile, offset, SEEK_CUR);
+            if (m_zipFile != nullptr && !m_isUseBuffer) zip_fseek(m_zipFile, offset, SEEK_CUR);
             position_ = GetSize();
             break;
         default:
@@ -74,4 +83,9 @@ void PackFileReader::Seek(const int64_t offset, const SeekOrigin origin) {
 
 bool PackFileReader::GetIsInPackage() const { return true; }
 
+const void* PackFileReader::GetMappedData(std::shared_ptr<MappedFile>& mapping) {
+    mapping = m_mapping;
+    return m_mappedData;
+}
+
 }  // namespace Altseed2
\ No newline at end of file
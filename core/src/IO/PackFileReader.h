@@ -12,21 +12,30 @@ class PackFileReader : public BaseFileReader {
 private:
     zip_file* m_zipFile;
 
+    //! content of a stored entry in the mapped pack
+    std::shared_ptr<MappedFile> m_mapping;
+    const uint8_t* m_mappedData;
+
     // ! libzip can not zip_ftell and zip_fseek to packed file with password
     std::vector<uint8_t> m_buffer;
     bool m_isUseBuffer;
 
 public:
     PackFileReader(zip_file* zipFile, const std::u16string& path, const zip_stat_t* stat = nullptr);
+
+    //! reads a stored entry directly from the mapping of the pack
+    PackFileReader(const std::shared_ptr<MappedFile>& mapping, const uint8_t* data, int64_t size, const std::u16string& path);
     virtual ~PackFileReader();
 
     int64_t GetSize() override;
 
-    void ReadBytes(std::vector<uint8_t>& buffer, const int64_t count) override;
+    int64_t Read(void* buffer, const int64_t count) override;
 
     void Seek(const int64_t offset, const SeekOrigin origin = SeekOrigin::Begin) override;
 
     bool GetIsInPackage() const override;
+
+    const void* GetMappedData(std::shared_ptr<MappedFile>& mapping) override;
 };
 }  // namespace Altseed2
 
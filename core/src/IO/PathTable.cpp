@@ -0,0 +1,148 @@
+#include "PathTable.h"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../Platform/FileSystem.h"
+#include "PackFile.h"
+
+namespace Altseed2 {
+
+namespace {
+
+constexpr int32_t ShardCount = 16;
+
+//! FNV-1a of the path as requested
+uint64_t GetRawHash(const char16_t* path, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<uint64_t>(path[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+class Table {
+private:
+    struct Entry : InternedPath {
+        //! raw hashes of the aliases added for the entry, guarded by internedMtx_
+        std::vector<uint64_t> AliasHashes;
+    };
+
+    //! a path as requested, which may differ from the normalized one
+    struct Alias {
+        std::u16string Path;
+        std::weak_ptr<Entry> Interned;
+    };
+
+    struct Shard {
+        std::unordered_multimap<uint64_t, Alias> Aliases;
+        std::mutex Mtx;
+    };
+
+    std::array<Shard, ShardCount> shards_;
+
+    //! entries being removed may stay expired here until their deleters lock internedMtx_
+    //! internedMtx_ is locked before the locks of shards, and only Remove holds both
+    std::unordered_map<std::u16string, std::weak_ptr<Entry>> interned_;
+    std::mutex internedMtx_;
+
+    Shard& GetShard(uint64_t hash) { return shards_[(hash >> 16) % ShardCount]; }
+
+    static std::shared_ptr<Entry> Find(Shard& shard, uint64_t hash, const char16_t* path, size_t length) {
+        const auto range = shard.Aliases.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            const auto& alias = it->second.Path;
+            if (alias.size() == length && std::char_traits<char16_t>::compare(alias.data(), path, length) == 0) {
+                if (auto found = it->second.Interned.lock()) return found;
+            }
+        }
+        return nullptr;
+    }
+
+    //! called when the last pointer to entry is released
+    void Remove(Entry* entry) {
+        std::lock_guard<std::mutex> lock(internedMtx_);
+
+        // the path may have been interned again meanwhile
+        auto it = interned_.find(entry->Path);
+        if (it != interned_.end() && it->second.expired()) interned_.erase(it);
+
+        for (const auto hash : entry->AliasHashes) {
+            auto& shard = GetShard(hash);
+            std::lock_guard<std::mutex> shardLock(shard.Mtx);
+
+            const auto range = shard.Aliases.equal_range(hash);
+            for (auto alias = range.first; alias != range.second;) {
+                alias = alias->second.Interned.expired() ? shard.Aliases.erase(alias) : std::next(alias);
+            }
+        }
+
+        delete entry;
+    }
+
+public:
+    std::shared_ptr<const InternedPath> Intern(const char16_t* path, size_t length) {
+        const auto hash = GetRawHash(path, length);
+        auto& shard = GetShard(hash);
+
+        {
+            std::lock_guard<std::mutex> lock(shard.Mtx);
+            if (auto found = Find(shard, hash, path, length)) return found;
+        }
+
+        // normalized outside of the locks, only once for each path as requested
+        std::u16string source(path, length);
+        auto normalized = FileSystem::NormalizePath(source);
+
+        std::shared_ptr<Entry> interned;
+        {
+            std::lock_guard<std::mutex> lock(internedMtx_);
+            auto& entry = interned_[normalized];
+            interned = entry.lock();
+            if (interned == nullptr) {
+                interned = std::shared_ptr<Entry>(new Entry(), [this](Entry* e) { Remove(e); });
+                interned->Hash = PackFile::GetPathHash(normalized);
+                interned->Path = std::move(normalized);
+                entry = interned;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(shard.Mtx);
+
+            // another thread may have added the same path meanwhile
+            // interned is released after the lock, as its deleter may run
+            if (auto found = Find(shard, hash, path, length)) return found;
+
+            shard.Aliases.emplace(hash, Alias{std::move(source), interned});
+        }
+
+        // interned is kept alive here, so Remove can not read the hashes yet
+        std::lock_guard<std::mutex> lock(internedMtx_);
+        interned->AliasHashes.push_back(hash);
+        return interned;
+    }
+
+    int32_t GetCount() {
+        std::lock_guard<std::mutex> lock(internedMtx_);
+        return static_cast<int32_t>(interned_.size());
+    }
+};
+
+//! never destroyed, because paths may be released by other static destructors
+Table& GetTable() {
+    static auto table = new Table();
+    return *table;
+}
+
+}  // namespace
+
+std::shared_ptr<const InternedPath> PathTable::Intern(const char16_t* path, size_t length) { return GetTable().Intern(path, length); }
+
+int32_t PathTable::GetCount() { return GetTable().GetCount(); }
+
+}  // namespace Altseed2
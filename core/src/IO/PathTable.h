@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#if !USE_CBG
+
+namespace Altseed2 {
+
+//! a path normalized by FileSystem::NormalizePath, with its hash computed once
+struct InternedPath {
+    std::u16string Path;
+
+    //! PackFile::GetPathHash of Path
+    uint64_t Hash;
+};
+
+//! table of the file paths in use
+/**
+    paths which normalize to the same form share one InternedPath, so pointers to it can be compared instead of strings.
+    a path requested again while it is in use is found with one pass over it and without allocations.
+    an entry is removed when the last pointer to it is released, e.g. when the file is unregistered from Resources.
+*/
+class PathTable {
+public:
+    static std::shared_ptr<const InternedPath> Intern(const char16_t* path, size_t length);
+    static std::shared_ptr<const InternedPath> Intern(const char16_t* path) { return Intern(path, std::char_traits<char16_t>::length(path)); }
+    static std::shared_ptr<const InternedPath> Intern(const std::u16string& path) { return Intern(path.data(), path.size()); }
+
+    //! the number of distinct normalized paths in use
+    static int32_t GetCount();
+};
+
+}  // namespace Altseed2
+
+#endif
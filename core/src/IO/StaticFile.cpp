@@ -1,35 +1,97 @@
 ﻿#include "StaticFile.h"
 
+#include <cstring>
 #include <memory>
 #include <vector>
 
 #include "../Logger/Log.h"
+#include "../System/AsyncLoader.h"
 #include "File.h"
 
 namespace Altseed2 {
-std::mutex StaticFile::m_staticFileMtx;
+std::unordered_map<uint64_t, std::weak_ptr<const std::vector<uint8_t>>> StaticFile::m_contents;
+std::mutex StaticFile::m_contentsMtx;
 
 StaticFile::StaticFile(std::shared_ptr<BaseFileReader> reader, std::shared_ptr<Resources>& resources, std::u16string path)
-    : sourcePath_(path), resources_(resources) {
-    std::vector<uint8_t> buffer;
-    reader->ReadAllBytes(buffer);
+    : sourcePath_(path), resources_(resources), contentHash_(0), data_(nullptr) {
+    Load(reader);
+}
 
+bool StaticFile::Load(const std::shared_ptr<BaseFileReader>& reader) {
     path_ = reader->GetFullPath().c_str();
     size_ = reader->GetSize();
     isInPackage_ = reader->GetIsInPackage();
 
-    m_buffer = MakeAsdShared<Int8Array>();
-    for (auto i : buffer) {
-        m_buffer->GetVector().push_back(i);
+    mapping_ = nullptr;
+    ReleaseContent();
+    data_ = nullptr;
+    contentHash_ = reader->GetContentHash();
+
+    // uncompressed entries of packages are mapped directly, and the others are read at once
+    // loose files are read, as a view of a file being edited blocks saving on Windows and raises SIGBUS when it is truncated on Linux
+    if (isInPackage_) {
+        data_ = reader->GetMappedData(mapping_);
+    }
+
+    if (data_ == nullptr) {
+        auto buffer = std::make_shared<std::vector<uint8_t>>();
+        reader->ReadAllBytes(*buffer);
+
+        // the content is shared if the same one is already loaded
+        // only hashes written in packages are used, and none is computed here
+        content_ = contentHash_ != 0 ? ShareContent(contentHash_, buffer) : buffer;
+        data_ = content_->data();
     }
 
     reader->Close();
+
+    // keep the instance which is already handed out
+    {
+        std::lock_guard<std::mutex> lock(bufferMtx_);
+        if (m_buffer != nullptr) {
+            const auto begin = static_cast<const int8_t*>(data_);
+            m_buffer->GetVector().assign(begin, begin + size_);
+        }
+    }
+
+    return true;
+}
+
+std::shared_ptr<const std::vector<uint8_t>> StaticFile::ShareContent(uint64_t hash, const std::shared_ptr<const std::vector<uint8_t>>& content) {
+    std::lock_guard<std::mutex> lock(m_contentsMtx);
+
+    auto& registered = m_contents[hash];
+    auto cache = registered.lock();
+
+    // the hash only narrows down the candidates
+    if (cache != nullptr && cache->size() == content->size() &&
+        (content->empty() || std::memcmp(cache->data(), content->data(), content->size()) == 0)) {
+        return cache;
+    }
+
+    if (cache == nullptr) {
+        registered = content;
+    }
+    return content;
+}
+
+void StaticFile::ReleaseContent() {
+    if (content_ == nullptr) return;
+
+    std::lock_guard<std::mutex> lock(m_contentsMtx);
+    content_ = nullptr;
+
+    auto it = m_contents.find(contentHash_);
+    if (it != m_contents.end() && it->second.expired()) {
+        m_contents.erase(it);
+    }
 }
 
 StaticFile::~StaticFile() {
-    std::lock_guard<std::mutex> lock(m_staticFileMtx);
+    ReleaseContent();
+
     if (sourcePath_ != u"") {
-        resources_->GetResourceContainer(ResourceType::StaticFile)->Unregister(sourcePath_);
+        resources_->GetResourceContainer(ResourceType::StaticFile)->Unregister(sourcePath_, this);
         resources_ = nullptr;
     }
 }
@@ -43,57 +105,90 @@ std::shared_ptr<StaticFile> StaticFile::Create(const char16_t* path) {
         return nullptr;
     }
 
-    std::lock_guard<std::mutex> lock(m_staticFileMtx);
+    // a path requested before is found without normalizing it again
+    const auto path_ = PathTable::Intern(path);
+    auto container = resources->GetResourceContainer(ResourceType::StaticFile);
 
-    auto path_ = FileSystem::NormalizePath(path);
-
-    auto cache = std::dynamic_pointer_cast<StaticFile>(resources->GetResourceContainer(ResourceType::StaticFile)->Get(path_));
-    if (cache != nullptr && cache->GetRef() > 0) {
+    auto cache = std::dynamic_pointer_cast<StaticFile>(container->Get(path_.get()));
+    if (cache != nullptr) {
         return cache;
     }
 
-    auto reader = File::GetInstance()->CreateFileReader(path_.c_str());
+    // read without the lock so that reads of different files overlap
+    auto reader = File::GetInstance()->CreateFileReader(path_);
 
     if (reader == nullptr) return nullptr;
 
-    auto res = MakeAsdShared<StaticFile>(reader, resources, path_);
+    auto res = MakeAsdShared<StaticFile>(reader, resources, path_->Path);
+
+    // the same file may have been read by another thread meanwhile
+    auto loaded = std::dynamic_pointer_cast<StaticFile>(
+            container->GetOrRegister(path_.get(), std::make_shared<ResourceContainer::ResourceInfomation>(res, path_->Path)));
+    if (loaded != res) {
+        res->sourcePath_.clear();
+    } else {
+        res->internedPath_ = path_;
+    }
+
+    return loaded;
+}
+
+std::shared_future<std::shared_ptr<StaticFile>> StaticFile::CreateAsync(const char16_t* path) {
+    RETURN_IF_NULL(path, AsyncLoader::MakeReadyFuture<StaticFile>(nullptr));
 
-    resources->GetResourceContainer(ResourceType::StaticFile)
-            ->Register(path_, std::make_shared<ResourceContainer::ResourceInfomation>(res, path_));
-    return res;
+    auto loader = AsyncLoader::GetInstance();
+    if (loader == nullptr) {
+        Log::GetInstance()->Error(LogCategory::Core, u"StaticFile::CreateAsync: Core is not initialized.");
+        return AsyncLoader::MakeReadyFuture<StaticFile>(nullptr);
+    }
+
+    auto promise = std::make_shared<std::promise<std::shared_ptr<StaticFile>>>();
+    auto future = promise->get_future().share();
+    const std::u16string path_ = path;
+
+    loader->PostIO([promise, path_]() -> void { promise->set_value(Create(path_.c_str())); });
+
+    return future;
 }
 
-const std::shared_ptr<Int8Array>& StaticFile::GetInt8ArrayBuffer() const { return m_buffer; }
+const std::shared_ptr<Int8Array>& StaticFile::GetInt8ArrayBuffer() const {
+    std::lock_guard<std::mutex> lock(bufferMtx_);
+    if (m_buffer == nullptr) {
+        const auto begin = static_cast<const int8_t*>(data_);
+        m_buffer = MakeAsdShared<Int8Array>();
+        m_buffer->GetVector().assign(begin, begin + size_);
+    }
+    return m_buffer;
+}
 
 const char16_t* StaticFile::GetPath() const { return sourcePath_.c_str(); }
 
-const void* StaticFile::GetData() const { return m_buffer->GetData(); }
+const void* StaticFile::GetData() const { return data_; }
+
+std::shared_ptr<const void> StaticFile::GetDataOwner() const {
+    if (mapping_ != nullptr) return std::shared_ptr<const void>(mapping_, data_);
+    return std::shared_ptr<const void>(content_, data_);
+}
 
 int32_t StaticFile::GetSize() { return size_; }
 
 bool StaticFile::GetIsInPackage() const { return isInPackage_; }
 
+int64_t StaticFile::GetMemorySize() const {
+    std::lock_guard<std::mutex> lock(bufferMtx_);
+    return static_cast<int64_t>(size_) + (m_buffer != nullptr ? m_buffer->GetCount() : 0);
+}
+
 bool StaticFile::Reload() {
     if (isInPackage_) return false;
     auto path = path_;
 
-    m_buffer->Clear();
-
     auto file = File::GetInstance()->GetStream(path);
     if (file == nullptr)
         return false;
     auto reader = MakeAsdShared<BaseFileReader>(file, path);
 
-    path_ = reader->GetFullPath().c_str();
-    size_ = reader->GetSize();
-    isInPackage_ = reader->GetIsInPackage();
-
-    std::vector<uint8_t> buffer;
-    reader->ReadAllBytes(buffer);
-    for (auto i : buffer) {
-        m_buffer->GetVector().push_back(i);
-    }
-    return true;
+    return Load(reader);
 }
 
 }  // namespace Altseed2
\ No newline at end of file
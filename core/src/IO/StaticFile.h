@@ -1,28 +1,53 @@
 ﻿#pragma once
 
+#include <future>
 #include <memory>
+#include <unordered_map>
 
 #include "../BaseObject.h"
 #include "../Common/Array.h"
 #include "../Common/Resources.h"
+#include "../Platform/FileSystem.h"
 #include "BaseFileReader.h"
 
 namespace Altseed2 {
 
 class File;
+struct InternedPath;
 
 class StaticFile : public Resource {
 private:
     std::shared_ptr<Resources> resources_;
 
-    std::shared_ptr<Int8Array> m_buffer;
+    //! mapping of a loose file or a stored pack entry, or the bulk read content when it is not mapped
+    std::shared_ptr<MappedFile> mapping_;
+    std::shared_ptr<const std::vector<uint8_t>> content_;
+    uint64_t contentHash_;
+    const void* data_;
+
+    //! copy of the content for GetInt8ArrayBuffer, created on demand
+    mutable std::shared_ptr<Int8Array> m_buffer;
+    mutable std::mutex bufferMtx_;
 
     std::u16string path_;
     std::u16string sourcePath_;
+
+    //! keeps the path interned while the file is registered, so that it is found again without normalizing
+    std::shared_ptr<const InternedPath> internedPath_;
+
     int32_t size_;
     bool isInPackage_;
 
-    static std::mutex m_staticFileMtx;
+    //! content hash -> bulk read content, shared by the files with the same content
+    static std::unordered_map<uint64_t, std::weak_ptr<const std::vector<uint8_t>>> m_contents;
+    static std::mutex m_contentsMtx;
+
+    //! returns the content equal to content if it is already read, otherwise registers content
+    static std::shared_ptr<const std::vector<uint8_t>> ShareContent(uint64_t hash, const std::shared_ptr<const std::vector<uint8_t>>& content);
+
+    void ReleaseContent();
+
+    bool Load(const std::shared_ptr<BaseFileReader>& reader);
 
 public:
     StaticFile(std::shared_ptr<BaseFileReader> reader, std::shared_ptr<Resources>& resources, std::u16string path);
@@ -30,6 +55,11 @@ public:
 
     static std::shared_ptr<StaticFile> Create(const char16_t* path);
 
+#if !USE_CBG
+    //! reads the file in a background thread
+    static std::shared_future<std::shared_ptr<StaticFile>> CreateAsync(const char16_t* path);
+#endif
+
     const std::shared_ptr<Int8Array>& GetInt8ArrayBuffer() const;
 
     const char16_t* GetPath() const;
@@ -38,6 +68,9 @@ public:
 
     const void* GetData() const;
 
+    //! GetData which stays valid after the file is reloaded, while the returned pointer is kept
+    std::shared_ptr<const void> GetDataOwner() const;
+
 #endif
 
     int32_t GetSize();
@@ -45,6 +78,10 @@ public:
     bool GetIsInPackage() const;
 
     bool Reload() override;
+
+#if !USE_CBG
+    int64_t GetMemorySize() const override;
+#endif
 };
 
 }  // namespace Altseed2
\ No newline at end of file
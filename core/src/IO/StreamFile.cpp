@@ -1,20 +1,41 @@
 ﻿#include "StreamFile.h"
 
+#include <algorithm>
+
 #include "../Logger/Log.h"
 #include "File.h"
 
 namespace Altseed2 {
-std::mutex StreamFile::m_streamFileMtx;
 
 StreamFile::StreamFile(std::shared_ptr<BaseFileReader> reader, std::shared_ptr<Resources>& resources, std::u16string path)
     : m_fileReader(reader), sourcePath_(path), resources_(resources) {
     m_buffer = MakeAsdShared<Int8Array>();
 }
 
+StreamFile::StreamFile(std::shared_ptr<BaseFileReader> reader, std::u16string path, int32_t ringBufferSize)
+    : sourcePath_(path),
+      resources_(nullptr),
+      isStreaming_(true),
+      streamSize_(static_cast<int32_t>(reader->GetSize())),
+      isStreamInPackage_(reader->GetIsInPackage()) {
+    m_buffer = MakeAsdShared<Int8Array>();
+    ring_.resize(ringBufferSize);
+}
+
 StreamFile::~StreamFile() {
-    std::lock_guard<std::mutex> lock(m_streamFileMtx);
+    if (isStreaming_) {
+        {
+            std::lock_guard<std::mutex> lock(ringMtx_);
+            isStopping_ = true;
+        }
+        ringCv_.notify_all();
+
+        if (readAheadThread_.joinable()) readAheadThread_.join();
+        return;
+    }
+
     if (sourcePath_ != u"") {
-        resources_->GetResourceContainer(ResourceType::StreamFile)->Unregister(sourcePath_);
+        resources_->GetResourceContainer(ResourceType::StreamFile)->Unregister(sourcePath_, this);
         resources_ = nullptr;
     }
 }
@@ -28,42 +49,166 @@ std::shared_ptr<StreamFile> StreamFile::Create(const char16_t* path) {
         return nullptr;
     }
 
-    std::lock_guard<std::mutex> lock(m_streamFileMtx);
+    const auto path_ = PathTable::Intern(path);
 
-    auto path_ = FileSystem::NormalizePath(path);
-
-    auto cache = std::dynamic_pointer_cast<StreamFile>(resources->GetResourceContainer(ResourceType::StreamFile)->Get(path_));
-    if (cache != nullptr && cache->GetRef() > 0) {
+    auto cache = std::dynamic_pointer_cast<StreamFile>(resources->GetResourceContainer(ResourceType::StreamFile)->Get(path_.get()));
+    if (cache != nullptr) {
         return cache;
     }
 
-    auto reader = File::GetInstance()->CreateFileReader(path_.c_str());
+    auto reader = File::GetInstance()->CreateFileReader(path_);
 
     if (reader == nullptr) return nullptr;
 
-    auto res = MakeAsdShared<StreamFile>(reader, resources, path_);
+    auto res = MakeAsdShared<StreamFile>(reader, resources, path_->Path);
+
+    // the same file may have been opened by another thread meanwhile
+    auto loaded = std::dynamic_pointer_cast<StreamFile>(
+            resources->GetResourceContainer(ResourceType::StreamFile)
+                    ->GetOrRegister(path_.get(), std::make_shared<ResourceContainer::ResourceInfomation>(res, path_->Path)));
+    if (loaded != res) {
+        res->sourcePath_.clear();
+    } else {
+        res->internedPath_ = path_;
+    }
+    return loaded;
+}
+
+std::shared_ptr<StreamFile> StreamFile::CreateStreaming(const char16_t* path, int32_t ringBufferSize) {
+    RETURN_IF_NULL(path, nullptr);
+
+    if (ringBufferSize <= 0) {
+        Log::GetInstance()->Error(LogCategory::Core, u"StreamFile::CreateStreaming: ringBufferSize must be positive");
+        return nullptr;
+    }
+
+    if (File::GetInstance() == nullptr) {
+        Log::GetInstance()->Error(LogCategory::Core, u"File is not initialized.");
+        return nullptr;
+    }
+
+    const auto path_ = PathTable::Intern(path);
+
+    auto reader = File::GetInstance()->CreateFileReader(path_);
+    if (reader == nullptr) return nullptr;
 
-    resources->GetResourceContainer(ResourceType::StreamFile)
-            ->Register(path_, std::make_shared<ResourceContainer::ResourceInfomation>(res, path_));
+    auto res = MakeAsdShared<StreamFile>(reader, path_->Path, ringBufferSize);
+    res->readAheadThread_ = std::thread([res_ = res.get(), reader]() -> void { res_->ReadAheadLoop(reader); });
     return res;
 }
 
-int32_t StreamFile::GetSize() const { return m_fileReader->GetSize(); }
+void StreamFile::ReadAheadLoop(std::shared_ptr<BaseFileReader> reader) {
+    const auto size = static_cast<int64_t>(streamSize_);
+    const auto ringSize = static_cast<int64_t>(ring_.size());
+
+    while (true) {
+        int64_t offset = 0;
+        int64_t count = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(ringMtx_);
+            ringCv_.wait(lock, [&]() -> bool { return isStopping_ || ringWritePos_ - ringReadPos_ < ringSize; });
+            if (isStopping_) return;
+
+            const auto free = ringSize - (ringWritePos_ - ringReadPos_);
+            offset = ringWritePos_ % ringSize;
+            count = std::min({free, ringSize - offset, static_cast<int64_t>(ReadAheadBlockSize), size - ringWritePos_});
+        }
+
+        if (count > 0) {
+            // the region is not visible to the consumer until ringWritePos_ is advanced
+            if (reader->Read(ring_.data() + offset, count) != count) {
+                Log::GetInstance()->Error(LogCategory::Core, u"StreamFile::ReadAheadLoop: Failed to read '{0}'", utf16_to_utf8(sourcePath_).c_str());
+                count = 0;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(ringMtx_);
+            ringWritePos_ += count;
+            if (count == 0 || ringWritePos_ == size) isEndOfStream_ = true;
+        }
+        ringCv_.notify_all();
+
+        if (isEndOfStream_) {
+            reader->Close();
+            return;
+        }
+    }
+}
+
+bool StreamFile::AcquireChunk(const void*& data, int32_t& size, int32_t maxSize) {
+    data = nullptr;
+    size = 0;
+    if (!isStreaming_ || maxSize < 0) return false;
 
-int32_t StreamFile::GetCurrentPosition() const { return m_fileReader->GetPosition(); }
+    std::unique_lock<std::mutex> lock(ringMtx_);
+    ringCv_.wait(lock, [this]() -> bool { return isStopping_ || isEndOfStream_ || ringWritePos_ > ringReadPos_; });
+
+    const auto ringSize = static_cast<int64_t>(ring_.size());
+    const auto offset = ringReadPos_ % ringSize;
+
+    // a view is contiguous, so it stops at the end of the ring
+    const auto count = std::min({ringWritePos_ - ringReadPos_, ringSize - offset, static_cast<int64_t>(maxSize)});
+    data = ring_.data() + offset;
+    size = static_cast<int32_t>(count);
+    return true;
+}
+
+void StreamFile::ReleaseChunk(int32_t size) {
+    if (!isStreaming_ || size <= 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock(ringMtx_);
+        ringReadPos_ += std::min(static_cast<int64_t>(size), ringWritePos_ - ringReadPos_);
+    }
+    ringCv_.notify_all();
+}
+
+int32_t StreamFile::GetSize() const {
+    if (isStreaming_) return streamSize_;
+    return m_fileReader->GetSize();
+}
+
+int32_t StreamFile::GetCurrentPosition() const {
+    if (isStreaming_) {
+        std::lock_guard<std::mutex> lock(ringMtx_);
+        return static_cast<int32_t>(ringReadPos_);
+    }
+    return m_fileReader->GetPosition();
+}
 
 int32_t StreamFile::Read(int32_t size) {
+    if (isStreaming_) {
+        // the temp buffer holds only the last read bytes
+        auto& vec = m_buffer->GetVector();
+        vec.clear();
+
+        while (static_cast<int32_t>(vec.size()) < size) {
+            const void* data = nullptr;
+            int32_t count = 0;
+            if (!AcquireChunk(data, count, size - static_cast<int32_t>(vec.size())) || count == 0) break;
+
+            const auto begin = static_cast<const int8_t*>(data);
+            vec.insert(vec.end(), begin, begin + count);
+            ReleaseChunk(count);
+        }
+
+        return static_cast<int32_t>(vec.size());
+    }
+
     if (GetCurrentPosition() == GetSize()) return 0;
 
-    std::vector<uint8_t> buffer;
     int readSize = size;
 
     if (GetCurrentPosition() + size >= GetSize()) readSize = GetSize() - GetCurrentPosition();
 
-    m_fileReader->ReadBytes(buffer, readSize);
-    for (auto i : buffer) {
-        m_buffer->GetVector().push_back(i);
-    }
+    // read directly into the end of the temp buffer
+    auto& vec = m_buffer->GetVector();
+    const auto current = vec.size();
+    vec.resize(current + readSize);
+    readSize = static_cast<int32_t>(m_fileReader->Read(vec.data() + current, readSize));
+    vec.resize(current + readSize);
 
     if (GetCurrentPosition() == GetSize())
         m_fileReader->Close();
@@ -75,10 +220,15 @@ std::shared_ptr<Int8Array>& StreamFile::GetInt8ArrayTempBuffer() { return m_buff
 
 int32_t StreamFile::GetTempBufferSize() { return m_buffer->GetCount(); }
 
-bool StreamFile::GetIsInPackage() const { return m_fileReader->GetIsInPackage(); }
+bool StreamFile::GetIsInPackage() const {
+    if (isStreaming_) return isStreamInPackage_;
+    return m_fileReader->GetIsInPackage();
+}
+
+int64_t StreamFile::GetMemorySize() const { return static_cast<int64_t>(m_buffer->GetVector().capacity()) + ring_.size(); }
 
 bool StreamFile::Reload() {
-    if (m_fileReader->GetIsInPackage()) return false;
+    if (isStreaming_ || m_fileReader->GetIsInPackage()) return false;
     auto path = m_fileReader->GetFullPath();
 
     m_buffer->Clear();
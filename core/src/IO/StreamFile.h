@@ -1,6 +1,11 @@
 ﻿#pragma once
 
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "../BaseObject.h"
 #include "../Common/Array.h"
@@ -9,6 +14,7 @@
 
 namespace Altseed2 {
 class File;
+struct InternedPath;
 
 class StreamFile : public Resource {
 private:
@@ -19,14 +25,55 @@ private:
 
     std::u16string sourcePath_;
 
-    static std::mutex m_streamFileMtx;
+    //! keeps the path interned while the file is registered, so that it is found again without normalizing
+    std::shared_ptr<const InternedPath> internedPath_;
+
+    //! streaming mode: a fixed ring buffer filled ahead by a background thread
+    //! the thread owns the reader, so m_fileReader is null and its properties are copied on construction
+    bool isStreaming_ = false;
+    int32_t streamSize_ = 0;
+    bool isStreamInPackage_ = false;
+    std::vector<uint8_t> ring_;
+    //! total bytes consumed / produced
+    int64_t ringReadPos_ = 0;
+    int64_t ringWritePos_ = 0;
+    bool isEndOfStream_ = false;
+    bool isStopping_ = false;
+    mutable std::mutex ringMtx_;
+    std::condition_variable ringCv_;
+    std::thread readAheadThread_;
+
+    void ReadAheadLoop(std::shared_ptr<BaseFileReader> reader);
 
 public:
+    static const int32_t DefaultRingBufferSize = 1024 * 1024;
+    static const int32_t ReadAheadBlockSize = 64 * 1024;
+
     StreamFile(std::shared_ptr<BaseFileReader> reader, std::shared_ptr<Resources>& resources, std::u16string path);
+
+#if !USE_CBG
+    //! for streaming mode
+    StreamFile(std::shared_ptr<BaseFileReader> reader, std::u16string path, int32_t ringBufferSize);
+#endif
     virtual ~StreamFile();
 
     static std::shared_ptr<StreamFile> Create(const char16_t* path);
 
+#if !USE_CBG
+    //! creates a stream which is not shared through the cache and keeps at most ringBufferSize bytes in memory
+    //! Read replaces the temp buffer instead of appending to it
+    static std::shared_ptr<StreamFile> CreateStreaming(const char16_t* path, int32_t ringBufferSize = DefaultRingBufferSize);
+
+    //! returns a view of the next bytes which are already read. blocks until some bytes are available
+    //! size is 0 at the end of the file. the view is valid until ReleaseChunk
+    bool AcquireChunk(const void*& data, int32_t& size, int32_t maxSize = INT32_MAX);
+
+    //! consumes size bytes of the view returned by AcquireChunk
+    void ReleaseChunk(int32_t size);
+
+    bool GetIsStreaming() const { return isStreaming_; }
+#endif
+
     int32_t GetSize() const;
 
     int32_t GetCurrentPosition() const;
@@ -41,6 +88,10 @@ public:
 
     bool Reload() override;
 
+#if !USE_CBG
+    int64_t GetMemorySize() const override;
+#endif
+
     const char16_t* GetPath() const;
 };
 
@@ -1,5 +1,6 @@
 #include "Log.h"
 
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
@@ -11,9 +12,25 @@
 
 namespace Altseed2 {
 
+namespace {
+
+//! the number of messages which can wait for the background thread. the oldest ones are dropped when it is full
+constexpr size_t AsyncQueueSize = 8192;
+
+//! states of the rate limit are removed when they exceed this
+constexpr size_t MaxRateLimitStateCount = 1024;
+
+}  // namespace
+
 std::shared_ptr<Log> Log::instance_;
 
-bool Log::Initialize(bool enabledConsoleLogging, bool enabledFileLogging, std::u16string filename) {
+const char* Log::ToUtf8Format(const char16_t* format) {
+    thread_local std::string buffer;
+    utf16_to_utf8(format, std::char_traits<char16_t>::length(format), buffer);
+    return buffer.c_str();
+}
+
+bool Log::Initialize(bool enabledConsoleLogging, bool enabledFileLogging, std::u16string filename, bool isAsync) {
     try {
         instance_ = MakeAsdShared<Log>();
 
@@ -32,11 +49,22 @@ bool Log::Initialize(bool enabledConsoleLogging, bool enabledFileLogging, std::u
             multi_sinks_.push_back(file_sink);
         }
 
+        if (isAsync) {
+            instance_->threadPool_ = std::make_shared<spdlog::details::thread_pool>(AsyncQueueSize, 1);
+        }
+
         const auto create_logger = [multi_sinks_](const auto category, const auto name) {
             std::vector<spdlog::sink_ptr> multi_sinks(multi_sinks_.size());
             std::copy(multi_sinks_.begin(), multi_sinks_.end(), multi_sinks.begin());
 
-            const auto logger = std::make_shared<spdlog::logger>(name, multi_sinks.begin(), multi_sinks.end());
+            std::shared_ptr<spdlog::logger> logger;
+            if (instance_->threadPool_ != nullptr) {
+                // the caller is not blocked even if the queue is full
+                logger = std::make_shared<spdlog::async_logger>(
+                        name, multi_sinks.begin(), multi_sinks.end(), instance_->threadPool_, spdlog::async_overflow_policy::overrun_oldest);
+            } else {
+                logger = std::make_shared<spdlog::logger>(name, multi_sinks.begin(), multi_sinks.end());
+            }
             logger->set_level((spdlog::level::level_enum)LogLevel::Trace);
             instance_->loggers_[static_cast<int32_t>(category)] = logger;
         };
@@ -63,4 +91,62 @@ void Log::SetLevel(LogCategory category, LogLevel level) {
     loggers_[(int32_t)category]->set_level((spdlog::level::level_enum)level);
 }
 
+void Log::SetRateLimit(int32_t count, float interval) {
+    std::lock_guard<std::mutex> lock(rateLimitMtx_);
+    rateLimitCount_ = count;
+    rateLimitInterval_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(interval));
+    rateLimitStates_.clear();
+}
+
+bool Log::CountRateLimit(LogCategory category, LogLevel level, const char16_t* format) {
+    // FNV-1a of the format, the category and the level
+    uint64_t hash = 14695981039346656037ULL;
+    hash = (hash ^ static_cast<uint64_t>(category)) * 1099511628211ULL;
+    hash = (hash ^ static_cast<uint64_t>(level)) * 1099511628211ULL;
+    for (auto c = format; *c != 0; c++) {
+        hash = (hash ^ static_cast<uint64_t>(*c)) * 1099511628211ULL;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    int32_t suppressedCount = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(rateLimitMtx_);
+
+        if (rateLimitCount_ <= 0) return true;
+
+        auto it = rateLimitStates_.find(hash);
+        if (it == rateLimitStates_.end()) {
+            if (rateLimitStates_.size() >= MaxRateLimitStateCount) {
+                for (auto s = rateLimitStates_.begin(); s != rateLimitStates_.end();) {
+                    s = now - s->second.Start >= rateLimitInterval_ ? rateLimitStates_.erase(s) : std::next(s);
+                }
+
+                if (rateLimitStates_.size() >= MaxRateLimitStateCount) rateLimitStates_.clear();
+            }
+
+            rateLimitStates_.emplace(hash, RateLimitState{now, 1, 0});
+            return true;
+        }
+
+        auto& state = it->second;
+        if (now - state.Start >= rateLimitInterval_) {
+            suppressedCount = state.SuppressedCount;
+            state = RateLimitState{now, 1, 0};
+        } else if (state.Count < rateLimitCount_) {
+            state.Count++;
+        } else {
+            state.SuppressedCount++;
+            return false;
+        }
+    }
+
+    if (suppressedCount > 0) {
+        loggers_[static_cast<int32_t>(category)]->log(
+                static_cast<spdlog::level::level_enum>(level), "{0} messages like the next one were suppressed", suppressedCount);
+    }
+
+    return true;
+}
+
 }  // namespace Altseed2
@@ -2,14 +2,29 @@
 
 #include <spdlog/spdlog.h>
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "../BaseObject.h"
 #include "../Common/Assertion.h"
 #include "../Common/StringHelper.h"
 
+//! LOG_TRACE, ..., LOG_ERROR under this level (0: Trace, 1: Debug, 2: Info, 3: Warn, 4: Error) are removed at compile time
+#ifndef ALTSEED2_LOG_ACTIVE_LEVEL
+#define ALTSEED2_LOG_ACTIVE_LEVEL 0
+#endif
+
+namespace spdlog {
+namespace details {
+class thread_pool;
+}  // namespace details
+}  // namespace spdlog
+
 namespace Altseed2 {
 #if !USE_CBG
 
@@ -54,43 +69,125 @@ enum class LogCategory : int32_t {
     } while (false)
 #endif
 
+//! arguments are not evaluated if the message is filtered out by the level or the rate limit
+#define LOG_WRITE(CATEGORY, LEVEL, FORMAT, ...)                                                          \
+    do {                                                                                                 \
+        if (Log::GetInstance() != nullptr && Log::GetInstance()->ShouldWrite(CATEGORY, LEVEL, FORMAT)) { \
+            Log::GetInstance()->WriteWithoutFilter(CATEGORY, LEVEL, FORMAT, ##__VA_ARGS__);              \
+        }                                                                                                \
+    } while (false)
+
+#define LOG_DISABLED(...) \
+    do {                  \
+    } while (false)
+
+#if ALTSEED2_LOG_ACTIVE_LEVEL <= 0
+#define LOG_TRACE(CATEGORY, FORMAT, ...) LOG_WRITE(CATEGORY, LogLevel::Trace, FORMAT, ##__VA_ARGS__)
+#else
+#define LOG_TRACE(...) LOG_DISABLED()
+#endif
+
+#if ALTSEED2_LOG_ACTIVE_LEVEL <= 1
+#define LOG_DEBUG(CATEGORY, FORMAT, ...) LOG_WRITE(CATEGORY, LogLevel::Debug, FORMAT, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(...) LOG_DISABLED()
+#endif
+
+#if ALTSEED2_LOG_ACTIVE_LEVEL <= 2
+#define LOG_INFO(CATEGORY, FORMAT, ...) LOG_WRITE(CATEGORY, LogLevel::Info, FORMAT, ##__VA_ARGS__)
+#else
+#define LOG_INFO(...) LOG_DISABLED()
+#endif
+
+#if ALTSEED2_LOG_ACTIVE_LEVEL <= 3
+#define LOG_WARN(CATEGORY, FORMAT, ...) LOG_WRITE(CATEGORY, LogLevel::Warn, FORMAT, ##__VA_ARGS__)
+#else
+#define LOG_WARN(...) LOG_DISABLED()
+#endif
+
+#if ALTSEED2_LOG_ACTIVE_LEVEL <= 4
+#define LOG_ERROR(CATEGORY, FORMAT, ...) LOG_WRITE(CATEGORY, LogLevel::Error, FORMAT, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(...) LOG_DISABLED()
+#endif
+
 class Log : public BaseObject {
 private:
+    //! state of the rate limit for each format
+    struct RateLimitState {
+        std::chrono::steady_clock::time_point Start;
+        int32_t Count;
+        int32_t SuppressedCount;
+    };
+
     static std::shared_ptr<Log> instance_;
     bool enabledLogging_;
+
+    //! declared before loggers_ so that the messages in the queue are written after the loggers are released
+    std::shared_ptr<spdlog::details::thread_pool> threadPool_;
     std::unordered_map<int32_t, std::shared_ptr<spdlog::logger>> loggers_;
 
+    std::mutex rateLimitMtx_;
+    std::unordered_map<uint64_t, RateLimitState> rateLimitStates_;
+    //! disabled by default, so that messages of the public API are not dropped unless it is requested
+    std::atomic<int32_t> rateLimitCount_{0};
+    std::chrono::steady_clock::duration rateLimitInterval_ = std::chrono::seconds(1);
+
+    //! converts a format into the buffer of the calling thread, which is overwritten by the next call
+    static const char* ToUtf8Format(const char16_t* format);
+
+    //! returns whether a message is under the rate limit, and counts it
+    bool CountRateLimit(LogCategory category, LogLevel level, const char16_t* format);
+
 public:
-    static bool Initialize(bool enabledConsoleLogging, bool enabledFileLogging, std::u16string filename);
+    //! messages are written by a background thread if isAsync is true
+    static bool Initialize(bool enabledConsoleLogging, bool enabledFileLogging, std::u16string filename, bool isAsync = false);
 
     static void Terminate();
 
     static std::shared_ptr<Log>& GetInstance();
 
+    //! returns whether a message is written, without converting or formatting it
+    /**
+        messages which have the same format are written up to the count of the rate limit in each interval.
+        the number of suppressed messages is written when the next interval begins.
+    */
+    bool ShouldWrite(LogCategory category, LogLevel level, const char16_t* format) {
+        if (!enabledLogging_ || level == LogLevel::Off) return false;
+        if (!loggers_[static_cast<int32_t>(category)]->should_log(static_cast<spdlog::level::level_enum>(level))) return false;
+        return rateLimitCount_ <= 0 || CountRateLimit(category, level, format);
+    }
+
     template <typename... Args>
     void Write(LogCategory category, LogLevel level, const char16_t* format, const Args&... args) {
-        if (GetInstance() == nullptr || !GetInstance()->enabledLogging_ || level == LogLevel::Off) return;
+        if (GetInstance() == nullptr || !ShouldWrite(category, level, format)) return;
+        WriteWithoutFilter(category, level, format, args...);
+    }
 
-        const auto logger = loggers_[static_cast<int32_t>(category)];
+    //! writes a message which has passed ShouldWrite
+    template <typename... Args>
+    void WriteWithoutFilter(LogCategory category, LogLevel level, const char16_t* format, const Args&... args) {
+        const auto& logger = loggers_[static_cast<int32_t>(category)];
+        const auto format8 = ToUtf8Format(format);
 
         switch (level) {
             case LogLevel::Trace:
-                logger->trace(utf16_to_utf8(format).c_str(), args...);
+                logger->trace(format8, args...);
                 break;
             case LogLevel::Debug:
-                logger->debug(utf16_to_utf8(format).c_str(), args...);
+                logger->debug(format8, args...);
                 break;
             case LogLevel::Info:
-                logger->info(utf16_to_utf8(format).c_str(), args...);
+                logger->info(format8, args...);
                 break;
             case LogLevel::Warn:
-                logger->warn(utf16_to_utf8(format).c_str(), args...);
+                logger->warn(format8, args...);
                 break;
             case LogLevel::Error:
-                logger->error(utf16_to_utf8(format).c_str(), args...);
+                logger->error(format8, args...);
                 break;
             case LogLevel::Critical:
-                logger->critical(utf16_to_utf8(format).c_str(), args...);
+                logger->critical(format8, args...);
                 break;
             default:
                 ASD_ASSERT(false, "Unexpected LogLevel");
@@ -138,6 +235,9 @@ public:
     }
 
     void SetLevel(LogCategory category, LogLevel level);
+
+    //! writes up to count messages which have the same format in each interval (seconds). disabled if count is 0 or less (default)
+    void SetRateLimit(int32_t count, float interval);
 };
 #endif
 
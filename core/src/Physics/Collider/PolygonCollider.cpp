@@ -27,12 +27,13 @@ void PolygonCollider::SetVertexes(std::shared_ptr<Vector2FArray> vertexes) {
 }
 
 void PolygonCollider::SetDefaultIndexBuffer() {
-    auto vs = vertexes_->GetVector();
-    if (vs.size() < 3) {
+    auto vs = vertexes_->GetPointer();
+    auto count = vertexes_->GetCount();
+    if (count < 3) {
         buffers_->GetVector().resize(0);
         return;
     }
-    auto length = vs.size() - 2;
+    auto length = count - 2;
     buffers_->GetVector().resize(length * 3);
     triangles_.resize(length);
 
@@ -43,9 +44,9 @@ void PolygonCollider::SetDefaultIndexBuffer() {
 
         b2PolygonShape triangle;
         triangle.m_count = 3;
-        triangle.m_vertices[0] = Box2DHelper::ToBox2D_Vec(vertexes_->GetVector()[0]);
-        triangle.m_vertices[1] = Box2DHelper::ToBox2D_Vec(vertexes_->GetVector()[i + 1]);
-        triangle.m_vertices[2] = Box2DHelper::ToBox2D_Vec(vertexes_->GetVector()[i + 2]);
+        triangle.m_vertices[0] = Box2DHelper::ToBox2D_Vec(vs[0]);
+        triangle.m_vertices[1] = Box2DHelper::ToBox2D_Vec(vs[i + 1]);
+        triangle.m_vertices[2] = Box2DHelper::ToBox2D_Vec(vs[i + 2]);
         triangles_[i] = triangle;
     }
 
@@ -53,9 +54,11 @@ void PolygonCollider::SetDefaultIndexBuffer() {
 }
 
 void PolygonCollider::UpdateTriangles() {
-    auto buffers = buffers_->GetVector();
-    auto count = buffers.size() / 3;
-    auto vertexesSize = vertexes_->GetVector().size();
+    // read through the pointers so that neither the indexes nor borrowed vertexes are copied
+    auto buffers = buffers_->GetPointer();
+    auto count = buffers_->GetCount() / 3;
+    auto vs = vertexes_->GetPointer();
+    auto vertexesSize = vertexes_->GetCount();
 
     triangles_.resize(count);
     auto skipCount = 0;
@@ -66,9 +69,9 @@ void PolygonCollider::UpdateTriangles() {
         if (ib1 >= vertexesSize || ib2 >= vertexesSize || ib3 >= vertexesSize) continue;
         b2PolygonShape triangle;
         triangle.m_count = 3;
-        triangle.m_vertices[0] = Box2DHelper::ToBox2D_Vec(vertexes_->GetVector()[ib1]);
-        triangle.m_vertices[1] = Box2DHelper::ToBox2D_Vec(vertexes_->GetVector()[ib2]);
-        triangle.m_vertices[2] = Box2DHelper::ToBox2D_Vec(vertexes_->GetVector()[ib3]);
+        triangle.m_vertices[0] = Box2DHelper::ToBox2D_Vec(vs[ib1]);
+        triangle.m_vertices[1] = Box2DHelper::ToBox2D_Vec(vs[ib2]);
+        triangle.m_vertices[2] = Box2DHelper::ToBox2D_Vec(vs[ib3]);
         triangles_[i] = triangle;
     }
 
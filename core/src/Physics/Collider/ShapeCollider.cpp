@@ -17,13 +17,14 @@ std::shared_ptr<ShapeCollider> ShapeCollider::Create() { return MakeAsdShared<Sh
 
 std::shared_ptr<Vector2FArray> ShapeCollider::GetVertexes() const { return vertexes_; }
 void ShapeCollider::SetVertexes(const std::shared_ptr<Vector2FArray>& vertexes) {
-    if (vertexes->GetVector().size() > b2_maxPolygonVertices) {
+    if (vertexes->GetCount() > b2_maxPolygonVertices) {
         Log::GetInstance()->Error(LogCategory::Core, u"頂点数は8つまでです");
         return;
     }
     vertexes_ = vertexes;
-    shape_.m_count = vertexes->GetVector().size();
-    for (int i = 0; i < vertexes->GetVector().size(); i++) shape_.m_vertices[i] = Box2DHelper::ToBox2D_Vec(vertexes_->GetVector()[i]);
+    shape_.m_count = vertexes->GetCount();
+    auto vs = vertexes->GetPointer();
+    for (int i = 0; i < shape_.m_count; i++) shape_.m_vertices[i] = Box2DHelper::ToBox2D_Vec(vs[i]);
 }
 
 }  // namespace Altseed2
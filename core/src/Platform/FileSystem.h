@@ -1,7 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #ifdef _WIN32
@@ -11,6 +16,111 @@
 #if !USE_CBG
 
 namespace Altseed2 {
+
+//! read-only memory mapping of a whole file
+class MappedFile {
+private:
+    void* data_;
+    int64_t size_;
+
+    //! platform specific handles (Windows)
+    void* fileHandle_;
+    void* mappingHandle_;
+
+public:
+    MappedFile(void* data, int64_t size, void* fileHandle, void* mappingHandle)
+        : data_(data), size_(size), fileHandle_(fileHandle), mappingHandle_(mappingHandle) {}
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const void* GetData() const { return data_; }
+    int64_t GetSize() const { return size_; }
+};
+
+//! notifies creation, deletion, renaming and writes of files under directories
+//! uses inotify on Linux, ReadDirectoryChangesW on Windows and FSEvents on macOS
+class DirectoryWatcher {
+public:
+    //! called on the watching thread with the path of the changed file or directory
+    using Callback = std::function<void(const std::u16string& path)>;
+
+private:
+    Callback callback_;
+
+#if defined(_WIN32)
+    //! a directory opened for ReadDirectoryChangesW
+    struct Watch;
+
+    //! platform specific handles (events)
+    void* stopHandle_;
+    void* wakeHandle_;
+
+    std::mutex watchesMtx_;
+    std::vector<std::unique_ptr<Watch>> watches_;
+
+    std::thread thread_;
+
+    void ThreadLoop();
+#elif defined(__APPLE__)
+    struct Watch {
+        //! path as added
+        std::u16string Path;
+        //! path as reported by FSEvents (symbolic links are resolved)
+        std::string RealPath;
+        bool IsRecursive;
+    };
+
+    //! platform specific handles (FSEventStreamRef, dispatch_queue_t)
+    //! watches_ and stream_ are used only on the queue, where the callback is also called
+    void* stream_;
+    void* queue_;
+
+    std::vector<Watch> watches_;
+
+    //! callbacks of FSEvents and the queue
+    struct EventHandler;
+
+    //! returns false if the stream can not be started
+    bool RestartStream();
+#else
+    //! platform specific handles (inotify)
+    int32_t handle_;
+    int32_t stopHandle_;
+
+    struct Watch {
+        std::u16string Path;
+        //! directories created under it are also watched
+        bool IsRecursive = false;
+    };
+
+    std::mutex watchesMtx_;
+    std::unordered_map<int32_t, Watch> watches_;
+
+    std::thread thread_;
+
+    void ThreadLoop();
+    bool AddWatch(const std::u16string& path, bool isRecursive);
+#endif
+
+    //! creates platform specific handles and starts watching
+    bool Initialize();
+
+public:
+    DirectoryWatcher(const Callback& callback);
+    ~DirectoryWatcher();
+
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+    //! returns nullptr if watching is not supported
+    static std::shared_ptr<DirectoryWatcher> Create(const Callback& callback);
+
+    //! subdirectories including the ones created later are watched if isRecursive
+    bool AddDirectory(const std::u16string& path, bool isRecursive = true);
+};
+
 class FileSystem {
 public:
     static bool GetIsFile(const std::u16string& path);
@@ -24,6 +134,9 @@ public:
     static bool GetIsAbsolutePath(const std::u16string& path);
     static std::u16string NormalizePath(const std::u16string& path);
     static std::u16string GetFileName(const std::u16string& path, bool withExtension = true);
+
+    //! returns nullptr if the file can not be mapped (e.g. empty file)
+    static std::shared_ptr<MappedFile> MapFile(const std::u16string& path);
 };
 }  // namespace Altseed2
 
@@ -6,8 +6,18 @@ namespace fs = std::filesystem;
 namespace fs = std::experimental::filesystem;
 #endif
 
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <cerrno>
 
+#include "../Common/StringHelper.h"
 #include "FileSystem.h"
 
 namespace Altseed2 {
@@ -58,4 +68,145 @@ std::u16string FileSystem::GetFileName(const std::u16string& path, bool withExte
     }
 }
 
-}  // namespace Altseed2
\ No newline at end of file
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        munmap(data_, static_cast<size_t>(size_));
+    }
+}
+
+std::shared_ptr<MappedFile> FileSystem::MapFile(const std::u16string& path) {
+    const auto fd = open(utf16_to_utf8(path).c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    auto data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // the mapping is kept after the descriptor is closed
+    close(fd);
+
+    if (data == MAP_FAILED) return nullptr;
+
+    return std::make_shared<MappedFile>(data, static_cast<int64_t>(st.st_size), nullptr, nullptr);
+}
+
+DirectoryWatcher::DirectoryWatcher(const Callback& callback) : callback_(callback), handle_(-1), stopHandle_(-1) {}
+
+DirectoryWatcher::~DirectoryWatcher() {
+    if (thread_.joinable()) {
+        // wake the thread up from poll
+        const uint64_t one = 1;
+        while (write(stopHandle_, &one, sizeof(one)) < 0 && errno == EINTR) {
+        }
+
+        thread_.join();
+    }
+
+    if (handle_ >= 0) close(handle_);
+    if (stopHandle_ >= 0) close(stopHandle_);
+}
+
+bool DirectoryWatcher::Initialize() {
+    handle_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (handle_ < 0) return false;
+
+    stopHandle_ = eventfd(0, EFD_CLOEXEC);
+    if (stopHandle_ < 0) return false;
+
+    thread_ = std::thread([this]() -> void { this->ThreadLoop(); });
+    return true;
+}
+
+std::shared_ptr<DirectoryWatcher> DirectoryWatcher::Create(const Callback& callback) {
+    auto watcher = std::make_shared<DirectoryWatcher>(callback);
+    if (!watcher->Initialize()) return nullptr;
+    return watcher;
+}
+
+bool DirectoryWatcher::AddWatch(const std::u16string& path, bool isRecursive) {
+    const uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_DELETE_SELF;
+    const auto wd = inotify_add_watch(handle_, utf16_to_utf8(path).c_str(), mask);
+    if (wd < 0) return false;
+
+    std::lock_guard<std::mutex> lock(watchesMtx_);
+    // a directory added again as recursive stays recursive
+    auto& watch = watches_[wd];
+    watch.Path = path;
+    watch.IsRecursive = watch.IsRecursive || isRecursive;
+    return true;
+}
+
+bool DirectoryWatcher::AddDirectory(const std::u16string& path, bool isRecursive) {
+    auto path_ = FileSystem::NormalizePath(path);
+    while (path_.size() > 1 && path_.back() == u'/') path_.pop_back();
+
+    if (!FileSystem::GetIsDirectory(path_)) return false;
+
+    if (!AddWatch(path_, isRecursive)) return false;
+    if (!isRecursive) return true;
+
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(path_, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (it->is_directory(ec) && !AddWatch(it->path().u16string(), true)) return false;
+    }
+    return !ec;
+}
+
+void DirectoryWatcher::ThreadLoop() {
+    alignas(inotify_event) char buffer[4096];
+
+    pollfd fds[2];
+    fds[0].fd = handle_;
+    fds[0].events = POLLIN;
+    fds[1].fd = stopHandle_;
+    fds[1].events = POLLIN;
+
+    while (true) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+
+        if (fds[1].revents & POLLIN) return;
+        if (!(fds[0].revents & POLLIN)) continue;
+
+        while (true) {
+            const auto length = read(handle_, buffer, sizeof(buffer));
+            if (length <= 0) break;
+
+            for (ssize_t i = 0; i < length;) {
+                const auto event = reinterpret_cast<const inotify_event*>(buffer + i);
+                i += sizeof(inotify_event) + event->len;
+
+                std::u16string directory;
+                bool isRecursive = false;
+                {
+                    std::lock_guard<std::mutex> lock(watchesMtx_);
+                    auto it = watches_.find(event->wd);
+                    if (it == watches_.end()) continue;
+                    directory = it->second.Path;
+                    isRecursive = it->second.IsRecursive;
+
+                    if (event->mask & IN_IGNORED) {
+                        watches_.erase(it);
+                        continue;
+                    }
+                }
+
+                const auto path = event->len > 0 ? directory + u"/" + utf8_to_utf16(event->name) : directory;
+
+                if (isRecursive && (event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO))) {
+                    AddDirectory(path, true);
+                }
+
+                callback_(path);
+            }
+        }
+    }
+}
+
+}  // namespace Altseed2
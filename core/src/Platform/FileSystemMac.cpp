@@ -1,8 +1,15 @@
+#include <CoreServices/CoreServices.h>
 #include <dirent.h>
+#include <dispatch/dispatch.h>
+#include <fcntl.h>
 #include <libgen.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
+
+#include <climits>
 
 #include "../Common/StringHelper.h"
 #include "FileSystem.h"
@@ -113,4 +120,164 @@ std::u16string FileSystem::GetFileName(const std::u16string& path, bool withExte
     }
 }
 
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        munmap(data_, static_cast<size_t>(size_));
+    }
+}
+
+std::shared_ptr<MappedFile> FileSystem::MapFile(const std::u16string& path) {
+    const auto fd = open(utf16_to_utf8(path).c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    auto data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // the mapping is kept after the descriptor is closed
+    close(fd);
+
+    if (data == MAP_FAILED) return nullptr;
+
+    return std::make_shared<MappedFile>(data, static_cast<int64_t>(st.st_size), nullptr, nullptr);
+}
+
+struct DirectoryWatcher::EventHandler {
+    struct Addition {
+        DirectoryWatcher* Watcher;
+        Watch Added;
+        bool Result;
+    };
+
+    static void OnEvents(
+            ConstFSEventStreamRef stream,
+            void* info,
+            size_t count,
+            void* paths,
+            const FSEventStreamEventFlags flags[],
+            const FSEventStreamEventId ids[]) {
+        auto watcher = static_cast<DirectoryWatcher*>(info);
+        const auto paths_ = static_cast<const char* const*>(paths);
+
+        for (size_t i = 0; i < count; i++) {
+            std::string path = paths_[i];
+            while (path.size() > 1 && path.back() == '/') path.pop_back();
+
+            // reported paths are real paths, so they are mapped back to the paths as added
+            for (const auto& watch : watcher->watches_) {
+                const auto& realPath = watch.RealPath;
+                if (path.compare(0, realPath.size(), realPath) != 0) continue;
+                if (path.size() > realPath.size() && path[realPath.size()] != '/') continue;
+
+                const auto relative = path.size() > realPath.size() ? path.substr(realPath.size() + 1) : std::string();
+                if (!watch.IsRecursive && relative.find('/') != std::string::npos) continue;
+
+                watcher->callback_(relative.empty() ? watch.Path : watch.Path + u"/" + utf8_to_utf16(relative));
+            }
+        }
+    }
+
+    static void Add(void* context) {
+        auto addition = static_cast<Addition*>(context);
+        auto watcher = addition->Watcher;
+
+        watcher->watches_.push_back(addition->Added);
+        addition->Result = watcher->RestartStream();
+        if (!addition->Result) {
+            watcher->watches_.pop_back();
+            watcher->RestartStream();
+        }
+    }
+
+    static void Stop(void* context) {
+        auto watcher = static_cast<DirectoryWatcher*>(context);
+        watcher->watches_.clear();
+        watcher->RestartStream();
+    }
+};
+
+DirectoryWatcher::DirectoryWatcher(const Callback& callback) : callback_(callback), stream_(nullptr), queue_(nullptr) {}
+
+DirectoryWatcher::~DirectoryWatcher() {
+    if (queue_ != nullptr) {
+        auto queue = static_cast<dispatch_queue_t>(queue_);
+
+        // waits for the callback running on the queue
+        dispatch_sync_f(queue, this, &EventHandler::Stop);
+        dispatch_release(queue);
+    }
+}
+
+bool DirectoryWatcher::Initialize() {
+    queue_ = dispatch_queue_create("Altseed2.DirectoryWatcher", DISPATCH_QUEUE_SERIAL);
+    return queue_ != nullptr;
+}
+
+std::shared_ptr<DirectoryWatcher> DirectoryWatcher::Create(const Callback& callback) {
+    auto watcher = std::make_shared<DirectoryWatcher>(callback);
+    if (!watcher->Initialize()) return nullptr;
+    return watcher;
+}
+
+bool DirectoryWatcher::RestartStream() {
+    // the paths of a stream can not be changed, so it is recreated. changes in between are not reported
+    if (stream_ != nullptr) {
+        auto stream = static_cast<FSEventStreamRef>(stream_);
+        FSEventStreamStop(stream);
+        FSEventStreamInvalidate(stream);
+        FSEventStreamRelease(stream);
+        stream_ = nullptr;
+    }
+
+    if (watches_.empty()) return true;
+
+    auto paths = CFArrayCreateMutable(kCFAllocatorDefault, 0, &kCFTypeArrayCallBacks);
+    for (const auto& watch : watches_) {
+        auto path = CFStringCreateWithCString(kCFAllocatorDefault, watch.RealPath.c_str(), kCFStringEncodingUTF8);
+        CFArrayAppendValue(paths, path);
+        CFRelease(path);
+    }
+
+    FSEventStreamContext context = {0, this, nullptr, nullptr, nullptr};
+    auto stream = FSEventStreamCreate(
+            kCFAllocatorDefault,
+            &EventHandler::OnEvents,
+            &context,
+            paths,
+            kFSEventStreamEventIdSinceNow,
+            0.05,
+            kFSEventStreamCreateFlagFileEvents | kFSEventStreamCreateFlagNoDefer);
+    CFRelease(paths);
+    if (stream == nullptr) return false;
+
+    FSEventStreamSetDispatchQueue(stream, static_cast<dispatch_queue_t>(queue_));
+    if (!FSEventStreamStart(stream)) {
+        FSEventStreamInvalidate(stream);
+        FSEventStreamRelease(stream);
+        return false;
+    }
+
+    stream_ = stream;
+    return true;
+}
+
+bool DirectoryWatcher::AddDirectory(const std::u16string& path, bool isRecursive) {
+    auto path_ = FileSystem::NormalizePath(path);
+    while (path_.size() > 1 && path_.back() == u'/') path_.pop_back();
+
+    if (!FileSystem::GetIsDirectory(path_)) return false;
+
+    char realPath[PATH_MAX];
+    if (realpath(utf16_to_utf8(path_).c_str(), realPath) == nullptr) return false;
+
+    // subdirectories are always watched by FSEvents, so events under them are filtered if not isRecursive
+    EventHandler::Addition addition{this, Watch{path_, realPath, isRecursive}, false};
+    dispatch_sync_f(static_cast<dispatch_queue_t>(queue_), &addition, &EventHandler::Add);
+    return addition.Result;
+}
+
 }  // namespace Altseed2
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <filesystem>
 namespace fs = std::filesystem;
 
@@ -49,4 +50,200 @@ std::u16string FileSystem::GetFileName(const std::u16string& path, bool withExte
     }
 }
 
-}  // namespace Altseed2
\ No newline at end of file
+}  // namespace Altseed2
+
+// included after the definitions above so that its macros (CreateDirectory, min, max) do not rename them
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+
+namespace Altseed2 {
+
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mappingHandle_ != nullptr) {
+        CloseHandle(mappingHandle_);
+    }
+    if (fileHandle_ != nullptr) {
+        CloseHandle(fileHandle_);
+    }
+}
+
+std::shared_ptr<MappedFile> FileSystem::MapFile(const std::u16string& path) {
+    auto file = CreateFileW(
+            reinterpret_cast<const wchar_t*>(path.c_str()), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    return std::make_shared<MappedFile>(data, static_cast<int64_t>(size.QuadPart), file, mapping);
+}
+
+struct DirectoryWatcher::Watch {
+    //! path as added, ending with a separator
+    std::u16string Path;
+    bool IsRecursive;
+
+    HANDLE Directory;
+    OVERLAPPED Overlapped;
+
+    //! reads are issued by the watching thread, because they are canceled when the issuing thread exits
+    bool IsReading;
+
+    //! FILE_NOTIFY_INFORMATION must be DWORD aligned
+    alignas(DWORD) uint8_t Buffer[16 * 1024];
+
+    bool BeginRead() {
+        const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+        IsReading = ReadDirectoryChangesW(Directory, Buffer, sizeof(Buffer), IsRecursive ? TRUE : FALSE, filter, nullptr, &Overlapped, nullptr) != FALSE;
+        return IsReading;
+    }
+
+    ~Watch() {
+        if (IsReading) {
+            CancelIoEx(Directory, &Overlapped);
+            DWORD bytes = 0;
+            GetOverlappedResult(Directory, &Overlapped, &bytes, TRUE);
+        }
+        if (Overlapped.hEvent != nullptr) CloseHandle(Overlapped.hEvent);
+        if (Directory != INVALID_HANDLE_VALUE) CloseHandle(Directory);
+    }
+};
+
+DirectoryWatcher::DirectoryWatcher(const Callback& callback) : callback_(callback), stopHandle_(nullptr), wakeHandle_(nullptr) {}
+
+DirectoryWatcher::~DirectoryWatcher() {
+    if (thread_.joinable()) {
+        SetEvent(stopHandle_);
+        thread_.join();
+    }
+
+    watches_.clear();
+
+    if (stopHandle_ != nullptr) CloseHandle(stopHandle_);
+    if (wakeHandle_ != nullptr) CloseHandle(wakeHandle_);
+}
+
+bool DirectoryWatcher::Initialize() {
+    stopHandle_ = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (stopHandle_ == nullptr) return false;
+
+    wakeHandle_ = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    if (wakeHandle_ == nullptr) return false;
+
+    thread_ = std::thread([this]() -> void { this->ThreadLoop(); });
+    return true;
+}
+
+std::shared_ptr<DirectoryWatcher> DirectoryWatcher::Create(const Callback& callback) {
+    auto watcher = std::make_shared<DirectoryWatcher>(callback);
+    if (!watcher->Initialize()) return nullptr;
+    return watcher;
+}
+
+bool DirectoryWatcher::AddDirectory(const std::u16string& path, bool isRecursive) {
+    if (!FileSystem::GetIsDirectory(path)) return false;
+
+    auto watch = std::make_unique<Watch>();
+    watch->Path = path;
+    if (watch->Path.back() != u'/' && watch->Path.back() != u'\\') watch->Path += u'/';
+    watch->IsRecursive = isRecursive;
+    watch->IsReading = false;
+    ZeroMemory(&watch->Overlapped, sizeof(watch->Overlapped));
+
+    watch->Directory = CreateFileW(
+            reinterpret_cast<const wchar_t*>(path.c_str()),
+            FILE_LIST_DIRECTORY,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+            nullptr);
+    if (watch->Directory == INVALID_HANDLE_VALUE) return false;
+
+    watch->Overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (watch->Overlapped.hEvent == nullptr) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(watchesMtx_);
+
+        // the stop and wake events share the limit of WaitForMultipleObjects. subdirectories do not need their own watches
+        if (watches_.size() + 2 >= MAXIMUM_WAIT_OBJECTS) return false;
+        watches_.push_back(std::move(watch));
+    }
+
+    SetEvent(wakeHandle_);
+    return true;
+}
+
+void DirectoryWatcher::ThreadLoop() {
+    std::vector<HANDLE> events;
+    std::vector<Watch*> watches;
+
+    while (true) {
+        events.assign({stopHandle_, wakeHandle_});
+        watches.clear();
+        {
+            std::lock_guard<std::mutex> lock(watchesMtx_);
+            for (const auto& watch : watches_) {
+                if (!watch->IsReading && !watch->BeginRead()) continue;
+                events.push_back(watch->Overlapped.hEvent);
+                watches.push_back(watch.get());
+            }
+        }
+
+        const auto result = WaitForMultipleObjects(static_cast<DWORD>(events.size()), events.data(), FALSE, INFINITE);
+        if (result == WAIT_OBJECT_0 || result == WAIT_FAILED) return;
+        if (result < WAIT_OBJECT_0 + 2 || result >= WAIT_OBJECT_0 + events.size()) continue;
+
+        auto watch = watches[result - WAIT_OBJECT_0 - 2];
+        watch->IsReading = false;
+
+        DWORD bytes = 0;
+        const auto isSucceeded = GetOverlappedResult(watch->Directory, &watch->Overlapped, &bytes, FALSE);
+        ResetEvent(watch->Overlapped.hEvent);
+        if (!isSucceeded) continue;
+
+        if (bytes == 0) {
+            // the buffer overflowed, so anything under the directory may have changed
+            callback_(watch->Path);
+            continue;
+        }
+
+        for (DWORD offset = 0;;) {
+            const auto info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(watch->Buffer + offset);
+
+            std::u16string name(reinterpret_cast<const char16_t*>(info->FileName), info->FileNameLength / sizeof(WCHAR));
+            std::replace(name.begin(), name.end(), u'\\', u'/');
+            callback_(watch->Path + name);
+
+            if (info->NextEntryOffset == 0) break;
+            offset += info->NextEntryOffset;
+        }
+    }
+}
+
+}  // namespace Altseed2
@@ -1,19 +1,17 @@
 ﻿#include "Sound.h"
 
 #include "../Logger/Log.h"
+#include "../System/AsyncLoader.h"
 
 namespace Altseed2 {
 
-std::mutex Sound::mtx;
-
-Sound::Sound(std::u16string filePath, std::shared_ptr<osm::Sound> sound, bool isDecompressed, std::shared_ptr<Resources> resources)
-    : m_filePath(filePath), m_sound(sound), m_isDecompressed(isDecompressed), resources_(resources) {
+Sound::Sound(std::u16string filePath, std::shared_ptr<osm::Sound> sound, bool isDecompressed, int64_t dataSize, std::shared_ptr<Resources> resources)
+    : m_filePath(filePath), m_sound(sound), m_isDecompressed(isDecompressed), m_dataSize(dataSize), resources_(resources) {
     SetInstanceName(__FILE__);
 }
 
 Sound::~Sound() {
-    std::lock_guard<std::mutex> lock(mtx);
-    resources_->GetResourceContainer(ResourceType::Sound)->Unregister(GetPath());
+    resources_->GetResourceContainer(ResourceType::Sound)->Unregister(GetPath(), this);
     resources_ = nullptr;
 }
 
@@ -31,10 +29,8 @@ std::shared_ptr<Sound> Sound::Load(const char16_t* path, bool isDecompressed) {
         return nullptr;
     }
 
-    std::lock_guard<std::mutex> lock(mtx);
-
     auto cache = std::dynamic_pointer_cast<Sound>(soundMixer->m_resources->GetResourceContainer(ResourceType::Sound)->Get(path));
-    if (cache != nullptr && cache->GetRef() > 0) {
+    if (cache != nullptr) {
         return cache;
     }
 
@@ -46,19 +42,80 @@ std::shared_ptr<Sound> Sound::Load(const char16_t* path, bool isDecompressed) {
     }
 
     // Get data & Create OSM sound & null check
-    auto sound = CreateSharedPtr(soundMixer->m_manager->CreateSound(staticFile->GetData(), staticFile->GetSize(), isDecompressed));
+    std::shared_ptr<osm::Sound> sound;
+    {
+        std::lock_guard<std::mutex> lock(soundMixer->m_managerMtx);
+        sound = CreateSharedPtr(soundMixer->m_manager->CreateSound(staticFile->GetData(), staticFile->GetSize(), isDecompressed));
+    }
     if (sound == nullptr) {
         Log::GetInstance()->Error(LogCategory::Core, u"Sound::Load: Failed to create sound from '{0}'", utf16_to_utf8(path).c_str());
         return nullptr;
     }
 
     // Create sound & register to container
-    auto soundRet = MakeAsdShared<Sound>(std::u16string(path), sound, isDecompressed, soundMixer->m_resources);
+    auto soundRet = MakeAsdShared<Sound>(std::u16string(path), sound, isDecompressed, staticFile->GetSize(), soundMixer->m_resources);
     auto soundContainer = soundMixer->m_resources->GetResourceContainer(ResourceType::Sound);
     auto soundInfo = std::make_shared<ResourceContainer::ResourceInfomation>(soundRet, path);
-    soundContainer->Register(path, soundInfo);
 
-    return soundRet;
+    // the same path may have been loaded by another thread meanwhile
+    return std::dynamic_pointer_cast<Sound>(soundContainer->GetOrRegister(path, soundInfo));
+}
+
+std::shared_future<std::shared_ptr<Sound>> Sound::LoadAsync(const char16_t* path, bool isDecompressed) {
+    RETURN_IF_NULL(path, AsyncLoader::MakeReadyFuture<Sound>(nullptr));
+
+    auto soundMixer = SoundMixer::GetInstance();
+    if (soundMixer == nullptr || AsyncLoader::GetInstance() == nullptr) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Sound is not initialized.");
+        return AsyncLoader::MakeReadyFuture<Sound>(nullptr);
+    }
+
+    if (soundMixer->m_manager == nullptr) {
+        Log::GetInstance()->Error(LogCategory::Core, u"Sound is not enabled.");
+        return AsyncLoader::MakeReadyFuture<Sound>(nullptr);
+    }
+
+    auto promise = std::make_shared<std::promise<std::shared_ptr<Sound>>>();
+    auto future = promise->get_future().share();
+    const std::u16string path_ = path;
+
+    AsyncLoader::GetInstance()->PostIO([promise, path_, isDecompressed, soundMixer]() -> void {
+        auto cache = std::dynamic_pointer_cast<Sound>(soundMixer->m_resources->GetResourceContainer(ResourceType::Sound)->Get(path_));
+        if (cache != nullptr) {
+            promise->set_value(cache);
+            return;
+        }
+
+        auto staticFile = StaticFile::Create(path_.c_str());
+        if (staticFile == nullptr) {
+            Log::GetInstance()->Error(LogCategory::Core, u"Sound::LoadAsync: Failed to create file from '{0}'", utf16_to_utf8(path_).c_str());
+            promise->set_value(nullptr);
+            return;
+        }
+
+        AsyncLoader::GetInstance()->PostDecode([promise, path_, isDecompressed, soundMixer, staticFile]() -> void {
+            // decoding in other workers waits here
+            std::shared_ptr<osm::Sound> sound;
+            {
+                std::lock_guard<std::mutex> lock(soundMixer->m_managerMtx);
+                sound = CreateSharedPtr(soundMixer->m_manager->CreateSound(staticFile->GetData(), staticFile->GetSize(), isDecompressed));
+            }
+            if (sound == nullptr) {
+                Log::GetInstance()->Error(LogCategory::Core, u"Sound::LoadAsync: Failed to create sound from '{0}'", utf16_to_utf8(path_).c_str());
+                promise->set_value(nullptr);
+                return;
+            }
+
+            auto soundContainer = soundMixer->m_resources->GetResourceContainer(ResourceType::Sound);
+            auto soundRet = MakeAsdShared<Sound>(path_, sound, isDecompressed, staticFile->GetSize(), soundMixer->m_resources);
+
+            // the same path may have been loaded while decoding
+            promise->set_value(std::dynamic_pointer_cast<Sound>(
+                    soundContainer->GetOrRegister(path_, std::make_shared<ResourceContainer::ResourceInfomation>(soundRet, path_))));
+        });
+    });
+
+    return future;
 }
 
 float Sound::GetLoopStartingPoint() const { return m_sound->GetLoopStartingPoint(); }
@@ -79,6 +136,13 @@ const char16_t* Sound::GetPath() const { return m_filePath.c_str(); }
 
 bool Sound::GetIsDecompressed() const { return m_isDecompressed; }
 
+int64_t Sound::GetMemorySize() const {
+    if (!m_isDecompressed) return m_dataSize;
+
+    // decoded into 16bit stereo PCM at 44100Hz
+    return static_cast<int64_t>(m_sound->GetLength() * 44100.0f) * 2 * sizeof(int16_t);
+}
+
 bool Sound::Reload() {
     /*
     auto ls = m_sound->GetLoopStartingPoint();
@@ -2,6 +2,8 @@
 
 #include <OpenSoundMixer.h>
 
+#include <future>
+
 #include "../Common/Resources.h"
 #include "../Common/ThreadSafeMap.h"
 #include "SoundMixer.h"
@@ -20,13 +22,12 @@ private:
 
     std::u16string m_filePath;
     const bool m_isDecompressed;
+    const int64_t m_dataSize;
 
     std::shared_ptr<Resources> resources_;
 
-    static std::mutex mtx;
-
 public:
-    Sound(std::u16string filePath, std::shared_ptr<osm::Sound> sound, bool isDecompressed, std::shared_ptr<Resources> resources);
+    Sound(std::u16string filePath, std::shared_ptr<osm::Sound> sound, bool isDecompressed, int64_t dataSize, std::shared_ptr<Resources> resources);
     virtual ~Sound();
 
     /**
@@ -37,6 +38,11 @@ public:
     */
     static std::shared_ptr<Sound> Load(const char16_t* path, bool isDecompressed);
 
+#if !USE_CBG
+    //! reads the file and decodes it in background threads
+    static std::shared_future<std::shared_ptr<Sound>> LoadAsync(const char16_t* path, bool isDecompressed);
+#endif
+
     /**
     @brief  ループポイントの開始地点(秒)を取得する
     @return 開始地点(秒)
@@ -87,6 +93,8 @@ public:
 
     std::shared_ptr<osm::Sound> GetSound() { return m_sound; }
 
+
+    int64_t GetMemorySize() const override;
 #endif
     bool Reload() override;
 };
@@ -192,7 +192,7 @@ void SoundMixer::Reload() {
         return;
     }
     auto container = m_resources->GetResourceContainer(ResourceType::Sound);
-    for (auto sound : container->GetAllResouces()) sound.second->Reload(0);
+    for (auto sound : container->GetAllResouces()) sound->Reload(0);
 }
 
 }  // namespace Altseed2
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <OpenSoundMixer.h>
 
+#include <mutex>
+
 #include "../BaseObject.h"
 #include "../Common/ResourceContainer.h"
 #include "../Common/Resources.h"
@@ -30,6 +32,9 @@ private:
     std::shared_ptr<osm::Manager> m_manager;
     std::shared_ptr<Resources> m_resources;
 
+    //! OpenSoundMixer is not thread safe, so sounds are created one at a time
+    std::mutex m_managerMtx;
+
 public:
 #if !USE_CBG
     static bool Initialize(bool isReloadingEnabled);
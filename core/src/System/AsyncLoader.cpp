@@ -0,0 +1,48 @@
+#include "AsyncLoader.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "SynchronizationContext.h"
+
+namespace Altseed2 {
+
+std::shared_ptr<AsyncLoader> AsyncLoader::instance_;
+
+AsyncLoader::AsyncLoader(int32_t ioThreadCount, int32_t decodeThreadCount)
+    : ioPool_(std::make_unique<ThreadPool>(ioThreadCount)), decodePool_(std::make_unique<ThreadPool>(decodeThreadCount)) {}
+
+AsyncLoader::~AsyncLoader() {}
+
+bool AsyncLoader::Initialize() {
+    // reads are mostly waiting, decoding uses the cores except the main thread
+    const auto concurrency = static_cast<int32_t>(std::thread::hardware_concurrency());
+    instance_ = MakeAsdShared<AsyncLoader>(2, std::max(1, concurrency - 1));
+    return true;
+}
+
+void AsyncLoader::Terminate() {
+    if (instance_ == nullptr) return;
+
+    // finish pending loads while the other modules are still alive
+    instance_->ioPool_->Stop();
+    instance_->decodePool_->Stop();
+    instance_ = nullptr;
+}
+
+std::shared_ptr<AsyncLoader>& AsyncLoader::GetInstance() { return instance_; }
+
+void AsyncLoader::PostIO(const std::function<void()>& task) { ioPool_->Post(task); }
+
+void AsyncLoader::PostDecode(const std::function<void()>& task) { decodePool_->Post(task); }
+
+void AsyncLoader::PostMain(const std::function<void()>& task) {
+    auto context = SynchronizationContext::GetInstance();
+    if (context == nullptr) {
+        task();
+        return;
+    }
+    context->AddEvent(task);
+}
+
+}  // namespace Altseed2
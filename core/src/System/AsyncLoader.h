@@ -0,0 +1,53 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+
+#include "../BaseObject.h"
+#include "ThreadPool.h"
+
+#if !USE_CBG
+
+namespace Altseed2 {
+
+//! background pools used by LoadAsync of resources
+//! file reads run on the I/O pool, decoding on the decode pool and GPU uploads on the main thread through SynchronizationContext
+class AsyncLoader : public BaseObject {
+private:
+    static std::shared_ptr<AsyncLoader> instance_;
+
+    std::unique_ptr<ThreadPool> ioPool_;
+    std::unique_ptr<ThreadPool> decodePool_;
+
+public:
+    AsyncLoader(int32_t ioThreadCount, int32_t decodeThreadCount);
+    virtual ~AsyncLoader();
+
+    static bool Initialize();
+
+    static void Terminate();
+
+    static std::shared_ptr<AsyncLoader>& GetInstance();
+
+    void PostIO(const std::function<void()>& task);
+
+    void PostDecode(const std::function<void()>& task);
+
+    //! runs task in Core::DoEvent on the main thread
+    void PostMain(const std::function<void()>& task);
+
+    int32_t GetDecodeThreadCount() const { return decodePool_->GetThreadCount(); }
+
+    //! returns a future which already has the value
+    template <typename T>
+    static std::shared_future<std::shared_ptr<T>> MakeReadyFuture(const std::shared_ptr<T>& value) {
+        std::promise<std::shared_ptr<T>> promise;
+        promise.set_value(value);
+        return promise.get_future().share();
+    }
+};
+
+}  // namespace Altseed2
+
+#endif
@@ -7,15 +7,25 @@ std::shared_ptr<SynchronizationContext> SynchronizationContext::instance_;
 void SynchronizationContext::AddEvent(const std::function<void()>& f) {
     auto e = std::make_unique<Event>();
     e->f = f;
+
+    std::lock_guard<std::mutex> lock(eventsMtx_);
     events_.push_back(std::move(e));
 }
 
-void SynchronizationContext::Run() {
-    for (auto& e : events_) {
+bool SynchronizationContext::Run() {
+    std::vector<std::unique_ptr<Event>> events;
+
+    {
+        std::lock_guard<std::mutex> lock(eventsMtx_);
+        events.swap(events_);
+    }
+
+    // events added while running are called in the next Run
+    for (auto& e : events) {
         e->Call();
     }
 
-    events_.clear();
+    return !events.empty();
 }
 
 void SynchronizationContext::Initialize() { instance_ = MakeAsdShared<SynchronizationContext>(); }
@@ -3,6 +3,7 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "../BaseObject.h"
@@ -23,10 +24,14 @@ private:
 
     std::vector<std::unique_ptr<Event>> events_;
 
+    //! events are added from worker threads of AsyncLoader
+    std::mutex eventsMtx_;
+
 public:
     void AddEvent(const std::function<void()>& f);
 
-    void Run();
+    //! returns false if there were no events
+    bool Run();
 
     static void Initialize();
 
@@ -0,0 +1,62 @@
+#include "ThreadPool.h"
+
+namespace Altseed2 {
+
+ThreadPool::ThreadPool(int32_t threadCount) {
+    if (threadCount < 1) threadCount = 1;
+
+    threads_.reserve(threadCount);
+    for (int32_t i = 0; i < threadCount; i++) {
+        threads_.emplace_back([this]() -> void { this->ThreadLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() { Stop(); }
+
+void ThreadPool::ThreadLoop() {
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            cv_.wait(lock, [this]() -> bool { return isStopping_ || !tasks_.empty(); });
+
+            // remaining tasks are consumed before stopping
+            if (tasks_.empty()) return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        task();
+    }
+}
+
+void ThreadPool::Post(const std::function<void()>& task) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!isStopping_) {
+            tasks_.push_back(task);
+            cv_.notify_one();
+            return;
+        }
+    }
+
+    task();
+}
+
+void ThreadPool::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (isStopping_) return;
+        isStopping_ = true;
+    }
+
+    cv_.notify_all();
+
+    for (auto& t : threads_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+}  // namespace Altseed2
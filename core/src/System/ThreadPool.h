@@ -0,0 +1,43 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if !USE_CBG
+
+namespace Altseed2 {
+
+//! fixed number of worker threads consuming a FIFO task queue
+class ThreadPool {
+private:
+    std::vector<std::thread> threads_;
+    std::deque<std::function<void()>> tasks_;
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    bool isStopping_ = false;
+
+    void ThreadLoop();
+
+public:
+    ThreadPool(int32_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Post(const std::function<void()>& task);
+
+    //! runs all queued tasks and joins the threads. tasks posted after this are run on the caller
+    void Stop();
+
+    int32_t GetThreadCount() const { return static_cast<int32_t>(threads_.size()); }
+};
+
+}  // namespace Altseed2
+
+#endif
@@ -2,6 +2,8 @@
 
 #include <nfd.h>
 
+#include <algorithm>
+
 #include "../Common/StringHelper.h"
 #include "Platform/ImGuiPlatform.h"
 #ifdef _WIN32
@@ -235,9 +237,10 @@ const char16_t* Tool::InputText(const char16_t* label, const char16_t* input, in
     RETURN_IF_NULL(label, nullptr);
     RETURN_IF_NULL(input, nullptr);
 
-    std::u16string u16str(input);
+    const auto input8 = utf16_to_utf8(input);
     auto buf = new char[max_length + 1]{};
-    utf16_to_utf8(u16str).copy(buf, utf16_to_utf8(u16str).size());
+    // a sequence cut in half would make the whole text invalid
+    input8.copy(buf, GetU8TruncatedLength(input8, static_cast<size_t>(max_length)));
     auto res = ImGui::InputText(utf16_to_utf8(label).c_str(), buf, max_length + 1, static_cast<ImGuiInputTextFlags>(flags));
     if (res) {
         tempInputText = utf8_to_utf16(buf);
@@ -256,9 +259,9 @@ const char16_t* Tool::InputTextWithHint(
     RETURN_IF_NULL(hint, nullptr);
     RETURN_IF_NULL(input, nullptr);
 
-    std::u16string u16str(input);
+    const auto input8 = utf16_to_utf8(input);
     auto buf = new char[max_length + 1]{};
-    utf16_to_utf8(u16str).copy(buf, utf16_to_utf8(u16str).size());
+    input8.copy(buf, GetU8TruncatedLength(input8, static_cast<size_t>(max_length)));
     auto res = ImGui::InputTextWithHint(
             utf16_to_utf8(label).c_str(), utf16_to_utf8(hint).c_str(), buf, max_length + 1, static_cast<ImGuiInputTextFlags>(flags));
     if (res) {
@@ -277,9 +280,9 @@ const char16_t* Tool::InputTextMultiline(
     RETURN_IF_NULL(label, nullptr);
     RETURN_IF_NULL(input, nullptr);
 
-    std::u16string u16str(input);
+    const auto input8 = utf16_to_utf8(input);
     auto buf = new char[max_length + 1]{};
-    utf16_to_utf8(u16str).copy(buf, utf16_to_utf8(u16str).size());
+    input8.copy(buf, GetU8TruncatedLength(input8, static_cast<size_t>(max_length)));
     auto res = ImGui::InputTextMultiline(
             utf16_to_utf8(label).c_str(), buf, max_length + 1, toImVec2(size), static_cast<ImGuiInputTextFlags>(flags));
     if (res) {
@@ -1,6 +1,5 @@
 ﻿#include "Window.h"
 
-#include <codecvt>
 #include <locale>
 
 #include "../Common/StringHelper.h"
@@ -1,8 +1,10 @@
 ﻿#include <BaseObject.h>
+#include <Common/Array.h>
 #include <Core.h>
 #include <gtest/gtest.h>
 
 #include <thread>
+#include <vector>
 
 #include "TestHelper.h"
 
@@ -69,6 +71,110 @@ TEST(BaseObject, Async) {
     Altseed2::Core::Terminate();
 }
 
+TEST(BaseObject, CountInThreads) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::None);
+    EXPECT_TRUE(config != nullptr);
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    auto defaultObjectCount = Altseed2::Core::GetInstance()->GetBaseObjectCount();
+
+    // objects are created and released by different threads
+    std::vector<Altseed2::BaseObject*> objects(4000);
+    std::vector<std::thread> threads;
+    for (int32_t t = 0; t < 4; t++) {
+        threads.emplace_back([&objects, t]() -> void {
+            for (int32_t i = t * 1000; i < (t + 1) * 1000; i++) {
+                objects[i] = new Altseed2::BaseObject();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    threads.clear();
+
+    EXPECT_EQ(Altseed2::Core::GetInstance()->GetBaseObjectCount(), defaultObjectCount + 4000);
+
+    for (int32_t t = 0; t < 4; t++) {
+        threads.emplace_back([&objects, t]() -> void {
+            for (int32_t i = t; i < 4000; i += 4) {
+                objects[i]->Release();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(Altseed2::Core::GetInstance()->GetBaseObjectCount(), defaultObjectCount);
+
+    Altseed2::Core::Terminate();
+}
+
+namespace {
+class LargeObject : public Altseed2::BaseObject {
+public:
+    uint8_t Data[1024];
+};
+
+class alignas(64) AlignedObject : public Altseed2::BaseObject {
+public:
+    int32_t Value;
+};
+}  // namespace
+
+TEST(BaseObject, Pool) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::None);
+    EXPECT_TRUE(config != nullptr);
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    auto defaultObjectCount = Altseed2::Core::GetInstance()->GetBaseObjectCount();
+
+    // small, large and over-aligned objects are reused after they are released
+    for (int32_t i = 0; i < 3; i++) {
+        std::vector<std::shared_ptr<Altseed2::BaseObject>> objects;
+        for (int32_t j = 0; j < 1000; j++) {
+            objects.push_back(Altseed2::MakeAsdShared<Altseed2::Int8Array>());
+            objects.push_back(Altseed2::MakeAsdShared<LargeObject>());
+
+            auto aligned = Altseed2::MakeAsdShared<AlignedObject>();
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned.get()) % 64, 0);
+            objects.push_back(aligned);
+        }
+        EXPECT_EQ(Altseed2::Core::GetInstance()->GetBaseObjectCount(), defaultObjectCount + 3000);
+    }
+
+    EXPECT_EQ(Altseed2::Core::GetInstance()->GetBaseObjectCount(), defaultObjectCount);
+
+#if ALTSEED2_USE_OBJECT_POOL
+    // the block released last by a thread is the first one it reuses
+    {
+        auto object = new Altseed2::Int8Array();
+        const void* address = object;
+        object->Release();
+
+        auto reused = new Altseed2::Int8Array();
+        EXPECT_EQ(static_cast<const void*>(reused), address);
+        reused->Release();
+    }
+
+    // as well as the control blocks of shared_ptrs
+    {
+        auto object = Altseed2::MakeAsdShared<Altseed2::Int8Array>();
+        const void* address = object.get();
+        object = nullptr;
+
+        object = Altseed2::MakeAsdShared<Altseed2::Int8Array>();
+        EXPECT_EQ(static_cast<const void*>(object.get()), address);
+    }
+
+    const auto reservedSize = Altseed2::ObjectPool::GetReservedSize();
+#endif
+
+    Altseed2::Core::Terminate();
+
+#if ALTSEED2_USE_OBJECT_POOL
+    // the chunks of the objects released above are returned to the system
+    EXPECT_LT(Altseed2::ObjectPool::GetReservedSize(), reservedSize);
+#endif
+}
+
 TEST(BaseObject, DisposeInOtherThreadAfterTerminate) {
     auto config = Altseed2TestConfig(Altseed2::CoreModules::None);
     EXPECT_TRUE(config != nullptr);
@@ -1,9 +1,15 @@
 ﻿#include <Core.h>
 #include <IO/File.h>
+#include <IO/PackBuilder.h>
+#include <IO/PackFile.h>
+#include <IO/PathTable.h>
 #include <Platform/FileSystem.h>
 #include <gtest/gtest.h>
 #include <zip.h>
 
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <string>
 #include <thread>
 #include <vector>
@@ -283,4 +289,604 @@ TEST(File, StaticFileAsync) {
     EXPECT_EQ(test4->GetInt8ArrayBuffer()->GetVector(), testPack4->GetInt8ArrayBuffer()->GetVector());
 
     Altseed2::Core::Terminate();
-}
\ No newline at end of file
+}
+
+TEST(File, MappedStaticFile) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::File);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    auto mapping = Altseed2::FileSystem::MapFile(u"TestData/IO/test.txt");
+    EXPECT_NE(mapping, nullptr);
+    EXPECT_EQ(mapping->GetSize(), Altseed2::FileSystem::GetFileSize(u"TestData/IO/test.txt"));
+    EXPECT_EQ(Altseed2::FileSystem::MapFile(u"TestData/IO/NotExistedFile.txt"), nullptr);
+
+    std::shared_ptr<Altseed2::StaticFile> test = nullptr;
+    EXPECT_NE(test = Altseed2::StaticFile::Create(u"TestData/IO/test.txt"), nullptr);
+    EXPECT_FALSE(test->GetIsInPackage());
+    EXPECT_EQ(test->GetSize(), mapping->GetSize());
+
+    // GetData is a view of the file content
+    const auto data = static_cast<const int8_t*>(test->GetData());
+    const auto expected = static_cast<const int8_t*>(mapping->GetData());
+    EXPECT_EQ(std::vector<int8_t>(data, data + test->GetSize()), std::vector<int8_t>(expected, expected + mapping->GetSize()));
+
+    // Int8Array is created once on demand
+    const auto buffer = test->GetInt8ArrayBuffer();
+    EXPECT_EQ(buffer, test->GetInt8ArrayBuffer());
+    EXPECT_EQ(buffer->GetVector(), std::vector<int8_t>(data, data + test->GetSize()));
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(File, PackIndex) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::File);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    EXPECT_TRUE(Altseed2::File::GetInstance()->Pack(u"TestData/IO/", u"TestData/IO/pack.pack"));
+    EXPECT_TRUE(Altseed2::File::GetInstance()->PackWithPassword(u"TestData/IO/pack/", u"TestData/IO/password.pack", u"altseed"));
+
+    EXPECT_TRUE(Altseed2::File::GetInstance()->AddRootPackage(u"TestData/IO/pack.pack"));
+    EXPECT_TRUE(Altseed2::File::GetInstance()->Exists(u"pack/testDir/test.txt"));
+    EXPECT_TRUE(Altseed2::File::GetInstance()->Exists(u"pack\\testDir\\test.txt"));
+    EXPECT_FALSE(Altseed2::File::GetInstance()->Exists(u"testDir/test.txt"));
+
+    // the name of the entry is compared, not only the hash
+    {
+        auto zip = zip_open("TestData/IO/pack.pack", ZIP_RDONLY, nullptr);
+        ASSERT_NE(zip, nullptr);
+        auto packFile = Altseed2::MakeAsdShared<Altseed2::PackFile>(zip, u"TestData/IO/pack.pack");
+
+        const auto entry = packFile->Find(u"pack\\testDir\\test.txt");
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->Name, u"pack/testDir/test.txt");
+        EXPECT_EQ(packFile->Find(Altseed2::PackFile::GetPathHash(u"pack/testDir/test.txt"), u"pack/testDir/test.txx"), nullptr);
+    }
+
+    // the pack added later takes precedence
+    EXPECT_TRUE(Altseed2::File::GetInstance()->AddRootPackageWithPassword(u"TestData/IO/password.pack", u"altseed"));
+    EXPECT_TRUE(Altseed2::File::GetInstance()->Exists(u"testDir/test.txt"));
+    EXPECT_TRUE(Altseed2::File::GetInstance()->Exists(u"pack/testDir/test.txt"));
+
+    std::shared_ptr<Altseed2::StaticFile> testPack = nullptr;
+    EXPECT_NE(testPack = Altseed2::StaticFile::Create(u"test.txt"), nullptr);
+    EXPECT_TRUE(testPack->GetIsInPackage());
+
+    std::shared_ptr<Altseed2::StaticFile> expected = nullptr;
+    EXPECT_NE(expected = Altseed2::StaticFile::Create(u"TestData/IO/pack/test.txt"), nullptr);
+    EXPECT_EQ(expected->GetInt8ArrayBuffer()->GetVector(), testPack->GetInt8ArrayBuffer()->GetVector());
+
+    // a directory root added after the packs takes precedence over them
+    EXPECT_TRUE(Altseed2::File::GetInstance()->AddRootDirectory(u"TestData/IO/"));
+    Altseed2::Resources::GetInstance()->Clear();
+
+    std::shared_ptr<Altseed2::StaticFile> testDir = nullptr;
+    EXPECT_NE(testDir = Altseed2::StaticFile::Create(u"test.txt"), nullptr);
+    EXPECT_FALSE(testDir->GetIsInPackage());
+
+    // the merged index is discarded with the roots
+    Altseed2::File::GetInstance()->ClearRootDirectories();
+    EXPECT_FALSE(Altseed2::File::GetInstance()->Exists(u"testDir/test.txt"));
+    EXPECT_FALSE(Altseed2::File::GetInstance()->Exists(u"pack/testDir/test.txt"));
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(File, StoredPackEntry) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::File);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    // pack the same file with and without compression
+    {
+        int error;
+        zip_t* zip = zip_open("TestData/IO/stored.pack", ZIP_TRUNCATE | ZIP_CREATE, &error);
+        EXPECT_NE(zip, nullptr);
+
+        auto stored = zip_file_add(zip, "stored.txt", zip_source_file(zip, "TestData/IO/test.txt", 0, -1), ZIP_FL_ENC_UTF_8);
+        EXPECT_NE(stored, -1);
+        EXPECT_EQ(zip_set_file_compression(zip, stored, ZIP_CM_STORE, 0), 0);
+        EXPECT_NE(zip_file_add(zip, "deflated.txt", zip_source_file(zip, "TestData/IO/test.txt", 0, -1), ZIP_FL_ENC_UTF_8), -1);
+        EXPECT_EQ(zip_close(zip), 0);
+    }
+
+    EXPECT_TRUE(Altseed2::File::GetInstance()->AddRootPackage(u"TestData/IO/stored.pack"));
+
+    std::shared_ptr<Altseed2::MappedFile> mapping;
+    auto storedReader = Altseed2::File::GetInstance()->CreateFileReader(u"stored.txt");
+    EXPECT_NE(storedReader, nullptr);
+    EXPECT_NE(storedReader->GetMappedData(mapping), nullptr);
+    EXPECT_NE(mapping, nullptr);
+
+    auto deflatedReader = Altseed2::File::GetInstance()->CreateFileReader(u"deflated.txt");
+    EXPECT_NE(deflatedReader, nullptr);
+    EXPECT_EQ(deflatedReader->GetMappedData(mapping), nullptr);
+
+    std::shared_ptr<Altseed2::StaticFile> expected = nullptr;
+    EXPECT_NE(expected = Altseed2::StaticFile::Create(u"TestData/IO/test.txt"), nullptr);
+
+    std::shared_ptr<Altseed2::StaticFile> storedFile = nullptr;
+    EXPECT_NE(storedFile = Altseed2::StaticFile::Create(u"stored.txt"), nullptr);
+    EXPECT_TRUE(storedFile->GetIsInPackage());
+    EXPECT_EQ(expected->GetInt8ArrayBuffer()->GetVector(), storedFile->GetInt8ArrayBuffer()->GetVector());
+
+    std::shared_ptr<Altseed2::StaticFile> deflatedFile = nullptr;
+    EXPECT_NE(deflatedFile = Altseed2::StaticFile::Create(u"deflated.txt"), nullptr);
+    EXPECT_EQ(expected->GetInt8ArrayBuffer()->GetVector(), deflatedFile->GetInt8ArrayBuffer()->GetVector());
+
+    // partial reads of a stored entry
+    std::vector<uint8_t> buffer;
+    storedReader->Seek(1);
+    storedReader->ReadBytes(buffer, 2);
+    EXPECT_EQ(buffer.size(), 2);
+    EXPECT_EQ(static_cast<int8_t>(buffer[0]), expected->GetInt8ArrayBuffer()->GetVector()[1]);
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(File, StreamingStreamFile) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::File);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    std::shared_ptr<Altseed2::StaticFile> expected = nullptr;
+    EXPECT_NE(expected = Altseed2::StaticFile::Create(u"TestData/IO/AltseedPink.png"), nullptr);
+    const auto& expectedVector = expected->GetInt8ArrayBuffer()->GetVector();
+
+    // the ring buffer is much smaller than the file
+    const int32_t ringBufferSize = 1024;
+    EXPECT_GT(expected->GetSize(), ringBufferSize);
+
+    // views of chunks
+    {
+        std::shared_ptr<Altseed2::StreamFile> stream = nullptr;
+        EXPECT_NE(stream = Altseed2::StreamFile::CreateStreaming(u"TestData/IO/AltseedPink.png", ringBufferSize), nullptr);
+        EXPECT_TRUE(stream->GetIsStreaming());
+        EXPECT_EQ(stream->GetSize(), expected->GetSize());
+
+        // not shared through the cache
+        EXPECT_NE(stream, Altseed2::StreamFile::CreateStreaming(u"TestData/IO/AltseedPink.png", ringBufferSize));
+
+        std::vector<int8_t> content;
+        while (true) {
+            const void* data = nullptr;
+            int32_t size = 0;
+            EXPECT_TRUE(stream->AcquireChunk(data, size, 300));
+            if (size == 0) break;
+
+            EXPECT_LE(size, 300);
+            const auto begin = static_cast<const int8_t*>(data);
+            content.insert(content.end(), begin, begin + size);
+            stream->ReleaseChunk(size);
+            EXPECT_EQ(stream->GetCurrentPosition(), static_cast<int32_t>(content.size()));
+        }
+
+        EXPECT_EQ(content, expectedVector);
+    }
+
+    // Read keeps only the last read bytes
+    {
+        std::shared_ptr<Altseed2::StreamFile> stream = nullptr;
+        EXPECT_NE(stream = Altseed2::StreamFile::CreateStreaming(u"TestData/IO/AltseedPink.png", ringBufferSize), nullptr);
+
+        std::vector<int8_t> content;
+        int32_t readSize = 0;
+        while ((readSize = stream->Read(700)) > 0) {
+            EXPECT_EQ(stream->GetTempBufferSize(), readSize);
+            const auto& buffer = stream->GetInt8ArrayTempBuffer()->GetVector();
+            content.insert(content.end(), buffer.begin(), buffer.end());
+        }
+
+        EXPECT_EQ(content, expectedVector);
+        EXPECT_EQ(stream->GetCurrentPosition(), stream->GetSize());
+    }
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(File, ReaderRead) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::File);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    EXPECT_TRUE(Altseed2::File::GetInstance()->Pack(u"TestData/IO/", u"TestData/IO/pack.pack"));
+    EXPECT_TRUE(Altseed2::File::GetInstance()->PackWithPassword(u"TestData/IO/", u"TestData/IO/password.pack", u"altseed"));
+
+    std::vector<uint8_t> expected;
+    Altseed2::File::GetInstance()->CreateFileReader(u"TestData/IO/AltseedPink.png")->ReadAllBytes(expected);
+    EXPECT_GT(expected.size(), 64);
+
+    auto check = [&expected](std::shared_ptr<Altseed2::BaseFileReader> reader) -> void {
+        EXPECT_NE(reader, nullptr);
+        EXPECT_EQ(reader->GetSize(), expected.size());
+
+        uint32_t value32 = 0;
+        memcpy(&value32, expected.data(), sizeof(uint32_t));
+        EXPECT_EQ(reader->ReadUInt32(), value32);
+
+        uint64_t value64 = 0;
+        memcpy(&value64, expected.data() + 4, sizeof(uint64_t));
+        EXPECT_EQ(reader->ReadUInt64(), value64);
+
+        // scatter
+        uint8_t a[3], b[5];
+        Altseed2::ReadSegment segments[] = {{a, 3}, {b, 5}};
+        EXPECT_EQ(reader->ReadScatter(segments, 2), 8);
+        EXPECT_EQ(std::vector<uint8_t>(a, a + 3), std::vector<uint8_t>(expected.begin() + 12, expected.begin() + 15));
+        EXPECT_EQ(std::vector<uint8_t>(b, b + 5), std::vector<uint8_t>(expected.begin() + 15, expected.begin() + 20));
+        EXPECT_EQ(reader->GetPosition(), 20);
+
+        // gather from offsets without moving the position
+        uint8_t c[4], d[2];
+        Altseed2::ReadRange ranges[] = {{40, c, 4}, {static_cast<int64_t>(expected.size()) - 2, d, 2}};
+        EXPECT_EQ(reader->ReadRanges(ranges, 2), 6);
+        EXPECT_EQ(std::vector<uint8_t>(c, c + 4), std::vector<uint8_t>(expected.begin() + 40, expected.begin() + 44));
+        EXPECT_EQ(std::vector<uint8_t>(d, d + 2), std::vector<uint8_t>(expected.end() - 2, expected.end()));
+        EXPECT_EQ(reader->GetPosition(), 20);
+
+        // the rest, which is shorter than requested
+        std::vector<uint8_t> rest(expected.size());
+        EXPECT_EQ(reader->Read(rest.data(), rest.size()), expected.size() - 20);
+        EXPECT_EQ(std::vector<uint8_t>(rest.begin(), rest.begin() + expected.size() - 20), std::vector<uint8_t>(expected.begin() + 20, expected.end()));
+        EXPECT_EQ(reader->Read(rest.data(), 1), 0);
+    };
+
+    check(Altseed2::File::GetInstance()->CreateFileReader(u"TestData/IO/AltseedPink.png"));
+
+    EXPECT_TRUE(Altseed2::File::GetInstance()->AddRootPackage(u"TestData/IO/pack.pack"));
+    check(Altseed2::File::GetInstance()->CreateFileReader(u"AltseedPink.png"));
+
+    Altseed2::File::GetInstance()->ClearRootDirectories();
+    EXPECT_TRUE(Altseed2::File::GetInstance()->AddRootPackageWithPassword(u"TestData/IO/password.pack", u"altseed"));
+    check(Altseed2::File::GetInstance()->CreateFileReader(u"AltseedPink.png"));
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(File, PathCache) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::File);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    auto file = Altseed2::File::GetInstance();
+    EXPECT_FALSE(file->GetIsPathCacheEnabled());
+    file->SetIsPathCacheEnabled(true);
+    EXPECT_TRUE(file->GetIsPathCacheEnabled());
+
+    // hits and misses are stable
+    for (int i = 0; i < 2; i++) {
+        EXPECT_TRUE(file->Exists(u"TestData/IO/test.txt"));
+        EXPECT_FALSE(file->Exists(u"TestData/IO/pathCache.txt"));
+    }
+
+    // a file created after a negative lookup
+    std::remove("TestData/IO/pathCache.txt");
+    { std::ofstream("TestData/IO/pathCache.txt") << "pathCache"; }
+
+#if defined(__linux__)
+    // invalidated by the watcher
+    bool isFound = false;
+    for (int i = 0; i < 100 && !isFound; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        isFound = file->Exists(u"TestData/IO/pathCache.txt");
+    }
+    EXPECT_TRUE(isFound);
+#endif
+
+    file->ClearPathCache();
+    EXPECT_TRUE(file->Exists(u"TestData/IO/pathCache.txt"));
+
+    std::shared_ptr<Altseed2::StaticFile> staticFile = nullptr;
+    EXPECT_NE(staticFile = Altseed2::StaticFile::Create(u"TestData/IO/pathCache.txt"), nullptr);
+    EXPECT_EQ(staticFile->GetSize(), 9);
+    staticFile = nullptr;
+
+    std::remove("TestData/IO/pathCache.txt");
+    file->ClearPathCache();
+    EXPECT_FALSE(file->Exists(u"TestData/IO/pathCache.txt"));
+
+    // changes of the roots invalidate the cache
+    EXPECT_FALSE(file->Exists(u"test.txt"));
+    EXPECT_TRUE(file->AddRootDirectory(u"TestData/IO/"));
+    EXPECT_TRUE(file->Exists(u"test.txt"));
+    file->ClearRootDirectories();
+    EXPECT_FALSE(file->Exists(u"test.txt"));
+
+    file->SetIsPathCacheEnabled(false);
+    EXPECT_FALSE(file->GetIsPathCacheEnabled());
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(File, PathTable) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::File);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    // paths which normalize to the same form share one entry
+    const auto interned = Altseed2::PathTable::Intern(u"TestData/IO/test.txt");
+    EXPECT_EQ(interned->Path, u"TestData/IO/test.txt");
+    EXPECT_EQ(interned->Hash, Altseed2::PackFile::GetPathHash(u"TestData/IO/test.txt"));
+    EXPECT_EQ(Altseed2::PathTable::Intern(u"TestData/IO/test.txt"), interned);
+    EXPECT_EQ(Altseed2::PathTable::Intern(std::u16string(u"TestData\\IO\\test.txt")), interned);
+
+    const auto count = Altseed2::PathTable::GetCount();
+    EXPECT_EQ(Altseed2::PathTable::Intern(u"TestData\\IO/test.txt"), interned);
+    EXPECT_EQ(Altseed2::PathTable::GetCount(), count);
+
+    auto other = Altseed2::PathTable::Intern(u"TestData/IO/pathTable.txt");
+    EXPECT_NE(other, interned);
+    EXPECT_EQ(Altseed2::PathTable::GetCount(), count + 1);
+
+    // entries are removed when they are no longer used
+    other = nullptr;
+    EXPECT_EQ(Altseed2::PathTable::GetCount(), count);
+
+    // the cache is found with either form
+    std::shared_ptr<Altseed2::StaticFile> test = nullptr;
+    EXPECT_NE(test = Altseed2::StaticFile::Create(u"TestData/IO/test.txt"), nullptr);
+    EXPECT_EQ(Altseed2::StaticFile::Create(u"TestData\\IO\\test.txt"), test);
+
+    // registered files keep their paths until they are unregistered
+    {
+        auto image = Altseed2::StaticFile::Create(u"TestData/IO/AltseedPink.png");
+        EXPECT_NE(image, nullptr);
+        EXPECT_EQ(Altseed2::PathTable::GetCount(), count + 1);
+    }
+    EXPECT_EQ(Altseed2::PathTable::GetCount(), count);
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(File, HotReload) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::File);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    auto file = Altseed2::File::GetInstance();
+    EXPECT_FALSE(file->GetIsHotReloadEnabled());
+    file->SetIsHotReloadEnabled(true);
+    EXPECT_TRUE(file->GetIsHotReloadEnabled());
+
+    std::remove("TestData/IO/hotReload.txt");
+    { std::ofstream("TestData/IO/hotReload.txt") << "hot"; }
+
+    auto staticFile = Altseed2::StaticFile::Create(u"TestData/IO/hotReload.txt");
+    EXPECT_NE(staticFile, nullptr);
+    EXPECT_EQ(staticFile->GetSize(), 3);
+
+    { std::ofstream("TestData/IO/hotReload.txt") << "hotReload"; }
+
+#if defined(__linux__)
+    // only the changed file is reloaded
+    bool isReloaded = false;
+    for (int i = 0; i < 100 && !isReloaded; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        Altseed2::Resources::GetInstance()->Reload();
+        isReloaded = staticFile->GetSize() == 9;
+    }
+    EXPECT_TRUE(isReloaded);
+#endif
+
+    staticFile = nullptr;
+    std::remove("TestData/IO/hotReload.txt");
+
+    file->SetIsHotReloadEnabled(false);
+    EXPECT_FALSE(file->GetIsHotReloadEnabled());
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(File, PackBuilder) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::File);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    // extensions are matched case insensitively
+    Altseed2::PackBuilder builder;
+    builder.SetThreadCount(2);
+    builder.AddStoreOnlyExtension(u"TXT");
+    EXPECT_TRUE(builder.GetIsStoreOnly(u"dir.png/test.txt"));
+    EXPECT_TRUE(builder.GetIsStoreOnly(u"test.PNG"));
+    EXPECT_FALSE(builder.GetIsStoreOnly(u"dir.txt/test"));
+    EXPECT_TRUE(builder.Build(u"TestData/IO/pack", u"TestData/IO/builder_stored.pack"));
+
+    builder.ClearStoreOnlyExtensions();
+    builder.SetThreadCount(0);
+    EXPECT_TRUE(builder.Build(u"TestData/IO/pack/", u"TestData/IO/builder_deflated.pack"));
+
+    EXPECT_FALSE(builder.Build(u"TestData/IO/notFound/", u"TestData/IO/builder_notFound.pack"));
+
+    std::shared_ptr<Altseed2::StaticFile> expected = nullptr;
+    EXPECT_NE(expected = Altseed2::StaticFile::Create(u"TestData/IO/pack/testDir/test.txt"), nullptr);
+
+    // stored entries are served from the mapping
+    std::shared_ptr<Altseed2::MappedFile> mapping;
+    EXPECT_TRUE(Altseed2::File::GetInstance()->AddRootPackage(u"TestData/IO/builder_stored.pack"));
+    auto storedReader = Altseed2::File::GetInstance()->CreateFileReader(u"testDir/test.txt");
+    EXPECT_NE(storedReader, nullptr);
+    EXPECT_NE(storedReader->GetMappedData(mapping), nullptr);
+
+    std::shared_ptr<Altseed2::StaticFile> storedFile = nullptr;
+    EXPECT_NE(storedFile = Altseed2::StaticFile::Create(u"testDir/test.txt"), nullptr);
+    EXPECT_TRUE(storedFile->GetIsInPackage());
+    EXPECT_EQ(expected->GetInt8ArrayBuffer()->GetVector(), storedFile->GetInt8ArrayBuffer()->GetVector());
+    storedFile = nullptr;
+    storedReader = nullptr;
+
+    Altseed2::File::GetInstance()->ClearRootDirectories();
+    Altseed2::Resources::GetInstance()->Clear();
+
+    EXPECT_TRUE(Altseed2::File::GetInstance()->AddRootPackage(u"TestData/IO/builder_deflated.pack"));
+    auto deflatedReader = Altseed2::File::GetInstance()->CreateFileReader(u"testDir/test.txt");
+    EXPECT_NE(deflatedReader, nullptr);
+    EXPECT_EQ(deflatedReader->GetMappedData(mapping), nullptr);
+
+    std::shared_ptr<Altseed2::StaticFile> deflatedFile = nullptr;
+    EXPECT_NE(deflatedFile = Altseed2::StaticFile::Create(u"testDir/test.txt"), nullptr);
+    EXPECT_TRUE(deflatedFile->GetIsInPackage());
+    EXPECT_EQ(expected->GetInt8ArrayBuffer()->GetVector(), deflatedFile->GetInt8ArrayBuffer()->GetVector());
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(File, DeduplicatedPack) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::File);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    // the same content in different directories
+    std::string content;
+    for (int i = 0; i < 1000; i++) content += "Altseed2 " + std::to_string(i) + "\n";
+
+    Altseed2::FileSystem::CreateDirectory(u"TestData/IO/dedup");
+    Altseed2::FileSystem::CreateDirectory(u"TestData/IO/dedup/skin1");
+    Altseed2::FileSystem::CreateDirectory(u"TestData/IO/dedup/skin2");
+    { std::ofstream("TestData/IO/dedup/skin1/common.txt", std::ios::binary) << content; }
+    { std::ofstream("TestData/IO/dedup/skin2/common.txt", std::ios::binary) << content; }
+    content.back() = '!';
+    { std::ofstream("TestData/IO/dedup/skin2/other.txt", std::ios::binary) << content; }
+
+    Altseed2::PackBuilder builder;
+    EXPECT_FALSE(builder.GetIsDeduplicated());
+    EXPECT_TRUE(builder.Build(u"TestData/IO/dedup/", u"TestData/IO/notDedup.pack"));
+    builder.SetIsDeduplicated(true);
+    EXPECT_TRUE(builder.Build(u"TestData/IO/dedup/", u"TestData/IO/dedup.pack"));
+
+    EXPECT_LT(Altseed2::FileSystem::GetFileSize(u"TestData/IO/dedup.pack"), Altseed2::FileSystem::GetFileSize(u"TestData/IO/notDedup.pack"));
+
+    EXPECT_TRUE(Altseed2::File::GetInstance()->AddRootPackage(u"TestData/IO/dedup.pack"));
+
+    std::shared_ptr<Altseed2::StaticFile> expected = nullptr;
+    EXPECT_NE(expected = Altseed2::StaticFile::Create(u"TestData/IO/dedup/skin1/common.txt"), nullptr);
+
+    std::shared_ptr<Altseed2::StaticFile> common1 = nullptr;
+    std::shared_ptr<Altseed2::StaticFile> common2 = nullptr;
+    std::shared_ptr<Altseed2::StaticFile> other = nullptr;
+    EXPECT_NE(common1 = Altseed2::StaticFile::Create(u"skin1/common.txt"), nullptr);
+    EXPECT_NE(common2 = Altseed2::StaticFile::Create(u"skin2/common.txt"), nullptr);
+    EXPECT_NE(other = Altseed2::StaticFile::Create(u"skin2/other.txt"), nullptr);
+
+    EXPECT_EQ(expected->GetInt8ArrayBuffer()->GetVector(), common1->GetInt8ArrayBuffer()->GetVector());
+    EXPECT_EQ(expected->GetInt8ArrayBuffer()->GetVector(), common2->GetInt8ArrayBuffer()->GetVector());
+    EXPECT_NE(expected->GetInt8ArrayBuffer()->GetVector(), other->GetInt8ArrayBuffer()->GetVector());
+
+    // identical contents share one buffer in memory
+    EXPECT_NE(common1, common2);
+    EXPECT_EQ(common1->GetData(), common2->GetData());
+    EXPECT_NE(common1->GetData(), other->GetData());
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(File, ConcurrentCreate) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::File);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    const std::vector<std::u16string> paths = {
+            u"TestData/IO/test.txt", u"TestData/IO/AltseedPink.png", u"TestData/IO/pack/test.txt", u"TestData/IO/pack/testDir/test.txt"};
+    const auto baseCount = Altseed2::Resources::GetInstance()->GetResourcesCount(Altseed2::ResourceType::StaticFile);
+
+    // every thread creates every file
+    const int32_t threadCount = 8;
+    std::vector<std::vector<std::shared_ptr<Altseed2::StaticFile>>> results(threadCount);
+    std::vector<std::thread> threads;
+    for (int32_t i = 0; i < threadCount; i++) {
+        threads.emplace_back([&paths, &results, i]() -> void {
+            for (size_t j = 0; j < paths.size(); j++) {
+                const auto& path = paths[(i + j) % paths.size()];
+                results[i].push_back(Altseed2::StaticFile::Create(path.c_str()));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    // the same path gives the same instance
+    for (size_t j = 0; j < paths.size(); j++) {
+        auto expected = Altseed2::StaticFile::Create(paths[j].c_str());
+        EXPECT_NE(expected, nullptr);
+
+        for (int32_t i = 0; i < threadCount; i++) {
+            EXPECT_EQ(results[i][(j + paths.size() - i % paths.size()) % paths.size()], expected);
+        }
+    }
+
+    EXPECT_EQ(Altseed2::Resources::GetInstance()->GetResourcesCount(Altseed2::ResourceType::StaticFile), baseCount + static_cast<int32_t>(paths.size()));
+
+    // released files are unregistered
+    results.clear();
+    EXPECT_EQ(Altseed2::Resources::GetInstance()->GetResourcesCount(Altseed2::ResourceType::StaticFile), baseCount);
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(File, ResourceBudget) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::File);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    auto resources = Altseed2::Resources::GetInstance();
+    const auto type = Altseed2::ResourceType::StaticFile;
+    const auto baseCount = resources->GetResourcesCount(type);
+    const auto baseUsage = resources->GetMemoryUsage(type);
+
+    int64_t size = 0;
+    {
+        auto file1 = Altseed2::StaticFile::Create(u"TestData/IO/test.txt");
+        auto file2 = Altseed2::StaticFile::Create(u"TestData/IO/pack/test.txt");
+        EXPECT_NE(file1, nullptr);
+        EXPECT_NE(file2, nullptr);
+        size = file1->GetSize() + file2->GetSize();
+        EXPECT_EQ(resources->GetMemoryUsage(type), baseUsage + size);
+    }
+
+    // not cached without a budget
+    EXPECT_EQ(resources->GetResourcesCount(type), baseCount);
+    EXPECT_EQ(resources->GetMemoryUsage(type), baseUsage);
+
+    // released files stay cached within the budget
+    resources->SetMemoryBudget(type, baseUsage + size);
+    Altseed2::StaticFile::Create(u"TestData/IO/test.txt");
+    Altseed2::StaticFile::Create(u"TestData/IO/pack/test.txt");
+    EXPECT_EQ(resources->GetResourcesCount(type), baseCount + 2);
+
+    // the least recently used file is evicted over the budget
+    Altseed2::StaticFile::Create(u"TestData/IO/test.txt");
+    auto large = Altseed2::StaticFile::Create(u"TestData/IO/AltseedPink.png");
+    EXPECT_NE(large, nullptr);
+    EXPECT_EQ(resources->GetResourcesCount(type), baseCount + 1);
+    EXPECT_GE(resources->GetMemoryUsage(type), baseUsage + large->GetSize());
+
+    // pinned files are kept regardless of the budget
+    EXPECT_TRUE(resources->SetIsPinned(type, u"TestData/IO/AltseedPink.png", true));
+    large = nullptr;
+    resources->SetMemoryBudget(type, 0);
+    EXPECT_EQ(resources->GetResourcesCount(type), baseCount + 1);
+
+    EXPECT_TRUE(resources->SetIsPinned(type, u"TestData/IO/AltseedPink.png", false));
+    EXPECT_EQ(resources->GetResourcesCount(type), baseCount);
+    EXPECT_EQ(resources->GetMemoryUsage(type), baseUsage);
+    EXPECT_FALSE(resources->SetIsPinned(type, u"TestData/IO/AltseedPink.png", true));
+
+    // budgets over 2 GiB are passed to the bindings in KiB
+    resources->SetMemoryBudgetKiB(type, 4 * 1024 * 1024);
+    EXPECT_EQ(resources->GetMemoryBudget(type), int64_t(4) * 1024 * 1024 * 1024);
+    EXPECT_EQ(resources->GetMemoryBudgetKiB(type), 4 * 1024 * 1024);
+    resources->SetMemoryBudgetKiB(type, 0);
+
+    Altseed2::Core::Terminate();
+}
@@ -2,9 +2,11 @@
 #include "Graphics/Font.h"
 
 #include <Core.h>
+#include <ft2build.h>
 #include <gtest/gtest.h>
 
 #include <memory>
+#include FT_FREETYPE_H
 
 #include "Common/StringHelper.h"
 #include "Graphics/BuiltinShader.h"
@@ -732,3 +734,222 @@ TEST(Font, GenerateFontFile) {
 
     Altseed2::Core::Terminate();
 }
+
+TEST(Font, StaticFontCompatibility) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::Graphics);
+    EXPECT_TRUE(config != nullptr);
+
+    const auto filename = u"TestData/Font/mplus-1m-regular.ttf";
+    const auto characters = u"AVTa Wo.こんにちは";
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"StaticFontCompatibility", 600, 400, config));
+
+    EXPECT_TRUE(Altseed2::Font::GenerateFontFile(filename, u"TestData/Font/compatibility.a2f", DefaultSamplingSize, characters));
+    EXPECT_TRUE(Altseed2::Font::GenerateFontFile(filename, u"TestData/Font/compatibility_raw.a2f", DefaultSamplingSize, characters, false));
+
+    auto dynamicFont = Altseed2::Font::LoadDynamicFont(filename, DefaultSamplingSize);
+    EXPECT_TRUE(dynamicFont != nullptr);
+
+    for (const auto path : {u"TestData/Font/compatibility.a2f", u"TestData/Font/compatibility_raw.a2f"}) {
+        auto staticFont = Altseed2::Font::LoadStaticFont(path);
+        EXPECT_TRUE(staticFont != nullptr);
+        EXPECT_TRUE(staticFont->GetIsStaticFont());
+        EXPECT_EQ(staticFont->GetSamplingSize(), dynamicFont->GetSamplingSize());
+        EXPECT_EQ(staticFont->GetAscent(), dynamicFont->GetAscent());
+
+        for (const auto c : std::u16string(characters)) {
+            const auto expected = dynamicFont->GetGlyph(c);
+            const auto actual = staticFont->GetGlyph(c);
+            EXPECT_TRUE(actual != nullptr);
+            EXPECT_EQ(actual->GetPosition().X, expected->GetPosition().X);
+            EXPECT_EQ(actual->GetPosition().Y, expected->GetPosition().Y);
+            EXPECT_EQ(actual->GetSize().X, expected->GetSize().X);
+            EXPECT_EQ(actual->GetSize().Y, expected->GetSize().Y);
+            EXPECT_EQ(actual->GetAdvance(), expected->GetAdvance());
+            EXPECT_TRUE(staticFont->GetFontTexture(actual->GetTextureIndex()) != nullptr);
+
+            for (const auto c2 : std::u16string(characters)) {
+                EXPECT_EQ(staticFont->GetKerning(c, c2), dynamicFont->GetKerning(c, c2));
+            }
+        }
+
+        // a missing character is cached with the fallback
+        for (int32_t i = 0; i < 2; i++) {
+            EXPECT_EQ(staticFont->GetGlyph(u'X'), staticFont->GetGlyph(u'\0'));
+        }
+    }
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(Font, Shaping) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::Graphics);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"Font.Shaping", 600, 400, config));
+
+    auto font = Altseed2::Font::LoadDynamicFont(u"TestData/Font/mplus-1m-regular.ttf", DefaultSamplingSize);
+    EXPECT_TRUE(font != nullptr);
+
+    // shaped runs are cached
+    const auto shaped = font->Shape(u"Hello", true);
+    EXPECT_TRUE(shaped != nullptr);
+    EXPECT_EQ(shaped->size(), 5);
+    EXPECT_EQ((*shaped)[0].Character, u'H');
+    EXPECT_EQ(shaped, font->Shape(u"Hello", true));
+
+    // glyphs are looked up by glyph id
+    EXPECT_EQ((*shaped)[2].GlyphIndex, (*shaped)[3].GlyphIndex);
+    EXPECT_NE((*shaped)[0].GlyphIndex, (*shaped)[1].GlyphIndex);
+    const auto glyph = font->GetGlyphByIndex((*shaped)[2].GlyphIndex);
+    EXPECT_TRUE(glyph != nullptr);
+    EXPECT_EQ(glyph, font->GetGlyphByIndex((*shaped)[3].GlyphIndex));
+    EXPECT_EQ(glyph->GetAdvance(), font->GetGlyph(u'l')->GetAdvance());
+    EXPECT_EQ(glyph->GetSize().X, font->GetGlyph(u'l')->GetSize().X);
+
+    // the least recently used run is evicted, and a returned run stays valid
+    for (int32_t i = 0; i < Altseed2::Font::ShapedRunCacheMax; i++) {
+        font->Shape(std::u16string(1, static_cast<char16_t>(0x4E00 + i)), true);
+    }
+    EXPECT_EQ(shaped->size(), 5);
+    EXPECT_EQ((*shaped)[0].Character, u'H');
+    EXPECT_NE(shaped, font->Shape(u"Hello", true));
+
+    EXPECT_TRUE(Altseed2::Font::GenerateFontFile(u"TestData/Font/mplus-1m-regular.ttf", u"TestData/Font/shaping.a2f", DefaultSamplingSize, u"Hello"));
+    auto staticFont = Altseed2::Font::LoadStaticFont(u"TestData/Font/shaping.a2f");
+    EXPECT_TRUE(staticFont != nullptr);
+    EXPECT_TRUE(staticFont->Shape(u"Hello", true) == nullptr);
+
+    // monospaced font is laid out same as the path without shaping
+    for (const auto text : {u"Hello, world!", u"Hello\nworld", u"こんにちは"}) {
+        auto t = Altseed2::RenderedText::Create();
+        t->SetFont(font);
+        t->SetFontSize(50);
+        t->SetText(text);
+        t->SetIsEnableKerning(false);
+
+        const auto expected = t->GetRenderingSize();
+        t->SetIsEnableShaping(true);
+        const auto actual = t->GetRenderingSize();
+
+        EXPECT_NEAR(actual.X, expected.X, 1.0f);
+        EXPECT_NEAR(actual.Y, expected.Y, 1.0f);
+    }
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(Font, KerningCache) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::Graphics);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"Font.KerningCache", 600, 400, config));
+
+    auto font = Altseed2::Font::LoadDynamicFont(u"TestData/Font/GenYoMinJP-Bold.ttf", DefaultSamplingSize);
+    EXPECT_TRUE(font != nullptr);
+
+    // expected values are read by freetype directly, in the same unit as msdfgen
+    FT_Library library = nullptr;
+    FT_Face face = nullptr;
+    EXPECT_EQ(FT_Init_FreeType(&library), 0);
+    EXPECT_EQ(FT_New_Face(library, "TestData/Font/GenYoMinJP-Bold.ttf", 0, &face), 0);
+
+    const auto getExpected = [face](int32_t c1, int32_t c2) {
+        FT_Vector kerning;
+        FT_Get_Kerning(face, FT_Get_Char_Index(face, c1), FT_Get_Char_Index(face, c2), FT_KERNING_UNSCALED, &kerning);
+        return static_cast<int32_t>(kerning.x / 64.0);
+    };
+
+    // more pairs than the cache holds, so that evicted pairs are queried again
+    std::u16string characters = u"AVTa Wo.";
+    for (char16_t c = u'A'; c <= u'z'; c++) characters += c;
+    EXPECT_GT(characters.size() * characters.size(), Altseed2::Font::KerningCacheSize);
+
+    // Core is terminated even if loading failed, so that it does not leak into the following tests
+    for (int32_t i = 0; font != nullptr && face != nullptr && i < 2; i++) {
+        for (const auto c1 : characters) {
+            for (const auto c2 : characters) {
+                EXPECT_EQ(font->GetKerning(c1, c2), getExpected(c1, c2));
+            }
+        }
+    }
+
+    if (face != nullptr) FT_Done_Face(face);
+    if (library != nullptr) FT_Done_FreeType(library);
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(Font, DistanceFieldType) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::Graphics);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"Font.DistanceFieldType", 1280, 720, config));
+
+    const auto path = u"TestData/Font/mplus-1m-regular.ttf";
+    auto msdf = Altseed2::Font::LoadDynamicFont(path, DefaultSamplingSize);
+    auto sdf = Altseed2::Font::LoadDynamicFont(path, DefaultSamplingSize, Altseed2::FontDistanceFieldType::SDF);
+    auto mtsdf = Altseed2::Font::LoadDynamicFont(path, DefaultSamplingSize, Altseed2::FontDistanceFieldType::MTSDF, 8.0f);
+
+    EXPECT_TRUE(msdf != nullptr);
+    EXPECT_TRUE(sdf != nullptr);
+    EXPECT_TRUE(mtsdf != nullptr);
+
+    // fonts with different modes are cached separately
+    EXPECT_TRUE(msdf != sdf);
+    EXPECT_TRUE(sdf != mtsdf);
+    EXPECT_EQ(sdf, Altseed2::Font::LoadDynamicFont(path, DefaultSamplingSize, Altseed2::FontDistanceFieldType::SDF));
+
+    EXPECT_TRUE(Altseed2::Font::LoadDynamicFont(path, DefaultSamplingSize, Altseed2::FontDistanceFieldType::SDF, 0.0f) == nullptr);
+
+    EXPECT_EQ(sdf->GetDistanceFieldType(), Altseed2::FontDistanceFieldType::SDF);
+    EXPECT_EQ(sdf->GetFontTexture(0)->GetFormat(), Altseed2::TextureFormatType::R8_UNORM);
+    EXPECT_EQ(mtsdf->GetFontTexture(0)->GetFormat(), Altseed2::TextureFormatType::R8G8B8A8_UNORM);
+
+    std::vector<std::shared_ptr<Altseed2::RenderedText>> texts;
+
+    int32_t index = 0;
+    for (const auto& font : {msdf, sdf, mtsdf}) {
+        auto t = Altseed2::RenderedText::Create();
+        t->SetFont(font);
+        t->SetText(u"Altseed2 おるとしーど");
+        t->SetTransform(Altseed2::Matrix44F().SetTranslation(0, 100.0f * index++, 0));
+        t->SetFontSize(60);
+        texts.push_back(t);
+    }
+
+    for (const auto& t : texts) {
+        Altseed2::CullingSystem::GetInstance()->Register(t);
+    }
+
+    auto instance = Altseed2::Graphics::GetInstance();
+
+    for (int count = 0; count++ < TestCount && instance->DoEvents();) {
+        Altseed2::CullingSystem::GetInstance()->UpdateAABB();
+        Altseed2::CullingSystem::GetInstance()->Cull(Altseed2::RectF(Altseed2::Vector2F(), Altseed2::Window::GetInstance()->GetSize().To2F()));
+
+        Altseed2::RenderPassParameter renderPassParameter;
+        renderPassParameter.ClearColor = Altseed2::Color(50, 50, 50, 255);
+        renderPassParameter.IsColorCleared = true;
+        renderPassParameter.IsDepthCleared = true;
+        EXPECT_TRUE(instance->BeginFrame(renderPassParameter));
+
+        for (const auto& t : texts) {
+            Altseed2::Renderer::GetInstance()->DrawText(t);
+        }
+
+        Altseed2::Renderer::GetInstance()->Render();
+
+        EXPECT_TRUE(instance->EndFrame());
+
+        if (count == 5) {
+            Altseed2::Graphics::GetInstance()->SaveScreenshot(u"Font.DistanceFieldType.png");
+        }
+    }
+
+    for (const auto& t : texts) {
+        Altseed2::CullingSystem::GetInstance()->Unregister(t);
+    }
+
+    Altseed2::Core::Terminate();
+}
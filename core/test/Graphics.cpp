@@ -20,8 +20,10 @@
 #include "Graphics/Renderer/RenderedSprite.h"
 #include "Graphics/Renderer/RenderedText.h"
 #include "Graphics/Renderer/Renderer.h"
+#include "Graphics/Renderer/TextBatch.h"
 #include "Graphics/Shader.h"
 #include "Graphics/ShaderCompiler/ShaderCompiler.h"
+#include "Graphics/Texture2D.h"
 #include "Logger/Log.h"
 #include "Math/Matrix44F.h"
 #include "TestHelper.h"
@@ -125,6 +127,59 @@ TEST(Graphics, SpriteTexture) {
     Altseed2::Core::Terminate();
 }
 
+TEST(Graphics, SpriteSetBatch) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::Graphics);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"SpriteSetBatch", 1280, 720, config));
+
+    const int32_t spriteCount = 3;
+
+    std::vector<std::shared_ptr<Altseed2::RenderedSprite>> sprites;
+    std::vector<Altseed2::RenderedSprite*> handles;
+    for (int32_t i = 0; i < spriteCount; i++) {
+        auto s = Altseed2::RenderedSprite::Create();
+        Altseed2::CullingSystem::GetInstance()->Register(s);
+        sprites.push_back(s);
+        handles.push_back(s.get());
+    }
+
+    // the last sprite is moved out of the screen
+    std::vector<Altseed2::Matrix44F> transforms(spriteCount);
+    transforms[0].SetTranslation(100, 100, 0);
+    transforms[1].SetTranslation(300, 100, 0);
+    transforms[2].SetTranslation(-1000, -1000, 0);
+
+    std::vector<Altseed2::RectF> srcs(spriteCount, Altseed2::RectF(0, 0, 64, 64));
+    std::vector<Altseed2::Color> colors = {
+            Altseed2::Color(255, 0, 0, 255), Altseed2::Color(0, 255, 0, 255), Altseed2::Color(0, 0, 255, 255)};
+
+    Altseed2::RenderedSprite::SetBatch(handles.data(), transforms.data(), srcs.data(), colors.data(), spriteCount);
+
+    for (int32_t i = 0; i < spriteCount; i++) {
+        EXPECT_EQ(sprites[i]->GetTransform().Values[0][3], transforms[i].Values[0][3]);
+        EXPECT_EQ(sprites[i]->GetSrc().Width, 64);
+        EXPECT_EQ(sprites[i]->GetColor().R, colors[i].R);
+        EXPECT_EQ(sprites[i]->GetColor().B, colors[i].B);
+    }
+
+    // the AABBs are updated as the setters do
+    Altseed2::CullingSystem::GetInstance()->UpdateAABB();
+    Altseed2::CullingSystem::GetInstance()->Cull(Altseed2::RectF(Altseed2::Vector2F(), Altseed2::Window::GetInstance()->GetSize().To2F()));
+    EXPECT_EQ(Altseed2::CullingSystem::GetInstance()->GetDrawingRenderedCount(), 2);
+
+    // null arrays keep the current values
+    Altseed2::RenderedSprite::SetBatch(handles.data(), nullptr, nullptr, colors.data() + 1, 1);
+    EXPECT_EQ(sprites[0]->GetColor().G, 255);
+    EXPECT_EQ(sprites[0]->GetSrc().Width, 64);
+    EXPECT_EQ(sprites[0]->GetTransform().Values[0][3], 100);
+
+    for (auto& s : sprites) {
+        Altseed2::CullingSystem::GetInstance()->Unregister(s);
+    }
+    Altseed2::Core::Terminate();
+}
+
 TEST(Graphics, RenderedText) {
     auto config = Altseed2TestConfig(Altseed2::CoreModules::Graphics);
     EXPECT_TRUE(config != nullptr);
@@ -315,6 +370,124 @@ TEST(Graphics, RenderedText_RenderingSize) {
     Altseed2::Core::Terminate();
 }
 
+TEST(Graphics, TextBatch) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::Graphics);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"TextBatch", 1280, 720, config));
+
+    auto font = Altseed2::Font::LoadDynamicFont(u"TestData/Font/mplus-1m-regular.ttf", 64);
+
+    auto batch = Altseed2::TextBatch::Create();
+    batch->SetFont(font);
+    batch->SetFontSize(24);
+
+    auto instance = Altseed2::Graphics::GetInstance();
+
+    for (int count = 0; count++ < 100 && instance->DoEvents() && Altseed2::Core::GetInstance()->DoEvent();) {
+        Altseed2::RenderPassParameter renderPassParameter;
+        renderPassParameter.ClearColor = Altseed2::Color(50, 50, 50, 255);
+        renderPassParameter.IsColorCleared = true;
+        renderPassParameter.IsDepthCleared = true;
+        EXPECT_TRUE(instance->BeginFrame(renderPassParameter));
+
+        batch->Clear();
+        for (int32_t i = 0; i < 1000; i++) {
+            const auto text = Altseed2::utf8_to_utf16(std::to_string((i * 37 + count) % 1000));
+            const auto position = Altseed2::Vector2F((i % 25) * 50.0f, (i / 25) * 18.0f);
+            batch->Add(text.c_str(), position, Altseed2::Color(255, (i * 5) % 255, 100, 255));
+        }
+        EXPECT_EQ(batch->GetCount(), 1000);
+
+        Altseed2::Renderer::GetInstance()->DrawTextBatch(batch);
+
+        // all digits are on the first texture of the font
+        EXPECT_EQ(Altseed2::Renderer::GetInstance()->GetBatchCount(), 1);
+
+        Altseed2::Renderer::GetInstance()->Render();
+
+        EXPECT_TRUE(instance->EndFrame());
+
+        // Take a screenshot
+        if (count == 5) {
+            Altseed2::Graphics::GetInstance()->SaveScreenshot(u"Graphics.TextBatch.png");
+        }
+    }
+
+    // glyphs are placed as RenderedText places them
+    {
+        const auto position = Altseed2::Vector2F(100.0f, 200.0f);
+
+        auto text = Altseed2::RenderedText::Create();
+        text->SetFont(font);
+        text->SetFontSize(24);
+        text->SetText(u"AVA 123");
+
+        std::vector<Altseed2::Vector2F> expected;
+        text->IterateTexts([&](Altseed2::Vector2F pos, Altseed2::RectF src, float texScale, std::shared_ptr<Altseed2::TextureBase>& texture, bool isGlyph) {
+            expected.push_back(pos + position);
+        });
+
+        batch->Clear();
+        batch->Add(u"AVA 123", position, Altseed2::Color(255, 255, 255, 255));
+
+        std::vector<Altseed2::Vector2F> actual;
+        batch->IterateTexts([&](const Altseed2::Color& color, Altseed2::Vector2F pos, Altseed2::RectF src, float texScale, std::shared_ptr<Altseed2::TextureBase>& texture, bool isGlyph) {
+            actual.push_back(pos);
+        });
+
+        EXPECT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < std::min(actual.size(), expected.size()); i++) {
+            EXPECT_NEAR(actual[i].X, expected[i].X, 0.01f);
+            EXPECT_NEAR(actual[i].Y, expected[i].Y, 0.01f);
+        }
+    }
+
+    // texts are drawn in the order they are added, as drawing them one by one
+    {
+        auto imageFont = Altseed2::Font::CreateImageFont(font);
+        imageFont->AddImageGlyph(u'〇', Altseed2::Texture2D::Load(u"TestData/IO/AltseedPink.png"));
+
+        const std::u16string strings[] = {u"1〇1", u"〇2"};
+
+        batch->Clear();
+        batch->SetFont(imageFont);
+        for (int32_t i = 0; i < 2; i++) {
+            batch->Add(strings[i].c_str(), Altseed2::Vector2F(100.0f, 100.0f), Altseed2::Color(255, 255, 255, 255));
+        }
+
+        std::vector<std::shared_ptr<Altseed2::RenderedText>> texts;
+        for (int32_t i = 0; i < 2; i++) {
+            auto text = Altseed2::RenderedText::Create();
+            text->SetFont(imageFont);
+            text->SetFontSize(24);
+            text->SetText(strings[i].c_str());
+            texts.push_back(text);
+        }
+
+        Altseed2::RenderPassParameter renderPassParameter;
+        renderPassParameter.ClearColor = Altseed2::Color(50, 50, 50, 255);
+        renderPassParameter.IsColorCleared = true;
+        renderPassParameter.IsDepthCleared = true;
+        EXPECT_TRUE(instance->BeginFrame(renderPassParameter));
+
+        // glyph, image, glyph, image, glyph
+        Altseed2::Renderer::GetInstance()->DrawTextBatch(batch);
+        EXPECT_EQ(Altseed2::Renderer::GetInstance()->GetBatchCount(), 5);
+        Altseed2::Renderer::GetInstance()->Render();
+
+        for (const auto& text : texts) {
+            Altseed2::Renderer::GetInstance()->DrawText(text);
+        }
+        EXPECT_EQ(Altseed2::Renderer::GetInstance()->GetBatchCount(), 5);
+        Altseed2::Renderer::GetInstance()->Render();
+
+        EXPECT_TRUE(instance->EndFrame());
+    }
+
+    Altseed2::Core::Terminate();
+}
+
 TEST(Graphics, RenderedPolygon) {
     auto config = Altseed2TestConfig(Altseed2::CoreModules::Graphics);
     EXPECT_TRUE(config != nullptr);
@@ -446,6 +619,89 @@ TEST(Graphics, RenderedIBPolygon) {
     Altseed2::Core::Terminate();
 }
 
+TEST(Graphics, BorrowedArray) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::Graphics);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"BorrowedArray", 1280, 720, config));
+
+    int count = 0;
+
+    auto instance = Altseed2::Graphics::GetInstance();
+
+    // memory of the caller, which must be kept until the arrays are released
+    std::vector<Altseed2::BatchVertex> rawVertexes(4);
+    rawVertexes[0].Pos = Altseed2::Vector3F(0, 0, 0.5f);
+    rawVertexes[1].Pos = Altseed2::Vector3F(100, 0, 0.5f);
+    rawVertexes[2].Pos = Altseed2::Vector3F(100, 100, 0.5f);
+    rawVertexes[3].Pos = Altseed2::Vector3F(0, 100, 0.5f);
+    for (auto& v : rawVertexes) v.Col = Altseed2::Color(0, 255, 0, 255);
+
+    std::vector<int32_t> rawBuffers = {0, 1, 2, 0, 2, 3};
+
+    auto vertexes = Altseed2::VertexArray::Create(0);
+    vertexes->Borrow(rawVertexes.data(), static_cast<int32_t>(rawVertexes.size()));
+    EXPECT_TRUE(vertexes->GetIsBorrowed());
+    EXPECT_EQ(vertexes->GetCount(), 4);
+    EXPECT_EQ(vertexes->GetPointer(), rawVertexes.data());
+
+    auto buffers = Altseed2::Int32Array::Create(0);
+    buffers->Borrow(rawBuffers.data(), static_cast<int32_t>(rawBuffers.size()));
+
+    // writes through the array reach the memory of the caller
+    buffers->SetAt(5, 3);
+    EXPECT_EQ(rawBuffers[5], 3);
+
+    auto polygon = Altseed2::RenderedPolygon::Create();
+    polygon->SetVertexes(vertexes);
+    polygon->SetBuffers(buffers);
+
+    auto transform = Altseed2::Matrix44F();
+    transform.SetTranslation(250, 250, 0);
+    polygon->SetTransform(transform);
+
+    // pixels are uploaded from the borrowed memory
+    std::vector<int8_t> rawPixels(64 * 64 * 4);
+    for (size_t i = 0; i < rawPixels.size(); i++) rawPixels[i] = static_cast<int8_t>(i % 4 == 3 ? 255 : i % 256);
+
+    auto pixels = Altseed2::Int8Array::Create(0);
+    pixels->Borrow(rawPixels.data(), static_cast<int32_t>(rawPixels.size()));
+
+    auto texture = Altseed2::Texture2D::Create(Altseed2::Vector2I(64, 64));
+    EXPECT_TRUE(texture != nullptr);
+    EXPECT_TRUE(texture->Write(pixels));
+    EXPECT_FALSE(texture->Write(Altseed2::Int8Array::Create(16)));
+    polygon->SetTexture(texture);
+
+    while (count++ < 10 && instance->DoEvents() && Altseed2::Core::GetInstance()->DoEvent()) {
+        Altseed2::RenderPassParameter renderPassParameter;
+        renderPassParameter.ClearColor = Altseed2::Color(50, 50, 50, 255);
+        renderPassParameter.IsColorCleared = true;
+        renderPassParameter.IsDepthCleared = true;
+        EXPECT_TRUE(instance->BeginFrame(renderPassParameter));
+
+        Altseed2::Renderer::GetInstance()->DrawPolygon(polygon);
+
+        Altseed2::Renderer::GetInstance()->Render();
+
+        EXPECT_TRUE(instance->EndFrame());
+    }
+
+    // drawing does not copy the borrowed arrays, nor transform the memory of the caller
+    EXPECT_TRUE(vertexes->GetIsBorrowed());
+    EXPECT_TRUE(buffers->GetIsBorrowed());
+    EXPECT_EQ(rawVertexes[1].Pos.X, 100);
+
+    // after Unborrow the arrays own copies of the data
+    vertexes->Unborrow();
+    EXPECT_FALSE(vertexes->GetIsBorrowed());
+    EXPECT_EQ(vertexes->GetCount(), 4);
+    EXPECT_NE(vertexes->GetPointer(), rawVertexes.data());
+    EXPECT_EQ(vertexes->GetAt(2).Pos.Y, 100);
+
+    Altseed2::Core::Terminate();
+}
+
 TEST(Graphics, AlphaBlend) {
     auto config = Altseed2TestConfig(Altseed2::CoreModules::Graphics);
     EXPECT_TRUE(config != nullptr);
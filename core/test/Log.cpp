@@ -4,9 +4,24 @@
 #include <Logger/Log.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
 static const std::u16string log_filename = u"Log_test.txt";
 static const auto bools = {true, false};
 
+static int32_t CountLines(const char* filename, const char* text) {
+    std::ifstream ifs(filename);
+    std::string line;
+    int32_t count = 0;
+    while (std::getline(ifs, line)) {
+        if (line.find(text) != std::string::npos) count++;
+    }
+    return count;
+}
+
 TEST(Log, Initialize) {
     for (const auto c : bools) {
         for (const auto f : bools) {
@@ -73,4 +88,59 @@ TEST(Log, Write) {
     }
 
     Altseed2::Log::Terminate();
-}
\ No newline at end of file
+}
+
+TEST(Log, Async) {
+    std::remove("Log_async.txt");
+
+    EXPECT_TRUE(Altseed2::Log::Initialize(false, true, u"Log_async.txt", true));
+    Altseed2::Log::GetInstance()->SetRateLimit(0, 0.0f);
+    for (int32_t i = 0; i < 100; i++) {
+        Altseed2::Log::GetInstance()->Info(Altseed2::LogCategory::Core, u"async {0}", i);
+    }
+
+    // the queue is flushed
+    Altseed2::Log::Terminate();
+
+    EXPECT_EQ(CountLines("Log_async.txt", "async"), 100);
+}
+
+TEST(Log, RateLimit) {
+    using namespace Altseed2;
+
+    std::remove("Log_rateLimit.txt");
+
+    EXPECT_TRUE(Log::Initialize(false, true, u"Log_rateLimit.txt"));
+
+    // not limited by default
+    for (int32_t i = 0; i < 20; i++) {
+        Log::GetInstance()->Warn(LogCategory::Core, u"repeated {0}", i);
+    }
+
+    Log::GetInstance()->SetRateLimit(3, 0.1f);
+
+    int32_t evaluated = 0;
+    for (int32_t i = 0; i < 10; i++) {
+        LOG_WARN(LogCategory::Core, u"limited {0}", ++evaluated);
+        Log::GetInstance()->Warn(LogCategory::Core, u"other {0}", i);
+    }
+
+    // arguments of the suppressed messages are not evaluated
+    EXPECT_EQ(evaluated, 3);
+
+    // the number of suppressed messages is written in the next interval
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    LOG_WARN(LogCategory::Core, u"limited {0}", ++evaluated);
+
+    // filtered by the level
+    Log::GetInstance()->SetLevel(LogCategory::Core, LogLevel::Error);
+    LOG_INFO(LogCategory::Core, u"limited {0}", ++evaluated);
+    EXPECT_EQ(evaluated, 4);
+
+    Log::Terminate();
+
+    EXPECT_EQ(CountLines("Log_rateLimit.txt", "repeated"), 20);
+    EXPECT_EQ(CountLines("Log_rateLimit.txt", "limited"), 4);
+    EXPECT_EQ(CountLines("Log_rateLimit.txt", "other"), 3);
+    EXPECT_EQ(CountLines("Log_rateLimit.txt", "7 messages like the next one were suppressed"), 1);
+}
@@ -34,6 +34,26 @@ TEST(Sound, SoundPlay) {
     asd::Core::Terminate();
 }
 
+TEST(Sound, SoundLoadAsync) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::Sound);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(asd::Core::Initialize(u"Sound LoadAsync", 640, 480, config));
+
+    auto bgm = asd::Sound::LoadAsync(u"TestData/Sound/bgm1.ogg", false);
+    auto se = asd::Sound::LoadAsync(u"TestData/Sound/se1.wav", true);
+    auto notExist = asd::Sound::LoadAsync(u"TestData/Sound/not_exist.wav", true);
+
+    // sounds do not need the main thread
+    EXPECT_TRUE(bgm.get() != nullptr);
+    EXPECT_TRUE(se.get() != nullptr);
+    EXPECT_TRUE(notExist.get() == nullptr);
+
+    EXPECT_EQ(se.get(), asd::Sound::Load(u"TestData/Sound/se1.wav", true));
+
+    asd::Core::Terminate();
+}
+
 TEST(Sound, SoundLoop) {
     auto config = Altseed2TestConfig(Altseed2::CoreModules::Sound);
     EXPECT_TRUE(config != nullptr);
@@ -0,0 +1,53 @@
+﻿#include <Common/StringHelper.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+TEST(StringHelper, Conversion) {
+    // long enough to go through the blocks of ASCII and the remainder
+    const std::u16string u16 = u"ASCII only prefix, 日本語, emoji \U0001F600 and ASCII suffix after them.";
+    const std::string u8 = u8"ASCII only prefix, 日本語, emoji \U0001F600 and ASCII suffix after them.";
+
+    EXPECT_EQ(Altseed2::utf16_to_utf8(u16), u8);
+    EXPECT_EQ(Altseed2::utf16_to_utf8(u16.c_str()), u8);
+    EXPECT_EQ(Altseed2::utf8_to_utf16(u8), u16);
+    EXPECT_EQ(Altseed2::utf8_to_utf16(u8.c_str()), u16);
+
+    // the buffer is reused
+    std::string buffer;
+    buffer.reserve(256);
+    const auto data = buffer.data();
+    Altseed2::utf16_to_utf8(u16.data(), u16.size(), buffer);
+    EXPECT_EQ(buffer, u8);
+    EXPECT_EQ(buffer.data(), data);
+
+    // an unpaired surrogate is replaced with U+FFFD
+    EXPECT_EQ(Altseed2::utf16_to_utf8(std::u16string(1, static_cast<char16_t>(0xD800))), u8"\uFFFD");
+
+    // invalid UTF-8 results in an empty string
+    EXPECT_TRUE(Altseed2::utf8_to_utf16(std::string("abc\xC0\x80")).empty());
+    EXPECT_TRUE(Altseed2::utf8_to_utf16(std::string("abc\xE3\x81")).empty());
+    std::u16string u16Buffer;
+    EXPECT_FALSE(Altseed2::utf8_to_utf16("\xFF", 1, u16Buffer));
+    EXPECT_TRUE(u16Buffer.empty());
+
+    EXPECT_EQ(Altseed2::utf16_to_utf8(u""), "");
+    EXPECT_EQ(Altseed2::utf8_to_utf16(""), u"");
+}
+
+TEST(StringHelper, TruncatedLength) {
+    // 'a', 'あ' (3 bytes) and U+1F600 (4 bytes)
+    const std::string u8 = u8"a\u3042\U0001F600";
+
+    EXPECT_EQ(Altseed2::GetU8TruncatedLength(u8, 100), u8.size());
+    EXPECT_EQ(Altseed2::GetU8TruncatedLength(u8, 0), 0u);
+    EXPECT_EQ(Altseed2::GetU8TruncatedLength(u8, 1), 1u);
+    EXPECT_EQ(Altseed2::GetU8TruncatedLength(u8, 2), 1u);
+    EXPECT_EQ(Altseed2::GetU8TruncatedLength(u8, 3), 1u);
+    EXPECT_EQ(Altseed2::GetU8TruncatedLength(u8, 4), 4u);
+    EXPECT_EQ(Altseed2::GetU8TruncatedLength(u8, 7), 4u);
+    EXPECT_EQ(Altseed2::GetU8TruncatedLength(u8, 8), 8u);
+
+    // the truncated text is still valid
+    EXPECT_EQ(Altseed2::utf8_to_utf16(u8.substr(0, Altseed2::GetU8TruncatedLength(u8, 6))), u"a\u3042");
+}
@@ -107,6 +107,72 @@ TEST(Texture2D, Async) {
     Altseed2::Core::Terminate();
 }
 
+TEST(Texture2D, LoadAsync) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::Graphics);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    auto png = Altseed2::Texture2D::LoadAsync(u"TestData/IO/AltseedPink.png");
+    auto jpg = Altseed2::Texture2D::LoadAsync(u"TestData/IO/AltseedPink.jpg");
+    auto pngTwice = Altseed2::Texture2D::LoadAsync(u"TestData/IO/AltseedPink.png");
+    auto notExist = Altseed2::Texture2D::LoadAsync(u"not_exsist.png");
+    auto file = Altseed2::StaticFile::CreateAsync(u"TestData/IO/test.txt");
+
+    // uploads are done in DoEvent
+    auto isReady = [](const auto& f) -> bool { return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready; };
+    int count = 0;
+    while (count++ < 1000 && !(isReady(png) && isReady(jpg) && isReady(pngTwice) && isReady(notExist) && isReady(file))) {
+        EXPECT_TRUE(Altseed2::Core::GetInstance()->DoEvent());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_NE(png.get(), nullptr);
+    EXPECT_NE(jpg.get(), nullptr);
+    EXPECT_EQ(png.get(), pngTwice.get());
+    EXPECT_EQ(notExist.get(), nullptr);
+    EXPECT_NE(file.get(), nullptr);
+
+    // the same resource as the synchronous API
+    EXPECT_EQ(png.get(), Altseed2::Texture2D::Load(u"TestData/IO/AltseedPink.png"));
+    EXPECT_EQ(file.get(), Altseed2::StaticFile::Create(u"TestData/IO/test.txt"));
+
+    Altseed2::Core::Terminate();
+}
+
+TEST(Texture2D, LoadBatch) {
+    auto config = Altseed2TestConfig(Altseed2::CoreModules::Graphics);
+    EXPECT_TRUE(config != nullptr);
+
+    EXPECT_TRUE(Altseed2::Core::Initialize(u"test", 640, 480, config));
+
+    auto cached = Altseed2::Texture2D::Load(u"TestData/IO/AltseedPink.gif");
+    EXPECT_NE(cached, nullptr);
+
+    std::vector<std::u16string> paths = {
+            u"TestData/IO/AltseedPink.png",
+            u"TestData/IO/AltseedPink.jpg",
+            u"TestData/IO/AltseedPink.gif",
+            u"not_exsist.png",
+            u"TestData/IO/AltseedPink.png",
+    };
+
+    // upload one by one
+    auto textures = Altseed2::Texture2D::LoadBatch(paths, 1);
+    EXPECT_EQ(textures.size(), paths.size());
+    EXPECT_NE(textures[0], nullptr);
+    EXPECT_NE(textures[1], nullptr);
+    EXPECT_EQ(textures[2], cached);
+    EXPECT_EQ(textures[3], nullptr);
+    EXPECT_EQ(textures[4], textures[0]);
+
+    auto single = Altseed2::Texture2D::Load(u"TestData/IO/AltseedPink.jpg");
+    EXPECT_EQ(textures[1], single);
+    EXPECT_EQ(textures[1]->GetSize().X, single->GetSize().X);
+
+    Altseed2::Core::Terminate();
+}
+
 TEST(Texture2D, Save) {
     auto config = Altseed2TestConfig(Altseed2::CoreModules::Graphics);
     EXPECT_TRUE(config != nullptr);
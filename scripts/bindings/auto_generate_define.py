@@ -118,6 +118,8 @@ with BuiltinShaderType as enum_:
     enum_.add('SpriteUnlitVS', 0)
     enum_.add('SpriteUnlitPS', 1)
     enum_.add('FontUnlitPS', 2)
+    enum_.add('FontSDFUnlitPS', 3)
+    enum_.add('FontMTSDFUnlitPS', 4)
 define.enums.append(BuiltinShaderType)
 
 VertexLayoutFormat = cbg.Enum('Altseed2', 'VertexLayoutFormat')
@@ -142,6 +144,13 @@ with WritingDirection as enum_:
     enum_.add('Horizontal', 1)
 define.enums.append(WritingDirection)
 
+FontDistanceFieldType = cbg.Enum('Altseed2', 'FontDistanceFieldType')
+with FontDistanceFieldType as enum_:
+    enum_.add('MSDF', 0)
+    enum_.add('SDF', 1)
+    enum_.add('MTSDF', 2)
+define.enums.append(FontDistanceFieldType)
+
 ButtonState = cbg.Enum('Altseed2', 'ButtonState')
 with ButtonState as enum_:
     enum_.add('Free', 0b00)
@@ -900,6 +909,7 @@ RenderedCamera = cbg.Class('Altseed2', 'RenderedCamera')
 RenderedSprite = cbg.Class('Altseed2', 'RenderedSprite')
 RenderedText = cbg.Class('Altseed2', 'RenderedText')
 RenderedPolygon = cbg.Class('Altseed2', 'RenderedPolygon')
+TextBatch = cbg.Class('Altseed2', 'TextBatch')
 Renderer = cbg.Class('Altseed2', 'Renderer')
 ShaderCompiler = cbg.Class('Altseed2', 'ShaderCompiler')
 StreamFile = cbg.Class('Altseed2', 'StreamFile')
@@ -1105,6 +1115,38 @@ with Resources as class_:
     with class_.add_func('Reload') as func_:
         func_.is_public = False
 
+    with class_.add_func('GetMemoryUsageKiB') as func_:
+        func_.return_value.type_ = int
+        func_.is_public = False
+        with func_.add_arg(ResourceType, 'type') as arg:
+            pass
+
+    with class_.add_func('GetMemoryBudgetKiB') as func_:
+        func_.return_value.type_ = int
+        func_.is_public = False
+        with func_.add_arg(ResourceType, 'type') as arg:
+            pass
+
+    with class_.add_func('SetMemoryBudgetKiB') as func_:
+        func_.is_public = False
+        with func_.add_arg(ResourceType, 'type') as arg:
+            pass
+        with func_.add_arg(int, 'budget') as arg:
+            pass
+
+    with class_.add_func('SetIsPinned') as func_:
+        func_.return_value.type_ = bool
+        func_.is_public = False
+        with func_.add_arg(ResourceType, 'type') as arg:
+            pass
+        with func_.add_arg(ctypes.c_wchar_p, 'path') as arg:
+            arg.nullable = False
+        with func_.add_arg(bool, 'isPinned') as arg:
+            pass
+
+    with class_.add_func('Trim') as func_:
+        func_.is_public = False
+
 define.classes.append(Resources)
 
 with TextureBase as class_:
@@ -1293,6 +1335,11 @@ with Texture2D as class_:
         with func_.add_arg(Vector2I, 'size') as arg:
             pass
 
+    with class_.add_func('Write') as func_:
+        func_.return_value.type_ = bool
+        with func_.add_arg(Int8Array, 'data') as arg:
+            arg.nullable = False
+
     with class_.add_property(ctypes.c_wchar_p, 'Path') as prop_:
         prop_.has_getter = True
         prop_.has_setter = False
@@ -1567,6 +1614,10 @@ with Configuration as class_:
         prop_.has_getter = True
         prop_.has_setter = True
         prop_.serialized = True
+    with class_.add_property(bool, 'AsyncLoggingEnabled') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = True
+        prop_.serialized = True
     with class_.add_property(ctypes.c_wchar_p, 'LogFileName') as prop_:
         prop_.has_getter = True
         prop_.has_setter = True
@@ -1626,6 +1677,17 @@ with File as class_:
         with func_.add_arg(ctypes.c_wchar_p, 'password') as arg:
             arg.nullable = False
 
+    with class_.add_func('ClearPathCache') as func_:
+        pass
+
+    with class_.add_property(bool, 'IsPathCacheEnabled') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = True
+
+    with class_.add_property(bool, 'IsHotReloadEnabled') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = True
+
 # int *
     """
     with class_.add_func('MakePackage') as func_:
@@ -1814,11 +1876,26 @@ with Font as class_:
     with class_.add_func('LoadDynamicFont') as func_:
         func_.return_value.type_ = Font
         func_.is_static = True
+        func_.is_overload = True
+        func_.onlyExtern = True
+        with func_.add_arg(ctypes.c_wchar_p, 'path') as arg:
+            arg.nullable = False
+        with func_.add_arg(int, 'samplingSize') as arg:
+            pass
+
+    with class_.add_func('LoadDynamicFont') as func_:
+        func_.return_value.type_ = Font
+        func_.is_static = True
+        func_.is_overload = True
         func_.onlyExtern = True
         with func_.add_arg(ctypes.c_wchar_p, 'path') as arg:
             arg.nullable = False
         with func_.add_arg(int, 'samplingSize') as arg:
             pass
+        with func_.add_arg(FontDistanceFieldType, 'distanceFieldType') as arg:
+            pass
+        with func_.add_arg(float, 'pxRange') as arg:
+            pass
 
     with class_.add_func('LoadStaticFont') as func_:
         func_.return_value.type_ = Font
@@ -1883,6 +1960,12 @@ with Font as class_:
         prop_.has_getter = True
         prop_.has_setter = False
         prop_.serialized = True
+    with class_.add_property(FontDistanceFieldType, 'DistanceFieldType') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = False
+    with class_.add_property(float, 'PxRange') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = False
     with class_.add_property(ctypes.c_wchar_p, 'Path') as prop_:
         prop_.has_getter = True
         prop_.has_setter = False
@@ -1937,6 +2020,12 @@ with ImageFont as class_:
     with class_.add_property(bool, 'IsStaticFont') as prop_:
         prop_.has_getter = True
         prop_.has_setter = False
+    with class_.add_property(FontDistanceFieldType, 'DistanceFieldType') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = False
+    with class_.add_property(float, 'PxRange') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = False
 define.classes.append(ImageFont)
 
 with CullingSystem as class_:
@@ -2059,6 +2148,19 @@ with RenderedSprite as class_:
         prop_.has_setter = True
         prop_.is_public = False
         prop_.serialized = True
+    with class_.add_func('SetBatch') as func_:
+        func_.is_static = True
+        func_.is_public = False
+        with func_.add_arg(ctypes.c_void_p, 'sprites') as arg:
+            pass
+        with func_.add_arg(ctypes.c_void_p, 'transforms') as arg:
+            pass
+        with func_.add_arg(ctypes.c_void_p, 'srcs') as arg:
+            pass
+        with func_.add_arg(ctypes.c_void_p, 'colors') as arg:
+            pass
+        with func_.add_arg(int, 'count') as arg:
+            pass
 define.classes.append(RenderedSprite)
 
 with RenderedText as class_:
@@ -2106,6 +2208,11 @@ with RenderedText as class_:
         prop_.has_setter = True
         prop_.is_public = False
         prop_.serialized = True
+    with class_.add_property(bool, 'IsEnableShaping') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = True
+        prop_.is_public = False
+        prop_.serialized = True
     with class_.add_property(WritingDirection, 'WritingDirection') as prop_:
         prop_.has_getter = True
         prop_.has_setter = True
@@ -2188,6 +2295,56 @@ with RenderedPolygon as class_:
         prop_.serialized = True
 define.classes.append(RenderedPolygon)
 
+with TextBatch as class_:
+    class_.is_public = False
+    class_.is_Sealed = True
+    with class_.add_func('Create') as func_:
+        func_.return_value.type_ = TextBatch
+        func_.is_static = True
+        func_.is_public = False
+
+    with class_.add_func('Add') as func_:
+        func_.is_public = False
+        with func_.add_arg(ctypes.c_wchar_p, 'text') as arg:
+            pass
+        with func_.add_arg(Vector2F, 'position') as arg:
+            pass
+        with func_.add_arg(Color, 'color') as arg:
+            pass
+
+    with class_.add_func('Clear') as func_:
+        func_.is_public = False
+
+    with class_.add_property(AlphaBlend, 'AlphaBlend') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = True
+        prop_.is_public = False
+    with class_.add_property(Material, 'MaterialGlyph') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = True
+        prop_.is_public = False
+    with class_.add_property(Material, 'MaterialImage') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = True
+        prop_.is_public = False
+    with class_.add_property(Font, 'Font') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = True
+        prop_.is_public = False
+    with class_.add_property(float, 'FontSize') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = True
+        prop_.is_public = False
+    with class_.add_property(bool, 'IsEnableKerning') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = True
+        prop_.is_public = False
+    with class_.add_property(int, 'Count') as prop_:
+        prop_.has_getter = True
+        prop_.has_setter = False
+        prop_.is_public = False
+define.classes.append(TextBatch)
+
 with Renderer as class_:
     class_.is_public = False
     class_.is_Sealed = True
@@ -2224,6 +2381,11 @@ with Renderer as class_:
         with func_.add_arg(RenderedText, 'text') as arg:
             pass
 
+    with class_.add_func('DrawTextBatch') as func_:
+        func_.is_public = False
+        with func_.add_arg(TextBatch, 'batch') as arg:
+            pass
+
     with class_.add_func('Render') as func_:
         func_.is_public = False
 
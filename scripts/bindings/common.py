@@ -46,6 +46,28 @@ with Int8Array as class_:
             arg.brief.add('ja', 'コピーする要素の個数')
         func.is_public = True  # to implement IArray<T>
 
+    with class_.add_func("Borrow") as func:
+        func.brief = cbg.Description()
+        func.brief.add('ja', 'データをコピーせずに参照します。Unborrow, Assign, Clear を呼ぶかインスタンスが解放されるまで、データを固定し有効に保つ必要があります。')
+        with func.add_arg(ctypes.c_void_p, "ptr") as arg:
+            arg.brief = cbg.Description()
+            arg.brief.add('ja', '参照するデータの先頭のポインタ')
+        with func.add_arg(int, "size") as arg:
+            arg.brief = cbg.Description()
+            arg.brief.add('ja', '参照する要素の個数')
+        func.is_public = False
+
+    with class_.add_func("Unborrow") as func:
+        func.brief = cbg.Description()
+        func.brief.add('ja', '参照しているデータをコピーし、参照を終了します。')
+        func.is_public = False
+
+    with class_.add_property(bool, "IsBorrowed") as prop_:
+        prop_.brief = cbg.Description()
+        prop_.brief.add('ja', 'データをコピーせずに参照しているかどうかを取得します。')
+        prop_.has_getter = True
+        prop_.is_public = False
+
     with class_.add_func('CopyTo') as func:
         func.brief = cbg.Description()
         func.brief.add('ja', 'データを指定したポインタにコピーします。')
@@ -125,6 +147,28 @@ with Int32Array as class_:
             arg.brief.add('ja', 'コピーする要素の個数')
         func.is_public = True  # to implement IArray<T>
 
+    with class_.add_func("Borrow") as func:
+        func.brief = cbg.Description()
+        func.brief.add('ja', 'データをコピーせずに参照します。Unborrow, Assign, Clear を呼ぶかインスタンスが解放されるまで、データを固定し有効に保つ必要があります。')
+        with func.add_arg(ctypes.c_void_p, "ptr") as arg:
+            arg.brief = cbg.Description()
+            arg.brief.add('ja', '参照するデータの先頭のポインタ')
+        with func.add_arg(int, "size") as arg:
+            arg.brief = cbg.Description()
+            arg.brief.add('ja', '参照する要素の個数')
+        func.is_public = False
+
+    with class_.add_func("Unborrow") as func:
+        func.brief = cbg.Description()
+        func.brief.add('ja', '参照しているデータをコピーし、参照を終了します。')
+        func.is_public = False
+
+    with class_.add_property(bool, "IsBorrowed") as prop_:
+        prop_.brief = cbg.Description()
+        prop_.brief.add('ja', 'データをコピーせずに参照しているかどうかを取得します。')
+        prop_.has_getter = True
+        prop_.is_public = False
+
     with class_.add_func('CopyTo') as func:
         func.brief = cbg.Description()
         func.brief.add('ja', 'データを指定したポインタにコピーします。')
@@ -204,6 +248,28 @@ with VertexArray as class_:
             arg.brief.add('ja', 'コピーする要素の個数')
         func.is_public = True  # to implement IArray<T>
 
+    with class_.add_func("Borrow") as func:
+        func.brief = cbg.Description()
+        func.brief.add('ja', 'データをコピーせずに参照します。Unborrow, Assign, Clear を呼ぶかインスタンスが解放されるまで、データを固定し有効に保つ必要があります。')
+        with func.add_arg(ctypes.c_void_p, "ptr") as arg:
+            arg.brief = cbg.Description()
+            arg.brief.add('ja', '参照するデータの先頭のポインタ')
+        with func.add_arg(int, "size") as arg:
+            arg.brief = cbg.Description()
+            arg.brief.add('ja', '参照する要素の個数')
+        func.is_public = False
+
+    with class_.add_func("Unborrow") as func:
+        func.brief = cbg.Description()
+        func.brief.add('ja', '参照しているデータをコピーし、参照を終了します。')
+        func.is_public = False
+
+    with class_.add_property(bool, "IsBorrowed") as prop_:
+        prop_.brief = cbg.Description()
+        prop_.brief.add('ja', 'データをコピーせずに参照しているかどうかを取得します。')
+        prop_.has_getter = True
+        prop_.is_public = False
+
     with class_.add_func('CopyTo') as func:
         func.brief = cbg.Description()
         func.brief.add('ja', 'データを指定したポインタにコピーします。')
@@ -283,6 +349,28 @@ with FloatArray as class_:
             arg.brief.add('ja', 'コピーする要素の個数')
         func.is_public = True  # to implement IArray<T>
 
+    with class_.add_func("Borrow") as func:
+        func.brief = cbg.Description()
+        func.brief.add('ja', 'データをコピーせずに参照します。Unborrow, Assign, Clear を呼ぶかインスタンスが解放されるまで、データを固定し有効に保つ必要があります。')
+        with func.add_arg(ctypes.c_void_p, "ptr") as arg:
+            arg.brief = cbg.Description()
+            arg.brief.add('ja', '参照するデータの先頭のポインタ')
+        with func.add_arg(int, "size") as arg:
+            arg.brief = cbg.Description()
+            arg.brief.add('ja', '参照する要素の個数')
+        func.is_public = False
+
+    with class_.add_func("Unborrow") as func:
+        func.brief = cbg.Description()
+        func.brief.add('ja', '参照しているデータをコピーし、参照を終了します。')
+        func.is_public = False
+
+    with class_.add_property(bool, "IsBorrowed") as prop_:
+        prop_.brief = cbg.Description()
+        prop_.brief.add('ja', 'データをコピーせずに参照しているかどうかを取得します。')
+        prop_.has_getter = True
+        prop_.is_public = False
+
     with class_.add_func('CopyTo') as func:
         func.brief = cbg.Description()
         func.brief.add('ja', 'データを指定したポインタにコピーします。')
@@ -362,6 +450,28 @@ with Vector2FArray as class_:
             arg.brief.add('ja', 'コピーする要素の個数')
         func.is_public = True  # to implement IArray<T>
 
+    with class_.add_func("Borrow") as func:
+        func.brief = cbg.Description()
+        func.brief.add('ja', 'データをコピーせずに参照します。Unborrow, Assign, Clear を呼ぶかインスタンスが解放されるまで、データを固定し有効に保つ必要があります。')
+        with func.add_arg(ctypes.c_void_p, "ptr") as arg:
+            arg.brief = cbg.Description()
+            arg.brief.add('ja', '参照するデータの先頭のポインタ')
+        with func.add_arg(int, "size") as arg:
+            arg.brief = cbg.Description()
+            arg.brief.add('ja', '参照する要素の個数')
+        func.is_public = False
+
+    with class_.add_func("Unborrow") as func:
+        func.brief = cbg.Description()
+        func.brief.add('ja', '参照しているデータをコピーし、参照を終了します。')
+        func.is_public = False
+
+    with class_.add_property(bool, "IsBorrowed") as prop_:
+        prop_.brief = cbg.Description()
+        prop_.brief.add('ja', 'データをコピーせずに参照しているかどうかを取得します。')
+        prop_.has_getter = True
+        prop_.is_public = False
+
     with class_.add_func('CopyTo') as func:
         func.brief = cbg.Description()
         func.brief.add('ja', 'データを指定したポインタにコピーします。')
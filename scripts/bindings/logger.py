@@ -85,3 +85,9 @@ with Log as class_:
         func.brief.add('ja', 'ログレベルを設定します。')
         func.add_arg(LogCategory, 'category')
         func.add_arg(LogLevel, 'level')
+
+    with class_.add_func('SetRateLimit') as func:
+        func.brief = cbg.Description()
+        func.brief.add('ja', '同じ書式のログを一定時間内に出力する最大数を設定します。0以下の場合は制限しません。既定では制限しません。')
+        func.add_arg(int, 'count')
+        func.add_arg(float, 'interval')